@@ -0,0 +1,659 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+//Benchmark suite of reproducible physics scenes, every scene is generated from a fixed seed
+//and reports its timings, pair throughput and allocations per frame as JSON.
+//Usage: kalaphysics-benchmark [--quick] [--threads N] [--scene NAME] [--out PATH]
+//--quick shrinks every scene for smoke tests, --out - writes the JSON to stdout
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+
+#include "core/kp_core.hpp"
+#include "core/kp_job_system.hpp"
+#include "core/kp_physics_world.hpp"
+#include "physics/kp_rigidbody.hpp"
+#include "physics/kp_ray.hpp"
+#include "physics/kp_delayed_ray.hpp"
+#include "physics/kp_projectile_store.hpp"
+#include "physics/collision/kp_collider_aabb.hpp"
+#include "physics/collision/kp_collider_bsp.hpp"
+#include "physics/collision/kp_broadphase.hpp"
+
+using KalaPhysics::Core::KalaPhysicsCore;
+using KalaPhysics::Core::JobSystem;
+using KalaPhysics::Core::PhysicsWorld;
+using KalaPhysics::Physics::RigidBody;
+using KalaPhysics::Physics::Ray;
+using KalaPhysics::Physics::RayQuery;
+using KalaPhysics::Physics::RayHit;
+using KalaPhysics::Physics::DelayedRay;
+using KalaPhysics::Physics::ProjectileStore;
+using KalaPhysics::Physics::Collision::Collider;
+using KalaPhysics::Physics::Collision::Collider_AABB;
+using KalaPhysics::Physics::Collision::Collider_BSP;
+using KalaPhysics::Physics::Collision::Broadphase;
+
+using KalaHeaders::KalaMath::vec3;
+
+using std::vector;
+using std::string;
+using std::to_string;
+using std::pair;
+using std::atomic;
+using std::size_t;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::memory_order_relaxed;
+
+using u32 = uint32_t;
+using u64 = uint64_t;
+using f32 = float;
+using f64 = double;
+
+//
+// ALLOCATION COUNTING
+//
+
+//every heap allocation of the process, including the ones made by KalaPhysics
+static atomic<u64> allocationCount{};
+
+static void* CountedAlloc(size_t size)
+{
+	allocationCount.fetch_add(1, memory_order_relaxed);
+
+	void* ptr = malloc(size > 0 ? size : 1);
+	if (!ptr) throw std::bad_alloc();
+
+	return ptr;
+}
+static void* CountedAlignedAlloc(
+	size_t size,
+	std::align_val_t alignment)
+{
+	allocationCount.fetch_add(1, memory_order_relaxed);
+
+	size_t align = scast<size_t>(alignment);
+#ifdef _WIN32
+	void* ptr = _aligned_malloc(size > 0 ? size : 1, align);
+#else
+	void* ptr = aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+	if (!ptr) throw std::bad_alloc();
+
+	return ptr;
+}
+static void CountedAlignedFree(void* ptr)
+{
+#ifdef _WIN32
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+void* operator new(size_t size) { return CountedAlloc(size); }
+void* operator new[](size_t size) { return CountedAlloc(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return CountedAlignedAlloc(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return CountedAlignedAlloc(size, alignment); }
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { CountedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { CountedAlignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { CountedAlignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { CountedAlignedFree(ptr); }
+
+//
+// SCENE HELPERS
+//
+
+//splitmix64, unlike the standard distributions it yields the same numbers on every platform
+struct Random
+{
+	u64 state{};
+
+	u64 Next()
+	{
+		u64 z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+	f32 Range(
+		f32 min,
+		f32 max)
+	{
+		return min + (max - min) * scast<f32>(Next() >> 40) * (1.0f / 16777216.0f);
+	}
+	vec3 Range(
+		const vec3& min,
+		const vec3& max)
+	{
+		f32 x = Range(min.x, max.x);
+		f32 y = Range(min.y, max.y);
+		f32 z = Range(min.z, max.z);
+		return vec3(x, y, z);
+	}
+	vec3 Direction()
+	{
+		while (true)
+		{
+			vec3 d = Range(vec3(-1.0f), vec3(1.0f));
+			f32 len2 = d.x * d.x + d.y * d.y + d.z * d.z;
+			if (len2 > 1e-4f && len2 <= 1.0f) return d;
+		}
+	}
+};
+
+struct SceneResult
+{
+	string name{};
+	u64 seed{};
+	u32 bodies{};
+	u32 colliders{};
+	u32 frames{};
+	vector<pair<string, f64>> metrics{};
+};
+
+struct BenchmarkOptions
+{
+	bool isQuick{};
+	u32 threads{};
+	string scene{};
+	string outPath = "kalaphysics-benchmark.json";
+};
+
+static BenchmarkOptions options{};
+
+//the scene size, or a tenth of it for quick runs
+static u32 Scaled(u32 count)
+{
+	return options.isQuick
+		? (count / 10 > 0 ? count / 10 : 1)
+		: count;
+}
+
+static f64 SecondsSince(steady_clock::time_point start)
+{
+	return duration<f64>(steady_clock::now() - start).count();
+}
+
+//Drops every object of the last scene and restarts the job system
+static void ResetWorld()
+{
+	KalaPhysicsCore::CleanAllResources();
+	Broadphase::Clear();
+
+	//a zero delta only applies the removals to the world collider sets
+	PhysicsWorld::Update(0.0f);
+
+	JobSystem::Initialize(options.threads);
+}
+
+//Runs steps fixed steps and adds the timing, pair throughput and allocation metrics
+static void MeasureSteps(
+	u32 steps,
+	SceneResult& result)
+{
+	f32 dt = PhysicsWorld::GetFixedTimestep();
+
+	u64 pairs{};
+	u32 ran{};
+
+	u64 allocationsBefore = allocationCount.load(memory_order_relaxed);
+	steady_clock::time_point start = steady_clock::now();
+
+	for (u32 i = 0; i < steps; i++)
+	{
+		//a whole fixed timestep drains the accumulator in exactly one step
+		PhysicsWorld::Update(dt);
+
+		ran += PhysicsWorld::GetStepStats().steps;
+		pairs += Broadphase::GetStats().acceptedPairs;
+	}
+
+	f64 seconds = SecondsSince(start);
+	u64 allocations = allocationCount.load(memory_order_relaxed) - allocationsBefore;
+
+	result.frames = steps;
+	result.metrics.push_back({ "steps", ran });
+	result.metrics.push_back({ "nsPerStep", ran > 0 ? seconds * 1e9 / ran : 0.0 });
+	result.metrics.push_back({ "pairsPerStep", ran > 0 ? scast<f64>(pairs) / ran : 0.0 });
+	result.metrics.push_back({ "pairsPerSecond", seconds > 0.0 ? pairs / seconds : 0.0 });
+	result.metrics.push_back({ "allocationsPerFrame", scast<f64>(allocations) / steps });
+}
+
+static Collider_AABB* CreateGround(f32 halfSize)
+{
+	Collider_AABB* ground = Collider_AABB::Initialize(
+		0,
+		vec3(-halfSize, -1.0f, -halfSize),
+		vec3(halfSize, 0.0f, halfSize));
+	ground->SetLayer("Default");
+
+	return ground;
+}
+
+//Creates one unit mass body per position, ready to get a collider attached
+static void CreateBodies(
+	const vector<vec3>& positions,
+	vector<RigidBody*>& outBodies)
+{
+	RigidBody::GetRegistry().Reserve(scast<u32>(positions.size()));
+
+	for (const vec3& p : positions)
+	{
+		RigidBody* rb = RigidBody::Initialize();
+		rb->SetMass(1.0f);
+		rb->SetPosition(p);
+
+		outBodies.push_back(rb);
+	}
+}
+
+//
+// SCENES
+//
+
+//Square pyramid of resting unit boxes, 31 layers are 10416 boxes
+static SceneResult BoxPyramid()
+{
+	SceneResult result{ "box_pyramid", 1 };
+
+	u32 layers = options.isQuick ? 14 : 31;
+
+	CreateGround(100.0f);
+
+	vector<vec3> positions{};
+	for (u32 layer = 0; layer < layers; layer++)
+	{
+		u32 side = layers - layer;
+		f32 offset = -0.5f * scast<f32>(side - 1);
+
+		for (u32 x = 0; x < side; x++)
+		{
+			for (u32 z = 0; z < side; z++)
+			{
+				positions.push_back(vec3(offset + x, 0.5f + layer, offset + z));
+			}
+		}
+	}
+
+	vector<RigidBody*> bodies{};
+	CreateBodies(positions, bodies);
+
+	vector<Collider_AABB::Desc> descs{};
+	for (size_t i = 0; i < positions.size(); i++)
+	{
+		descs.push_back({ bodies[i]->GetID(), positions[i] - vec3(0.5f), positions[i] + vec3(0.5f) });
+	}
+
+	vector<Collider_AABB*> colliders{};
+	Collider_AABB::CreateMany(descs, colliders);
+	for (Collider_AABB* c : colliders) c->SetLayer("Default");
+
+	result.bodies = scast<u32>(bodies.size());
+	result.colliders = scast<u32>(colliders.size()) + 1;
+
+	MeasureSteps(options.isQuick ? 5 : 10, result);
+
+	return result;
+}
+
+//Loose grid of spheres with random jitter dropped onto the ground, the bottom layer lands right away
+static SceneResult FallingSpheres()
+{
+	SceneResult result{ "falling_spheres", 2 };
+	Random random{ result.seed };
+
+	u32 count = Scaled(50000);
+	u32 side = 50;
+
+	CreateGround(100.0f);
+
+	vector<vec3> positions{};
+	for (u32 i = 0; i < count; i++)
+	{
+		u32 x = i % side;
+		u32 z = (i / side) % side;
+		u32 y = i / (side * side);
+
+		vec3 jitter = random.Range(vec3(-0.1f), vec3(0.1f));
+		positions.push_back(vec3(x * 1.5f - 37.5f, 0.6f + y * 1.5f, z * 1.5f - 37.5f) + jitter);
+	}
+
+	vector<RigidBody*> bodies{};
+	CreateBodies(positions, bodies);
+
+	vector<Collider_BSP::Desc> descs{};
+	for (size_t i = 0; i < positions.size(); i++)
+	{
+		descs.push_back({ bodies[i]->GetID(), positions[i], 0.5f });
+	}
+
+	vector<Collider_BSP*> colliders{};
+	Collider_BSP::CreateMany(descs, colliders);
+	for (Collider_BSP* c : colliders) c->SetLayer("Default");
+
+	result.bodies = count;
+	result.colliders = count + 1;
+
+	MeasureSteps(options.isQuick ? 15 : 40, result);
+
+	return result;
+}
+
+//Random static boxes for the ray and projectile scenes
+static void CreateStaticField(
+	u32 count,
+	f32 extent,
+	Random& random)
+{
+	vector<Collider_AABB::Desc> descs{};
+	for (u32 i = 0; i < count; i++)
+	{
+		vec3 center = random.Range(vec3(-extent), vec3(extent));
+		vec3 half = random.Range(vec3(0.25f), vec3(2.0f));
+
+		descs.push_back({ 0, center - half, center + half });
+	}
+
+	vector<Collider_AABB*> colliders{};
+	Collider_AABB::CreateMany(descs, colliders);
+	for (Collider_AABB* c : colliders) c->SetLayer("Default");
+}
+
+//1M rays in batches against 100k static boxes
+static SceneResult RayStorm()
+{
+	SceneResult result{ "ray_storm", 3 };
+	Random random{ result.seed };
+
+	u32 colliderCount = Scaled(100000);
+	u32 rayCount = Scaled(1000000);
+	constexpr u32 batchSize = 65536;
+
+	CreateStaticField(colliderCount, 500.0f, random);
+
+	//one step builds the ray hierarchy
+	PhysicsWorld::Update(PhysicsWorld::GetFixedTimestep());
+
+	vector<RayQuery> queries(rayCount);
+	for (RayQuery& q : queries)
+	{
+		q.origin = random.Range(vec3(-500.0f), vec3(500.0f));
+		q.direction = random.Direction();
+		q.maxDistance = 1000.0f;
+	}
+	vector<RayHit> hits(rayCount);
+
+	Ray ray{};
+
+	u32 batches{};
+	u64 allocationsBefore = allocationCount.load(memory_order_relaxed);
+	steady_clock::time_point start = steady_clock::now();
+
+	for (u32 first = 0; first < rayCount; first += batchSize)
+	{
+		u32 count = rayCount - first < batchSize ? rayCount - first : batchSize;
+		ray.CastBatch(
+			{ queries.data() + first, count },
+			{ hits.data() + first, count });
+
+		++batches;
+	}
+
+	f64 seconds = SecondsSince(start);
+	u64 allocations = allocationCount.load(memory_order_relaxed) - allocationsBefore;
+
+	u32 hitCount{};
+	for (const RayHit& h : hits)
+	{
+		if (h.collider) ++hitCount;
+	}
+
+	result.colliders = colliderCount;
+	result.frames = batches;
+	result.metrics.push_back({ "rays", rayCount });
+	result.metrics.push_back({ "nsPerRay", seconds * 1e9 / rayCount });
+	result.metrics.push_back({ "raysPerSecond", rayCount / seconds });
+	result.metrics.push_back({ "hitRate", scast<f64>(hitCount) / rayCount });
+	result.metrics.push_back({ "allocationsPerFrame", scast<f64>(allocations) / batches });
+
+	return result;
+}
+
+//Delayed ray projectiles fired from a sphere around a field of static boxes
+static SceneResult ProjectileSwarm()
+{
+	SceneResult result{ "projectile_swarm", 4 };
+	Random random{ result.seed };
+
+	u32 colliderCount = Scaled(10000);
+	u32 projectileCount = Scaled(100000);
+
+	CreateStaticField(colliderCount, 200.0f, random);
+
+	DelayedRay* launcher = DelayedRay::Initialize();
+	launcher->SetSpeed(150.0f);
+	launcher->SetLifetime(10.0f);
+
+	for (u32 i = 0; i < projectileCount; i++)
+	{
+		vec3 dir = random.Direction();
+		vec3 origin = dir * 300.0f;
+
+		launcher->Fire(origin, vec3(0.0f) - dir + random.Range(vec3(-0.2f), vec3(0.2f)));
+	}
+
+	result.colliders = colliderCount;
+	result.metrics.push_back({ "projectiles", projectileCount });
+
+	MeasureSteps(options.isQuick ? 30 : 120, result);
+
+	result.metrics.push_back({ "projectilesLeft", ProjectileStore::GetProjectileCount() });
+
+	return result;
+}
+
+//Static debris created and destroyed through the collider registry every frame
+static SceneResult RegistryChurn()
+{
+	SceneResult result{ "registry_churn", 5 };
+	Random random{ result.seed };
+
+	u32 persistent = Scaled(10000);
+	u32 perFrame = Scaled(1000);
+	u32 frames = options.isQuick ? 30 : 120;
+
+	CreateStaticField(persistent, 200.0f, random);
+
+	vector<Collider_AABB::Desc> descs(perFrame);
+	vector<Collider_AABB*> created{};
+	vector<u32> alive{};
+	size_t oldest{};
+
+	u64 allocationsBefore = allocationCount.load(memory_order_relaxed);
+	steady_clock::time_point start = steady_clock::now();
+
+	for (u32 frame = 0; frame < frames; frame++)
+	{
+		//debris lives for four frames
+		if (frame >= 4)
+		{
+			for (u32 i = 0; i < perFrame; i++) Collider::GetRegistry().RemoveContent(alive[oldest++]);
+		}
+
+		for (auto& d : descs)
+		{
+			vec3 center = random.Range(vec3(-200.0f), vec3(200.0f));
+			d = { 0, center - vec3(0.5f), center + vec3(0.5f) };
+		}
+
+		created.clear();
+		Collider_AABB::CreateMany(descs, created);
+		for (Collider_AABB* c : created)
+		{
+			c->SetLayer("Default");
+			alive.push_back(c->GetID());
+		}
+
+		PhysicsWorld::Update(PhysicsWorld::GetFixedTimestep());
+	}
+
+	f64 seconds = SecondsSince(start);
+	u64 allocations = allocationCount.load(memory_order_relaxed) - allocationsBefore;
+
+	result.colliders = persistent;
+	result.frames = frames;
+	result.metrics.push_back({ "createdPerFrame", perFrame });
+	result.metrics.push_back({ "nsPerFrame", seconds * 1e9 / frames });
+	result.metrics.push_back({ "registryOpsPerSecond", 2.0 * perFrame * frames / seconds });
+	result.metrics.push_back({ "allocationsPerFrame", scast<f64>(allocations) / frames });
+
+	return result;
+}
+
+//
+// REPORT
+//
+
+static string ToJson(const vector<SceneResult>& results)
+{
+	auto _number = [](f64 v)
+		{
+			char buffer[64];
+			snprintf(buffer, sizeof(buffer), "%.9g", v);
+			return string(buffer);
+		};
+
+	string json = "{\n";
+	json += "\t\"benchmark\": \"kalaphysics\",\n";
+	json += "\t\"quick\": " + string(options.isQuick ? "true" : "false") + ",\n";
+	json += "\t\"threads\": " + to_string(JobSystem::GetThreadCount()) + ",\n";
+	json += "\t\"fixedTimestep\": " + _number(PhysicsWorld::GetFixedTimestep()) + ",\n";
+	json += "\t\"scenes\": [\n";
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const SceneResult& r = results[i];
+
+		json += "\t\t{\n";
+		json += "\t\t\t\"name\": \"" + r.name + "\",\n";
+		json += "\t\t\t\"seed\": " + to_string(r.seed) + ",\n";
+		json += "\t\t\t\"bodies\": " + to_string(r.bodies) + ",\n";
+		json += "\t\t\t\"colliders\": " + to_string(r.colliders) + ",\n";
+		json += "\t\t\t\"frames\": " + to_string(r.frames);
+
+		for (const auto& [key, value] : r.metrics)
+		{
+			json += ",\n\t\t\t\"" + key + "\": " + _number(value);
+		}
+
+		json += "\n\t\t}";
+		json += i + 1 < results.size() ? ",\n" : "\n";
+	}
+
+	json += "\t]\n}\n";
+
+	return json;
+}
+
+static bool ParseOptions(
+	int argc,
+	char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--quick") options.isQuick = true;
+		else if (arg == "--threads" && hasValue) options.threads = scast<u32>(strtoul(argv[++i], nullptr, 10));
+		else if (arg == "--scene" && hasValue) options.scene = argv[++i];
+		else if (arg == "--out" && hasValue) options.outPath = argv[++i];
+		else
+		{
+			fprintf(stderr, "Unknown benchmark argument '%s'!\n", arg.c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if (!ParseOptions(argc, argv)) return 1;
+
+	PhysicsWorld::AddLayer("Default");
+	PhysicsWorld::SetCollisionRule(0, 0, true);
+
+	struct Scene
+	{
+		const char* name;
+		SceneResult (*run)();
+	};
+	const Scene scenes[] =
+	{
+		{ "box_pyramid", BoxPyramid },
+		{ "falling_spheres", FallingSpheres },
+		{ "ray_storm", RayStorm },
+		{ "projectile_swarm", ProjectileSwarm },
+		{ "registry_churn", RegistryChurn }
+	};
+
+	vector<SceneResult> results{};
+	for (const Scene& scene : scenes)
+	{
+		if (!options.scene.empty()
+			&& options.scene != scene.name)
+		{
+			continue;
+		}
+
+		ResetWorld();
+
+		fprintf(stderr, "Running benchmark scene '%s'...\n", scene.name);
+		results.push_back(scene.run());
+	}
+
+	if (results.empty())
+	{
+		fprintf(stderr, "No benchmark scene is called '%s'!\n", options.scene.c_str());
+		return 1;
+	}
+
+	string json = ToJson(results);
+
+	KalaPhysicsCore::CleanAllResources();
+
+	if (options.outPath == "-")
+	{
+		fputs(json.c_str(), stdout);
+		return 0;
+	}
+
+	FILE* file = fopen(options.outPath.c_str(), "w");
+	if (!file)
+	{
+		fprintf(stderr, "Cannot write benchmark results to '%s'!\n", options.outPath.c_str());
+		return 1;
+	}
+
+	fputs(json.c_str(), file);
+	fclose(file);
+
+	fprintf(stderr, "Wrote benchmark results to '%s'.\n", options.outPath.c_str());
+
+	return 0;
+}
\ No newline at end of file
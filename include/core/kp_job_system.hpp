@@ -0,0 +1,55 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <functional>
+
+#include "core_utils.hpp"
+
+namespace KalaPhysics::Core
+{
+	using std::function;
+
+	using u32 = uint32_t;
+
+	//Hard cap for worker threads, the calling thread always helps on top of these
+	constexpr u32 MAX_WORKER_THREADS = 63;
+
+	//Jobs each thread queue holds, chunks dealt to a full queue run right away on the calling thread.
+	//Must be a power of two
+	constexpr u32 JOB_QUEUE_CAPACITY = 1024;
+
+	//Work-stealing thread pool used by the physics pipeline.
+	//Every worker owns a fixed ring of jobs it pops from the back of,
+	//idle workers steal from the front of the other rings. Nothing is allocated after Initialize
+	class LIB_API JobSystem
+	{
+	public:
+		//Start the worker threads, pass 0 to use one worker per hardware thread minus the caller.
+		//Without an initialized job system every parallel loop runs on the calling thread
+		static void Initialize(u32 workerCount = 0);
+		//Stop and join all worker threads
+		static void Shutdown();
+
+		static bool IsInitialized();
+
+		//Worker threads plus the calling thread
+		static u32 GetThreadCount();
+
+		//Splits [0, count) into chunks of chunkSize and runs 'job(begin, end, chunkIndex)'
+		//for each chunk across all threads, returns once every chunk has finished.
+		//Chunk indices are stable for the same count and chunkSize regardless of which thread ran them
+		static void ParallelFor(
+			u32 count,
+			u32 chunkSize,
+			const function<void(u32, u32, u32)>& job);
+
+		//Returns how many chunks ParallelFor creates for this count and chunkSize
+		static u32 GetChunkCount(
+			u32 count,
+			u32 chunkSize);
+	};
+}
\ No newline at end of file
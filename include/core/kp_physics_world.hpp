@@ -22,28 +22,64 @@ namespace KalaPhysics::Core
 	using KalaHeaders::KalaLog::Log;
 	using KalaHeaders::KalaLog::LogType;
 
+	//default length of one fixed simulation step in seconds
+	constexpr f32 DEFAULT_FIXED_TIMESTEP = 1.0f / 60.0f;
+	constexpr f32 MIN_FIXED_TIMESTEP = 1.0f / 1000.0f;
+	constexpr f32 MAX_FIXED_TIMESTEP = 1.0f / 10.0f;
+	//max fixed steps run by one update call, time past this is dropped so a slow frame can't spiral
+	constexpr u8 MAX_STEPS_PER_UPDATE = 4;
+
 	//total max allowed substeps
 	constexpr u8 MAX_SUBSTEPS = 12;
-	//how fast substeps grow exponentially
+	//how fast substeps grow exponentially per step under pressure, they shrink by the same factor after
 	constexpr f32 SUBSTEP_GROWTH_FACTOR = 1.25f;
 	//at how many registered collisions do we start increasing substeps
 	constexpr u8 COLLISION_THRESHOLD = 10;
+	//at how deep of a penetration in meters do we start increasing substeps
+	constexpr f32 PENETRATION_THRESHOLD = 0.05f;
 	
 	//32 layers fit in a 32-bit bitmask for uint32_t for bitmasking collisions and colliders
 	constexpr u8 MAX_LAYERS = 32;
 	constexpr u8 MAX_LAYER_NAME_LENGTH = 50;
 
 	inline const vec3 MAX_GRAVITY = 100.0f;
+
+	struct LIB_API PhysicsStepStats
+	{
+		u32 steps{};          //fixed steps run by the last update call
+		u8 substeps{};        //substeps of the last fixed step
+		u32 contactCount{};   //touching pairs at the start of the last fixed step
+		f32 maxPenetration{}; //deepest contact at the start of the last fixed step
+		f32 droppedTime{};    //seconds discarded by the last update call because of MAX_STEPS_PER_UPDATE
+
+		//wall time of the last fixed step in milliseconds, summed over its substeps
+		f64 broadphaseTime{};
+		f64 narrowphaseTime{};
+		f64 solverTime{};
+		f64 integrateTime{};
+		f64 ccdTime{};
+		f64 projectileTime{};
+		f64 stepTime{};
+	};
 	
 	class LIB_API PhysicsWorld
 	{
 	public:
-		//The main physics update function that handles a
-		//single simulation step per call based off of the passed deltaTime variable.
-		//Substeps are adjusted internally dynamically based off of registered collisions per update call,
-		//modify MAX_SUBSTEPS, SUBSTEP_GROWTH_FACTOR and COLLISION_THRESHOLD to adjust substep growth
+		//The main physics update function, deltaTime is added to an accumulator
+		//which is drained in fixed steps of GetFixedTimestep seconds, up to MAX_STEPS_PER_UPDATE per call.
+		//Substeps of each fixed step are adjusted internally based off of registered collisions and penetration depth,
+		//modify MAX_SUBSTEPS, SUBSTEP_GROWTH_FACTOR, COLLISION_THRESHOLD and PENETRATION_THRESHOLD to adjust substep growth
 		static void Update(f32 deltaTime);
 
+		static f32 GetFixedTimestep();
+		static void SetFixedTimestep(f32 newValue);
+
+		//How far the leftover accumulator time is into the next fixed step in the 0-1 range,
+		//renderers blend the previous and current body state by this to hide the fixed step rate
+		static f32 GetInterpolationAlpha();
+
+		static const PhysicsStepStats& GetStepStats();
+
 		//Returns count of currently used layers
 		static u64 GetLayerCount();
 
@@ -68,8 +104,14 @@ namespace KalaPhysics::Core
 		static bool CanCollide(
 			u8 a,
 			u8 b);
+		//Returns the bits of every layer this layer collides with, or 0 if the layer doesn't exist.
+		//No name lookups or logging, colliders cache this for the broadphase pair filter
+		static u32 GetCollisionMask(u8 layer);
 
 		static const vec3& GetGravity();
 		static void SetGravity(const vec3& newValue);
+	private:
+		//Runs one fixed step with its substeps
+		static void Step(f32 deltaTime);
 	};
 }
\ No newline at end of file
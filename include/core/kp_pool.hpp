@@ -0,0 +1,68 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "core_utils.hpp"
+
+namespace KalaPhysics::Core
+{
+	using std::vector;
+
+	using u32 = uint32_t;
+
+	//How many blocks a pool grows by when it runs out and nothing was reserved
+	constexpr u32 DEFAULT_POOL_CHUNK_BLOCKS = 256;
+
+	//Fixed-size block allocator, blocks are carved from large chunks
+	//and recycled through an intrusive free list, chunks are never returned until the pool dies.
+	//Not thread-safe, objects are created and destroyed from the main thread
+	class LIB_API BlockPool
+	{
+	public:
+		BlockPool(
+			size_t blockSize,
+			size_t blockAlign,
+			u32 chunkBlocks = DEFAULT_POOL_CHUNK_BLOCKS);
+		~BlockPool();
+
+		BlockPool(const BlockPool&) = delete;
+		BlockPool& operator=(const BlockPool&) = delete;
+
+		void* Allocate();
+		void Free(void* block);
+
+		//Make sure the next count allocations never hit the system allocator,
+		//missing blocks are added as one chunk
+		void Reserve(u32 count);
+
+		size_t GetBlockSize() const;
+		//Blocks currently handed out
+		u32 GetLiveCount() const;
+		//Blocks owned by the pool, live or free
+		u32 GetCapacity() const;
+		u32 GetChunkCount() const;
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next{};
+		};
+
+		void AddChunk(u32 blocks);
+
+		vector<void*> chunks{};
+		FreeBlock* freeList{};
+
+		size_t blockSize{};
+		size_t blockAlign{};
+		u32 chunkBlocks{};
+
+		u32 freeCount{};
+		u32 capacity{};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//Define KP_DISABLE_PROFILER for both KalaPhysics and its users to compile the profiler out,
+//every KP_PROFILE_* macro then expands to nothing and its arguments are never evaluated
+#ifndef KP_DISABLE_PROFILER
+	#define KP_PROFILER_ENABLED
+#endif
+
+#ifdef KP_PROFILER_ENABLED
+
+#include <array>
+#include <vector>
+#include <string>
+
+#include "core_utils.hpp"
+
+namespace KalaPhysics::Core
+{
+	using std::array;
+	using std::vector;
+	using std::string;
+
+	using u8 = uint8_t;
+	using u32 = uint32_t;
+	using u64 = uint64_t;
+
+	//Frame records kept in the ring buffer, older frames are overwritten
+	constexpr u32 PROFILER_FRAME_CAPACITY = 64;
+	//Scopes a single frame can hold, later ones are only counted as dropped
+	constexpr u32 MAX_PROFILE_SCOPES = 512;
+	//Deepest scope nesting that is recorded
+	constexpr u32 MAX_PROFILE_DEPTH = 16;
+
+	enum class ProfileZone : u8
+	{
+		ZONE_UPDATE = 0,       //whole PhysicsWorld::Update call
+		ZONE_ACTIVE_SET = 1,   //collider set and layer mask sync
+		ZONE_STEP = 2,         //one fixed step
+		ZONE_BROADPHASE = 3,
+		ZONE_NARROWPHASE = 4,  //narrowphase and pair cache, once per substep
+		ZONE_SOLVER = 5,
+		ZONE_INTEGRATE = 6,    //velocity or position integration
+		ZONE_CCD = 7,
+		ZONE_SLEEPING = 8,
+		ZONE_RAY_SCENE = 9,    //ray hierarchy refit or rebuild
+		ZONE_RAY_QUERY = 10,   //batched ray casts
+		ZONE_PROJECTILES = 11, //delayed ray simulation
+
+		ZONE_COUNT = 12
+	};
+
+	enum class ProfileCounter : u8
+	{
+		COUNTER_STEPS = 0,            //fixed steps run
+		COUNTER_SUBSTEPS = 1,         //substeps over all fixed steps
+		COUNTER_BROADPHASE_PAIRS = 2, //pairs handed to the narrowphase over all fixed steps
+		COUNTER_CONTACTS = 3,         //touching pairs over all fixed steps
+		COUNTER_SLEEPING_BODIES = 4,  //sleeping bodies at the end of the update
+		COUNTER_GJK_ITERATIONS = 5,   //GJK iterations over all queries
+		COUNTER_RAY_QUERIES = 6,      //rays cast through the Ray API from any thread
+
+		COUNTER_COUNT = 7
+	};
+
+	struct LIB_API ProfileScope
+	{
+		u64 start{};    //nanoseconds since the frame started
+		u64 duration{}; //nanoseconds
+		ProfileZone zone{};
+		u8 depth{};     //0 for scopes that are not nested in another scope
+	};
+
+	//Everything recorded between two PhysicsWorld::Update calls, scopes are in closing order
+	struct LIB_API ProfileFrame
+	{
+		u64 index{};    //frame number, the first frame is 1
+		u64 start{};    //nanoseconds since the profiler was first enabled
+		u64 duration{}; //nanoseconds until the next frame started
+
+		u32 scopeCount{};
+		u32 droppedScopes{};
+		array<ProfileScope, MAX_PROFILE_SCOPES> scopes{};
+
+		array<u64, scast<size_t>(ProfileCounter::COUNTER_COUNT)> counters{};
+
+		//Sum of all scopes of this zone in milliseconds, nested scopes of the same zone are counted twice
+		f64 GetZoneTime(ProfileZone zone) const;
+		u64 GetCounter(ProfileCounter counter) const;
+	};
+
+	//Per-frame instrumentation of the physics pipeline.
+	//Scopes are recorded on the thread that calls PhysicsWorld::Update, counters from any thread.
+	//Finished frames go into a ring buffer that any thread can read without locks,
+	//a read that races with the frame being overwritten fails instead of returning torn data
+	class LIB_API Profiler
+	{
+	public:
+		//Recording is off until enabled, disabled scopes cost a single branch.
+		//Call from the thread that runs PhysicsWorld::Update
+		static void SetEnabled(bool newValue);
+		static bool IsEnabled();
+
+		//Publishes the running frame and starts the next one, called by PhysicsWorld::Update
+		static void NextFrame();
+
+		//Returns false if the scope is not recorded, only recorded scopes may be ended
+		static bool BeginScope(ProfileZone zone);
+		static void EndScope();
+
+		static void AddCounter(
+			ProfileCounter counter,
+			u64 value);
+		static void SetCounter(
+			ProfileCounter counter,
+			u64 value);
+
+		//Index of the newest published frame, 0 if none was published yet
+		static u64 GetLatestFrameIndex();
+		//Copies the frame with this index, returns false if it was not published yet or already overwritten
+		static bool GetFrame(
+			u64 index,
+			ProfileFrame& outFrame);
+		//Copies up to count of the newest published frames, oldest first
+		static void GetFrames(
+			u32 count,
+			vector<ProfileFrame>& outFrames);
+
+		//Writes up to frameCount of the newest frames as Chrome trace event JSON,
+		//open it in chrome://tracing or Perfetto
+		static bool ExportChromeTrace(
+			const string& filePath,
+			u32 frameCount = PROFILER_FRAME_CAPACITY);
+
+		static const char* GetZoneName(ProfileZone zone);
+		static const char* GetCounterName(ProfileCounter counter);
+	};
+
+	//Records a scope from construction until destruction
+	class LIB_API ProfileScopeTimer
+	{
+	public:
+		ProfileScopeTimer(ProfileZone zone) : isRecording(Profiler::BeginScope(zone)) {}
+		~ProfileScopeTimer() { if (isRecording) Profiler::EndScope(); }
+
+		ProfileScopeTimer(const ProfileScopeTimer&) = delete;
+		ProfileScopeTimer& operator=(const ProfileScopeTimer&) = delete;
+	private:
+		bool isRecording{};
+	};
+}
+
+#define KP_PROFILE_CONCAT_INNER(a, b) a##b
+#define KP_PROFILE_CONCAT(a, b) KP_PROFILE_CONCAT_INNER(a, b)
+
+//Records the rest of the enclosing block as a scope of this zone
+#define KP_PROFILE_SCOPE(zone) \
+	KalaPhysics::Core::ProfileScopeTimer KP_PROFILE_CONCAT(kpProfileScope, __LINE__)(KalaPhysics::Core::ProfileZone::zone)
+
+//Adds value to a counter of the running frame, value is only evaluated while recording
+#define KP_PROFILE_COUNT(counter, value) \
+	do \
+	{ \
+		if (KalaPhysics::Core::Profiler::IsEnabled()) \
+		{ \
+			KalaPhysics::Core::Profiler::AddCounter(KalaPhysics::Core::ProfileCounter::counter, value); \
+		} \
+	} while (0)
+
+//Overwrites a counter of the running frame, value is only evaluated while recording
+#define KP_PROFILE_SET(counter, value) \
+	do \
+	{ \
+		if (KalaPhysics::Core::Profiler::IsEnabled()) \
+		{ \
+			KalaPhysics::Core::Profiler::SetCounter(KalaPhysics::Core::ProfileCounter::counter, value); \
+		} \
+	} while (0)
+
+#define KP_PROFILE_NEXT_FRAME() KalaPhysics::Core::Profiler::NextFrame()
+
+#else
+
+#define KP_PROFILE_SCOPE(zone)
+#define KP_PROFILE_COUNT(counter, value) do {} while (0)
+#define KP_PROFILE_SET(counter, value) do {} while (0)
+#define KP_PROFILE_NEXT_FRAME() do {} while (0)
+
+#endif
\ No newline at end of file
@@ -7,7 +7,6 @@
 
 #include "core_utils.hpp"
 
-#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -15,7 +14,6 @@
 
 namespace KalaPhysics::Core
 {
-	using std::unordered_map;
 	using std::vector;
 	using std::unique_ptr;
 	using std::make_unique;
@@ -24,6 +22,7 @@ namespace KalaPhysics::Core
 	using std::remove_if;
 	using std::is_class_v;
 	
+	using u8 = uint8_t;
 	using u32 = uint32_t;
 	
 	//Stores local non-owning pointers per T instance inside the Registry struct
@@ -39,7 +38,7 @@ namespace KalaPhysics::Core
 		inline T* GetRoot()
 		{
 			return parent
-			? T::registry.hierarchy[parent].GetRoot()
+			? T::registry.GetHierarchy(parent).GetRoot()
 			: thisObject;
 		}
 
@@ -64,7 +63,7 @@ namespace KalaPhysics::Core
 				if (c == targetObject) return true;
 
 				if (recursive
-					&& T::registry.hierarchy[c].HasTarget(targetObject, true))
+					&& T::registry.GetHierarchy(c).HasTarget(targetObject, true))
 				{
 					return true;
 				}
@@ -76,7 +75,7 @@ namespace KalaPhysics::Core
 				if (parent == targetObject) return true;
 
 				if (recursive
-					&& T::registry.hierarchy[parent].HasTarget(targetObject, true))
+					&& T::registry.GetHierarchy(parent).HasTarget(targetObject, true))
 				{
 					return true;
 				}
@@ -101,7 +100,7 @@ namespace KalaPhysics::Core
 			if (parent == targetObject) return true;
 
 			if (recursive
-				&& T::registry.hierarchy[parent].IsParent(targetObject, true))
+				&& T::registry.GetHierarchy(parent).IsParent(targetObject, true))
 			{
 				return true;
 			}
@@ -115,10 +114,10 @@ namespace KalaPhysics::Core
 				|| !targetObject
 				|| targetObject == thisObject
 				|| HasTarget(targetObject, true)
-				|| T::registry.hierarchy[targetObject].HasTarget(thisObject, true)
+				|| T::registry.GetHierarchy(targetObject).HasTarget(thisObject, true)
 				|| (parent
 				&& (parent == targetObject
-				|| T::registry.hierarchy[parent].HasTarget(thisObject, true))))
+				|| T::registry.GetHierarchy(parent).HasTarget(thisObject, true))))
 			{
 				return false;
 			}
@@ -129,7 +128,7 @@ namespace KalaPhysics::Core
 			//set this target parent
 			parent = targetObject;
 			//add this as new child to parent
-			T::registry.hierarchy[parent].children.push_back(thisObject);
+			T::registry.GetHierarchy(parent).children.push_back(thisObject);
 
 			return true;
 		}
@@ -142,7 +141,7 @@ namespace KalaPhysics::Core
 				return false;
 			}
 
-			vector<T*>& parentChildren = T::registry.hierarchy[parent].children;
+			vector<T*>& parentChildren = T::registry.GetHierarchy(parent).children;
 
 			parentChildren.erase(remove(
 				parentChildren.begin(),
@@ -171,7 +170,7 @@ namespace KalaPhysics::Core
 				if (c == targetObject) return true;
 
 				if (recursive
-					&& T::registry.hierarchy[c].IsChild(targetObject, true))
+					&& T::registry.GetHierarchy(c).IsChild(targetObject, true))
 				{
 					return true;
 				}
@@ -185,13 +184,13 @@ namespace KalaPhysics::Core
 				|| !targetObject
 				|| targetObject == thisObject
 				|| HasTarget(targetObject, true)
-				|| T::registry.hierarchy[targetObject].HasTarget(thisObject, true))
+				|| T::registry.GetHierarchy(targetObject).HasTarget(thisObject, true))
 			{
 				return false;
 			}
 
 			children.push_back(targetObject);
-			T::registry.hierarchy[targetObject].parent = thisObject;
+			T::registry.GetHierarchy(targetObject).parent = thisObject;
 
 			return true;
 		}
@@ -208,9 +207,9 @@ namespace KalaPhysics::Core
 				return false;
 			}
 
-			if (T::registry.hierarchy[targetObject].parent)
+			if (T::registry.GetHierarchy(targetObject).parent)
 			{
-				T::registry.hierarchy[targetObject].parent = nullptr;
+				T::registry.GetHierarchy(targetObject).parent = nullptr;
 			}
 
 			if (isDestructive) T::registry.RemoveContent(targetObject, true);
@@ -235,7 +234,7 @@ namespace KalaPhysics::Core
 
 			for (auto* c : children)
 			{
-				T::registry.hierarchy[c].parent = nullptr;
+				T::registry.GetHierarchy(c).parent = nullptr;
 				
 				if (isDestructive) T::registry.RemoveContent(c, true);
 			}				
@@ -244,85 +243,156 @@ namespace KalaPhysics::Core
 		}
 	};
 
-	//Stores unique_ptrs and non-owning pointers of class T for ID-based lookups,
-	//should always be stored as 'static inline KalaPhysicsRegistry<T> registry'
+	//Registry IDs are generational handles, the low bits pick a slot
+	//and the high bits hold the generation of that slot when the ID was issued
+	constexpr u32 REGISTRY_SLOT_BITS = 20;
+	constexpr u32 REGISTRY_SLOT_MASK = (1u << REGISTRY_SLOT_BITS) - 1;
+	constexpr u32 REGISTRY_GENERATION_MASK = (1u << (32 - REGISTRY_SLOT_BITS)) - 1;
+
+	//Max live objects per registry
+	constexpr u32 MAX_REGISTRY_SLOTS = 1u << REGISTRY_SLOT_BITS;
+
+	//Events a registry publishes per slot until they are drained
+	constexpr u8 REGISTRY_EVENT_ADDED = 1u << 0;   //an object was added to the slot
+	constexpr u8 REGISTRY_EVENT_REMOVED = 1u << 1; //the object of the slot was removed
+	constexpr u8 REGISTRY_EVENT_CHANGED = 1u << 2; //the owner changed state the object is sorted by
+
+	//Owns instances of class T in a generational slot map, IDs are issued by AddContent.
+	//Lookups, inserts and removals are O(1), removed slots bump their generation
+	//so IDs of removed objects are rejected instead of resolving to another object.
+	//Every add, remove and published state change links its slot into an intrusive dirty list
+	//so the system that sorts the objects only visits what changed since its last DrainEvents.
+	//Should always be stored as 'static inline KalaPhysicsRegistry<T> registry'
 	template<typename T>
 		requires is_class_v<T>
 	struct LIB_API KalaPhysicsRegistry
 	{
-		//Owner registry with ID as key
-		static inline unordered_map<u32, unique_ptr<T>> createdContent{};
-		//Runtime non-owning pointers
+		static constexpr u32 NULL_SLOT = 0xFFFFFFFFu;
+
+		struct Slot
+		{
+			unique_ptr<T> content{};
+
+			//generation of the current or next occupant, never 0 so no valid ID is ever 0
+			u32 generation = 1;
+			//index of the content in runtimeContent while occupied
+			u32 denseIndex{};
+			//next free slot while unoccupied
+			u32 nextFree = NULL_SLOT;
+
+			//events since the last drain, the slot is in the dirty list while this is not 0
+			u8 events{};
+			//next slot of the dirty list
+			u32 nextDirty = NULL_SLOT;
+		};
+
+		//Owner storage, slots are reused through a free list and never shrink
+		static inline vector<Slot> slots{};
+		//Runtime non-owning pointers, densely packed in no particular order
 		static inline vector<T*> runtimeContent{};
-		//Hierarchy content for storing parent-child relations per instance of this class
-		static inline unordered_map<T*, KalaPhysicsHierarchy<T>> hierarchy{};
+		//IDs of runtimeContent at the same index
+		static inline vector<u32> runtimeIDs{};
+		//Hierarchy content for storing parent-child relations per slot
+		static inline vector<KalaPhysicsHierarchy<T>> hierarchy{};
+
+		static inline u32 freeList = NULL_SLOT;
+		//first slot of the dirty list
+		static inline u32 dirtyHead = NULL_SLOT;
+		//bumped by every removal, lets caches of non-owning pointers notice they went stale without draining
+		static inline u64 removeCount{};
+
+		static inline u32 GetSlot(u32 targetID) { return targetID & REGISTRY_SLOT_MASK; }
+		static inline u32 GetGeneration(u32 targetID) { return targetID >> REGISTRY_SLOT_BITS; }
+
+		//Returns true if the ID points to a live object, false for removed or never issued IDs
+		static inline bool IsValid(u32 targetID)
+		{
+			u32 slot = GetSlot(targetID);
 
-		//Get non-owning value by ID
+			return slot < slots.size()
+				&& slots[slot].content
+				&& slots[slot].generation == GetGeneration(targetID);
+		}
+
+		//Get non-owning value by ID, returns nullptr for stale IDs
 		static inline T* GetContent(u32 targetID)
 		{
-			auto it = createdContent.find(targetID);
-			return it != createdContent.end()
-				? it->second.get()
+			return IsValid(targetID)
+				? slots[GetSlot(targetID)].content.get()
 				: nullptr;
 		}
 
-		//Add a new unique ptr and its ID
-		static inline bool AddContent(
-			u32 targetID,
-			unique_ptr<T> targetContent)
+		static inline u32 GetContentCount() { return scast<u32>(runtimeContent.size()); }
+
+		//Hierarchy node of a live object
+		static inline KalaPhysicsHierarchy<T>& GetHierarchy(T* targetPtr)
 		{
-			if (!targetContent
-				|| targetID == 0
-				|| createdContent.contains(targetID))
+			static KalaPhysicsHierarchy<T> detached{};
+
+			if (!targetPtr
+				|| GetContent(targetPtr->GetID()) != targetPtr)
 			{
-				return false;
+				detached = {};
+				return detached;
+			}
+
+			return hierarchy[GetSlot(targetPtr->GetID())];
+		}
+
+		//Takes ownership of a new object and returns its ID, or 0 if every slot is in use
+		static inline u32 AddContent(unique_ptr<T> targetContent)
+		{
+			if (!targetContent) return 0;
+
+			u32 slot{};
+			if (freeList != NULL_SLOT)
+			{
+				slot = freeList;
+				freeList = slots[slot].nextFree;
+			}
+			else
+			{
+				if (slots.size() >= MAX_REGISTRY_SLOTS) return 0;
+
+				slots.emplace_back();
+				hierarchy.emplace_back();
+				slot = scast<u32>(slots.size() - 1);
 			}
 
 			T* raw = targetContent.get();
-			createdContent[targetID] = std::move(targetContent);
+			u32 newID = (slots[slot].generation << REGISTRY_SLOT_BITS) | slot;
+
+			Slot& s = slots[slot];
+			s.content = std::move(targetContent);
+			s.denseIndex = scast<u32>(runtimeContent.size());
+			s.nextFree = NULL_SLOT;
+
 			runtimeContent.push_back(raw);
-			
-			//add hierarchy node
-			hierarchy[raw] = KalaPhysicsHierarchy<T>{};
-			hierarchy[raw].thisObject = raw;
+			runtimeIDs.push_back(newID);
 
-			return true;
+			hierarchy[slot] = KalaPhysicsHierarchy<T>{};
+			hierarchy[slot].thisObject = raw;
+
+			PublishEvent(slot, REGISTRY_EVENT_ADDED);
+
+			return newID;
+		}
+
+		//Grow every container for count more objects so bulk creation reallocates at most once
+		static inline void Reserve(u32 count)
+		{
+			slots.reserve(slots.size() + count);
+			hierarchy.reserve(hierarchy.size() + count);
+			runtimeContent.reserve(runtimeContent.size() + count);
+			runtimeIDs.reserve(runtimeIDs.size() + count);
 		}
 
-		//Remove content by ID
+		//Remove content by ID, returns false if the ID is stale
 		static inline bool RemoveContent(u32 targetID)
 		{
-			T* targetPtr{};
-			
-			auto it = createdContent.find(targetID);
-			if (it != createdContent.end()) targetPtr = it->second.get();
-			
-			//erase from hierarchy
-			if (targetPtr)
-			{
-				hierarchy.erase(targetPtr);
-				
-				for (auto& [obj, node] : hierarchy)
-				{
-					node.children.erase(remove(
-						node.children.begin(),
-						node.children.end(),
-						targetPtr),
-						node.children.end());
-						
-					if (node.parent == targetPtr) node.parent = nullptr;
-				}	
-			}
-			
-			runtimeContent.erase(
-				remove_if(runtimeContent.begin(), runtimeContent.end(),
-					[&](T* p)
-					{
-						return p && p->GetID() == targetID;
-					}),
-				runtimeContent.end());
+			if (!IsValid(targetID)) return false;
 
-			createdContent.erase(targetID);
+			RemoveSlot(GetSlot(targetID), false);
 
 			return true;
 		}
@@ -331,53 +401,69 @@ namespace KalaPhysics::Core
 			T* targetPtr,
 			bool removedViaHierarchy = false)
 		{
-			if (!targetPtr) return false;
-
-			//skip early if target ptr wasnt even found from runtime content vector
-			if (find(runtimeContent.begin(),
-				runtimeContent.end(),
-				targetPtr)
-				== runtimeContent.end())
+			if (!targetPtr
+				|| GetContent(targetPtr->GetID()) != targetPtr)
 			{
 				return false;
 			}
-			
-			if (!removedViaHierarchy)
-			{
-				//erase from hierarchy
-				hierarchy.erase(targetPtr);
-				
-				for (auto& [obj, node] : hierarchy)
-				{
-					node.children.erase(remove(
-						node.children.begin(),
-						node.children.end(),
-						targetPtr),
-						node.children.end());
-						
-					if (node.parent == targetPtr) node.parent = nullptr;
-				}	
-			}
 
-			runtimeContent.erase(remove(
-				runtimeContent.begin(),
-				runtimeContent.end(),
-				targetPtr),
-				runtimeContent.end());
+			RemoveSlot(GetSlot(targetPtr->GetID()), removedViaHierarchy);
+
+			return true;
+		}
+
+		static inline void RemoveAllContent()
+		{
+			//drop every relation first so no removal looks at an object destroyed before it
+			for (auto& node : hierarchy) node = KalaPhysicsHierarchy<T>{};
 
-			if (createdContent.contains(targetPtr->GetID()))
+			//destroy from the back so every removal is a plain pop
+			while (!runtimeIDs.empty())
 			{
-				createdContent.erase(targetPtr->GetID());
+				RemoveSlot(GetSlot(runtimeIDs.back()), true);
 			}
+		}
 
-			return true;
+		//Publishes a state change of a live object, stale IDs are ignored
+		static inline void MarkChanged(u32 targetID)
+		{
+			if (IsValid(targetID)) PublishEvent(GetSlot(targetID), REGISTRY_EVENT_CHANGED);
 		}
 
-		static inline void RemoveAllContent()
+		//Calls 'void callback(u32 slot, u8 events, T* content)' once per slot with events since the last drain
+		//and clears them, content is nullptr if the slot is empty by now. A slot that was emptied and reused
+		//in between reports both the removal and the addition. Only one system may drain a registry
+		template<typename F>
+		static inline void DrainEvents(F&& callback)
 		{
-			hierarchy.clear();
-			createdContent.clear();
-			runtimeContent.clear();
+			//events published by the callback start a new list for the next drain
+			u32 slot = dirtyHead;
+			dirtyHead = NULL_SLOT;
+
+			while (slot != NULL_SLOT)
+			{
+				Slot& s = slots[slot];
+
+				u32 next = s.nextDirty;
+				u8 events = s.events;
+
+				s.nextDirty = NULL_SLOT;
+				s.events = 0;
+
+				callback(slot, events, s.content.get());
+
+				slot = next;
+			}
+		}
+		//Calls 'void callback(u32 slot, u8 events)' once per slot with events since the last drain
+		//without clearing them, lets caches outside the draining system find what was removed in O(changes)
+		template<typename F>
+		static inline void PeekEvents(F&& callback)
+		{
+			for (u32 slot = dirtyHead; slot != NULL_SLOT; slot = slots[slot].nextDirty)
+			{
+				callback(slot, slots[slot].events);
+			}
 		}
 		
 		//
@@ -385,7 +471,7 @@ namespace KalaPhysics::Core
 		//
 		
 		//Returns true if the window owns the ID
-		//Requires target class inside createdContent and runtimeContent
+		//Requires target class inside slots and runtimeContent
 		//to have the 'u32 GetWindowID()' function.
 		//Should not be used for externally created registries
 		//because the Window class does not accept new IDs
@@ -395,15 +481,14 @@ namespace KalaPhysics::Core
 			u32 windowID,
 			u32 targetID)
 		{
-			auto it = createdContent.find(targetID);
-			if (it == createdContent.end()) return false;
+			T* content = GetContent(targetID);
 
-			return it->second
-				&& it->second->GetWindowID() == windowID;
+			return content
+				&& content->GetWindowID() == windowID;
 		}
 			
 		//Get all content as non-owning pointers by window ID from containers.
-		//Requires target class inside createdContent and runtimeContent
+		//Requires target class inside slots and runtimeContent
 		//to have the 'u32 GetWindowID()' function.
 		//Should not be used for externally created registries
 		//because the Window class does not accept new IDs
@@ -422,7 +507,7 @@ namespace KalaPhysics::Core
 		}
 
 		//Remove all content by window ID from containers.
-		//Requires target class inside createdContent and runtimeContent
+		//Requires target class inside slots and runtimeContent
 		//to have the 'u32 GetWindowID()' function.
 		//Should not be used for externally created registries
 		//because the Window class does not accept new IDs
@@ -430,22 +515,86 @@ namespace KalaPhysics::Core
 			requires requires(U& u) { u.GetWindowID(); }
 		static inline void RemoveAllWindowContent(u32 windowID)
 		{
-			runtimeContent.erase(remove_if(
-				runtimeContent.begin(),
-				runtimeContent.end(),
-				[&](T* c)
+			//walk backwards so swap-removes only move already visited content
+			for (size_t i = runtimeContent.size(); i-- > 0;)
+			{
+				if (i < runtimeContent.size()
+					&& runtimeContent[i]->GetWindowID() == windowID)
 				{
-					return c && c->GetWindowID() == windowID;
-				}), runtimeContent.end());
-					
-			for (auto it = createdContent.begin(); it != createdContent.end();)
+					RemoveSlot(GetSlot(runtimeIDs[i]), false);
+				}
+			}
+		}
+	private:
+		static inline void PublishEvent(
+			u32 slot,
+			u8 event)
+		{
+			Slot& s = slots[slot];
+
+			if (s.events == 0)
+			{
+				s.nextDirty = dirtyHead;
+				dirtyHead = slot;
+			}
+
+			s.events |= event;
+		}
+
+		static inline void RemoveSlot(
+			u32 slot,
+			bool removedViaHierarchy)
+		{
+			Slot& s = slots[slot];
+			T* targetPtr = s.content.get();
+
+			//detach from the hierarchy, only direct relations point at this object
+			KalaPhysicsHierarchy<T>& node = hierarchy[slot];
+			if (!removedViaHierarchy
+				&& node.parent)
 			{
-				if (it->second->GetWindowID() == windowID)
+				vector<T*>& parentChildren = GetHierarchy(node.parent).children;
+
+				parentChildren.erase(remove(
+					parentChildren.begin(),
+					parentChildren.end(),
+					targetPtr),
+					parentChildren.end());
+			}
+			//children may be destroyed already, so their nodes are found by their parent pointer instead of through them
+			if (!node.children.empty())
+			{
+				for (auto& child : hierarchy)
 				{
-					it = createdContent.erase(it);
+					if (child.parent == targetPtr) child.parent = nullptr;
 				}
-				else ++it;
 			}
+			node = KalaPhysicsHierarchy<T>{};
+
+			//swap-remove from the dense arrays
+			u32 last = scast<u32>(runtimeContent.size() - 1);
+			if (s.denseIndex != last)
+			{
+				runtimeContent[s.denseIndex] = runtimeContent[last];
+				runtimeIDs[s.denseIndex] = runtimeIDs[last];
+				slots[GetSlot(runtimeIDs[last])].denseIndex = s.denseIndex;
+			}
+			runtimeContent.pop_back();
+			runtimeIDs.pop_back();
+
+			//retire the generation so every existing ID to this slot goes stale, 0 is skipped
+			s.generation = (s.generation + 1) & REGISTRY_GENERATION_MASK;
+			if (s.generation == 0) s.generation = 1;
+
+			s.nextFree = freeList;
+			freeList = slot;
+
+			PublishEvent(slot, REGISTRY_EVENT_REMOVED);
+			++removeCount;
+
+			//destroy last, the destructor may look up other content in this registry
+			unique_ptr<T> removed = std::move(s.content);
+			removed.reset();
 		}
 	};
-}
+}
\ No newline at end of file
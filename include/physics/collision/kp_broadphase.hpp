@@ -0,0 +1,131 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+
+#include "core_utils.hpp"
+
+#include "physics/collision/kp_dynamic_tree.hpp"
+#include "physics/collision/kp_sweep_and_prune.hpp"
+#include "physics/collision/kp_spatial_hash.hpp"
+#include "physics/collision/kp_bvh.hpp"
+
+namespace KalaPhysics::Core
+{
+	class PhysicsWorld;
+}
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+
+	using u8 = uint8_t;
+	using u32 = uint32_t;
+	using u64 = uint64_t;
+
+	class Collider;
+
+	//How far the fat bounds of a tree leaf reach past the tight collider bounds
+	constexpr f32 BROADPHASE_FAT_MARGIN = 0.1f;
+	//Minimum share of potential pairs the broadphase is expected to cull
+	constexpr f32 BROADPHASE_CULL_TARGET = 0.95f;
+
+	enum class BroadphaseType : u8
+	{
+		BROADPHASE_DYNAMIC_TREE = 0,    //incrementally refitted fat AABB tree
+		BROADPHASE_SWEEP_AND_PRUNE = 1, //persistent insertion-sorted endpoint arrays
+		BROADPHASE_SPATIAL_HASH = 2     //hashed uniform grid for similarly sized colliders
+	};
+
+	enum class StaticTreeUpdate : u8
+	{
+		STATIC_KEEP = 0,   //no static collider changed since the last update
+		STATIC_REFIT = 1,  //static colliders moved or changed layer, the tree is refitted in place
+		STATIC_REBUILD = 2 //static colliders were added or removed, the tree is rebuilt
+	};
+
+	struct LIB_API ColliderPair
+	{
+		Collider* a{};
+		Collider* b{};
+	};
+
+	struct LIB_API BroadphaseStats
+	{
+		u32 colliderCount{};       //colliders fed to the broadphase this frame
+		u32 staticColliderCount{}; //colliders of the above in the static tree, never paired with each other
+		u64 potentialPairs{};      //n * (n - 1) / 2 for all colliders above
+		u64 overlappingPairs{};    //pairs whose tight bounds overlap, tree queries already skip layers that don't collide
+		u64 acceptedPairs{};       //overlapping pairs that passed the pair filters
+		u32 reinsertedProxies{};   //leaves that escaped their fat bounds this frame
+		u64 endpointSwaps{};       //sweep and prune insertion sort swaps this frame
+
+		//what the static tree went through this frame
+		StaticTreeUpdate staticUpdate{};
+
+		//share of potential pairs that never reached the narrowphase
+		f32 cullRatio{};
+	};
+
+	class LIB_API Broadphase
+	{
+		friend class KalaPhysics::Core::PhysicsWorld;
+	public:
+		//Switch the broadphase used by PhysicsWorld::Update,
+		//all proxies are rebuilt for the new type on the next update
+		static void SetType(BroadphaseType newType);
+		static BroadphaseType GetType();
+
+		//Set the cell size of the spatial hash broadphase,
+		//a good start is roughly the diameter of the most common collider
+		static void SetHashCellSize(f32 newValue);
+		static f32 GetHashCellSize();
+
+		//Returns cell occupancy of the last spatial hash update
+		static const SpatialHashStats& GetHashStats();
+
+		//Returns pair counts of the last broadphase update
+		static const BroadphaseStats& GetStats();
+		//Returns true if the last update culled at least BROADPHASE_CULL_TARGET of all potential pairs
+		static bool MeetsCullTarget();
+
+		//Drops all proxies, they are recreated on the next update
+		static void Clear();
+
+		//Collects every collider whose proxy bounds from the last update overlap bounds,
+		//static colliders included
+		static void Query(
+			const ColliderBounds& bounds,
+			vector<Collider*>& outColliders);
+		//Returns false for colliders of the same rigidbody and for layers that don't collide
+		static bool CanPair(
+			const Collider* a,
+			const Collider* b);
+	private:
+		//Refreshes the proxies of all dynamic colliders in the broadphase of the current type,
+		//brings the static tree up to date by staticUpdate and writes every overlapping, layer-compatible
+		//dynamic-dynamic and dynamic-static pair into outPairs. Static colliders live in their own
+		//surface area heuristic tree that is only rebuilt when the static set changes,
+		//so levels with far more static than dynamic colliders never pay for static-static pairs
+		static void Update(
+			const vector<Collider*>& staticColliders,
+			const vector<Collider*>& dynamicColliders,
+			StaticTreeUpdate staticUpdate,
+			vector<ColliderPair>& outPairs);
+
+		//Runs the pair filters on an overlapping pair of two dynamic proxies and stores it if it passes
+		static void AcceptPair(
+			Collider* a,
+			Collider* b,
+			vector<ColliderPair>& outPairs);
+		//Runs the pair filters on an awake dynamic proxy overlapping a static collider
+		static void AcceptStaticPair(
+			Collider* a,
+			Collider* b,
+			vector<ColliderPair>& outPairs);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,393 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <span>
+#include <bit>
+
+#include "core_utils.hpp"
+
+#include "physics/collision/kp_collision_math.hpp"
+#include "physics/collision/kp_overlap_kernels.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+	using std::span;
+	using std::popcount;
+	using std::countr_zero;
+
+	using u32 = uint32_t;
+
+	class Collider;
+
+	//Max colliders stored in one leaf, overlap queries test a whole leaf in one kernel block
+	constexpr u32 BVH_MAX_LEAF_SIZE = OVERLAP_BLOCK_SIZE;
+	//Candidate split planes per axis of the binned surface area heuristic
+	constexpr u32 BVH_SAH_BINS = 12;
+	//Nodes this deep always become leaves, keeps the traversal stack bounded
+	constexpr u32 BVH_MAX_DEPTH = 48;
+
+	struct LIB_API BVHNode
+	{
+		ColliderBounds bounds{};
+
+		//union of the layer bits of every collider below this node
+		u32 mask{};
+
+		//first item of a leaf or right child of a branch, the left child always follows its parent
+		u32 offset{};
+		//items of a leaf, 0 for branches
+		u32 count{};
+	};
+
+	//Flattened bounding volume hierarchy over a fixed set of colliders for scene queries.
+	//Built top-down with a binned surface area heuristic in depth-first order so the left child
+	//is always the next node, refitted in place while the collider set stays the same.
+	//Every node carries the union of the layer bits below it so whole subtrees can be skipped by a mask.
+	//Queries only read the hierarchy and are safe to run from several threads at once
+	class LIB_API ColliderBVH
+	{
+	public:
+		//Builds the hierarchy from scratch, null colliders are skipped
+		void Build(span<Collider* const> colliders);
+		//Builds the hierarchy over the whole path of colliders that moved by motions during the last step,
+		//every item bounds covers its current bounds and the same bounds moved back by its motion.
+		//motions holds one translation per entry of colliders
+		void Build(
+			span<Collider* const> colliders,
+			span<const vec3> motions);
+		//Recomputes every bounds and mask bottom-up without changing the topology, masked items stay empty
+		void Refit();
+		//Hides one leaf item from every query and refit without touching its collider,
+		//so a removed collider leaves the hierarchy without a rebuild
+		void MaskItem(u32 index);
+
+		void Clear();
+
+		u32 GetNodeCount() const { return scast<u32>(nodes.size()); }
+		u32 GetItemCount() const { return scast<u32>(items.size()); }
+
+		//Leaf items in node order, masked items are nullptr
+		span<Collider* const> GetItems() const { return items; }
+
+		//Walks every leaf item whose bounds overlap bounds and whose layer bit is in mask.
+		//Calls 'bool callback(Collider* c)' per item, returning false stops the query
+		template<typename F>
+		inline void Query(
+			const ColliderBounds& bounds,
+			u32 mask,
+			F&& callback) const
+		{
+			if (nodes.empty()) return;
+
+			//every visited branch pops one entry and pushes two, so the depth bounds the stack
+			u32 stack[BVH_MAX_DEPTH + 2];
+			u32 count = 0;
+
+			stack[count++] = 0;
+
+			while (count > 0)
+			{
+				u32 index = stack[--count];
+				const BVHNode& node = nodes[index];
+
+				if ((node.mask & mask) == 0
+					|| !node.bounds.Overlaps(bounds))
+				{
+					continue;
+				}
+
+				if (node.count > 0)
+				{
+					//leaves fit one kernel block unless the depth limit cut the split short
+					u32 leafEnd = node.offset + node.count;
+					for (u32 block = node.offset; block < leafEnd; block += OVERLAP_BLOCK_SIZE)
+					{
+						u32 hits = OverlapKernels::OverlapAABBBlock(bounds, packedItemBounds, block);
+						if (leafEnd - block < OVERLAP_BLOCK_SIZE) hits &= (1u << (leafEnd - block)) - 1;
+
+						while (hits != 0)
+						{
+							u32 i = block + scast<u32>(countr_zero(hits));
+							hits &= hits - 1;
+
+							if ((itemMasks[i] & mask) == 0) continue;
+
+							if (!callback(items[i])) return;
+						}
+					}
+
+					continue;
+				}
+
+				stack[count++] = node.offset;
+				stack[count++] = index + 1;
+			}
+		}
+
+		//Walks every leaf item whose bounds the ray reaches before maxDistance, near children first.
+		//Calls 'f32 callback(Collider* c, f32 maxDistance)' per item, the callback returns the new
+		//max distance so a hit shortens the ray, and returning 0 or less stops the traversal.
+		//Returns the final max distance, 0 or less if the callback stopped the traversal
+		template<typename F>
+		inline f32 Raycast(
+			const vec3& origin,
+			const vec3& invDirection,
+			f32 maxDistance,
+			u32 mask,
+			F&& callback) const
+		{
+			if (nodes.empty()
+				|| (nodes[0].mask & mask) == 0)
+			{
+				return maxDistance;
+			}
+
+			f32 rootNear{};
+			if (!nodes[0].bounds.IntersectsRay(origin, invDirection, maxDistance, rootNear)) return maxDistance;
+
+			return RaycastSubtree(0, rootNear, origin, invDirection, maxDistance, mask, callback);
+		}
+
+		//Walks the hierarchy with every lane of laneMask at once, each node is tested against the whole packet
+		//in one kernel call and only the lanes that reach it go further down.
+		//Calls 'f32 callback(u32 lane, Collider* c, f32 maxDistance)' per item a lane reaches, the returned distance
+		//becomes the max distance of that lane and 0 or less finishes the lane.
+		//Once the packet has thinned out to a single lane the rest of that subtree continues as a single ray.
+		//Writes -1 to the max distance of finished lanes
+		template<typename F>
+		inline void RaycastPacket(
+			RayPacket& packet,
+			u32 laneMask,
+			u32 mask,
+			F&& callback) const
+		{
+			if (nodes.empty()
+				|| (nodes[0].mask & mask) == 0)
+			{
+				return;
+			}
+
+			struct PacketEntry
+			{
+				u32 node;
+				u32 lanes;
+			};
+
+			PacketEntry stack[BVH_MAX_DEPTH + 2];
+			u32 count = 0;
+
+			f32 near[RAY_PACKET_SIZE];
+			f32 rightNear[RAY_PACKET_SIZE];
+
+			u32 rootLanes = OverlapKernels::IntersectRayPacket(nodes[0].bounds, packet, near) & laneMask;
+			if (rootLanes == 0) return;
+			stack[count++] = { 0, rootLanes };
+
+			//lanes that have not been finished by their callback
+			u32 live = laneMask;
+
+			while (count > 0)
+			{
+				PacketEntry entry = stack[--count];
+
+				u32 lanes = entry.lanes & live;
+				if (lanes == 0) continue;
+
+				const BVHNode& node = nodes[entry.node];
+
+				//a lone lane gains nothing from the packet, trace it on its own
+				if (popcount(lanes) == 1)
+				{
+					u32 lane = scast<u32>(countr_zero(lanes));
+
+					vec3 origin(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+					vec3 invDirection(packet.invDirectionX[lane], packet.invDirectionY[lane], packet.invDirectionZ[lane]);
+
+					f32 nodeNear{};
+					if (!node.bounds.IntersectsRay(origin, invDirection, packet.maxDistance[lane], nodeNear)) continue;
+
+					f32 distance = RaycastSubtree(
+						entry.node,
+						nodeNear,
+						origin,
+						invDirection,
+						packet.maxDistance[lane],
+						mask,
+						[&](Collider* c, f32 currentMax) { return callback(lane, c, currentMax); });
+
+					if (distance <= 0.0f)
+					{
+						live &= ~(1u << lane);
+						distance = -1.0f;
+					}
+					packet.maxDistance[lane] = distance;
+
+					continue;
+				}
+
+				if (node.count > 0)
+				{
+					for (u32 i = node.offset; i < node.offset + node.count; i++)
+					{
+						if ((itemMasks[i] & mask) == 0) continue;
+
+						u32 itemLanes = OverlapKernels::IntersectRayPacket(itemBounds[i], packet, near) & lanes & live;
+
+						while (itemLanes != 0)
+						{
+							u32 lane = scast<u32>(countr_zero(itemLanes));
+							itemLanes &= itemLanes - 1;
+
+							f32 distance = callback(lane, items[i], packet.maxDistance[lane]);
+							if (distance <= 0.0f)
+							{
+								live &= ~(1u << lane);
+								distance = -1.0f;
+							}
+							packet.maxDistance[lane] = distance;
+						}
+					}
+
+					continue;
+				}
+
+				u32 left = entry.node + 1;
+				u32 right = node.offset;
+
+				u32 leftLanes = (nodes[left].mask & mask) != 0
+					? OverlapKernels::IntersectRayPacket(nodes[left].bounds, packet, near) & lanes
+					: 0;
+				u32 rightLanes = (nodes[right].mask & mask) != 0
+					? OverlapKernels::IntersectRayPacket(nodes[right].bounds, packet, rightNear) & lanes
+					: 0;
+
+				//coherent rays agree on the order, the first lane both children share decides it
+				if (leftLanes != 0
+					&& rightLanes != 0)
+				{
+					u32 lane = scast<u32>(countr_zero(leftLanes & rightLanes));
+					bool isLeftFirst = (leftLanes & rightLanes) == 0
+						|| near[lane] <= rightNear[lane];
+
+					if (isLeftFirst)
+					{
+						stack[count++] = { right, rightLanes };
+						stack[count++] = { left, leftLanes };
+					}
+					else
+					{
+						stack[count++] = { left, leftLanes };
+						stack[count++] = { right, rightLanes };
+					}
+				}
+				else if (leftLanes != 0) stack[count++] = { left, leftLanes };
+				else if (rightLanes != 0) stack[count++] = { right, rightLanes };
+			}
+		}
+	private:
+		//Single ray traversal below root, whose bounds the ray is already known to reach at rootNear.
+		//Returns the final max distance, 0 or less if the callback stopped the traversal
+		template<typename F>
+		inline f32 RaycastSubtree(
+			u32 root,
+			f32 rootNear,
+			const vec3& origin,
+			const vec3& invDirection,
+			f32 maxDistance,
+			u32 mask,
+			F&& callback) const
+		{
+			struct StackEntry
+			{
+				u32 node;
+				f32 near;
+			};
+
+			StackEntry stack[BVH_MAX_DEPTH + 2];
+			u32 count = 0;
+
+			stack[count++] = { root, rootNear };
+
+			while (count > 0)
+			{
+				StackEntry entry = stack[--count];
+
+				//a hit found since this node was pushed may already be closer
+				if (entry.near > maxDistance) continue;
+
+				const BVHNode& node = nodes[entry.node];
+
+				if (node.count > 0)
+				{
+					for (u32 i = node.offset; i < node.offset + node.count; i++)
+					{
+						f32 itemNear{};
+						if ((itemMasks[i] & mask) == 0
+							|| !itemBounds[i].IntersectsRay(origin, invDirection, maxDistance, itemNear))
+						{
+							continue;
+						}
+
+						maxDistance = callback(items[i], maxDistance);
+						if (maxDistance <= 0.0f) return maxDistance;
+					}
+
+					continue;
+				}
+
+				u32 left = entry.node + 1;
+				u32 right = node.offset;
+
+				f32 leftNear{};
+				f32 rightNear{};
+				bool hasLeft = (nodes[left].mask & mask) != 0
+					&& nodes[left].bounds.IntersectsRay(origin, invDirection, maxDistance, leftNear);
+				bool hasRight = (nodes[right].mask & mask) != 0
+					&& nodes[right].bounds.IntersectsRay(origin, invDirection, maxDistance, rightNear);
+
+				//the nearer child is pushed last so it is visited first
+				if (hasLeft
+					&& hasRight)
+				{
+					if (leftNear <= rightNear)
+					{
+						stack[count++] = { right, rightNear };
+						stack[count++] = { left, leftNear };
+					}
+					else
+					{
+						stack[count++] = { left, leftNear };
+						stack[count++] = { right, rightNear };
+					}
+				}
+				else if (hasLeft) stack[count++] = { left, leftNear };
+				else if (hasRight) stack[count++] = { right, rightNear };
+			}
+
+			return maxDistance;
+		}
+
+		void BuildNode(
+			u32 nodeIndex,
+			u32 begin,
+			u32 end,
+			u32 depth);
+
+		vector<BVHNode> nodes{};
+
+		//leaf items in node order
+		vector<Collider*> items{};
+		vector<ColliderBounds> itemBounds{};
+		//itemBounds packed for the overlap kernels, padded so a block starting at any item stays in range
+		PackedBounds packedItemBounds{};
+		vector<u32> itemMasks{};
+		//translation of every item over the last step, empty if the items are tested at rest
+		vector<vec3> itemMotions{};
+	};
+}
\ No newline at end of file
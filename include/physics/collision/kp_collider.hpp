@@ -8,26 +8,45 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <span>
+#include <cstddef>
 
 #include "core_utils.hpp"
 #include "math_utils.hpp"
 #include "log_utils.hpp"
 
 #include "core/kp_registry.hpp"
+#include "physics/collision/kp_collision_math.hpp"
+#include "physics/collision/kp_contact.hpp"
 
 namespace KalaPhysics::Core
 {
 	class PhysicsWorld;
 }
 
+namespace KalaPhysics::Physics
+{
+	class BodyStore;
+}
+
+namespace KalaPhysics::Physics::Collision
+{
+	class Broadphase;
+	class Narrowphase;
+
+	struct ConvexSupport;
+}
+
 namespace KalaPhysics::Physics::Collision
 {
 	using std::vector;
 	using std::string;
 	using std::function;
+	using std::span;
 
 	using u8 = uint8_t;
 	using u32 = uint32_t;
+	using i32 = int32_t;
 
 	using KalaHeaders::KalaMath::vec3;
 	using KalaHeaders::KalaMath::quat;
@@ -62,6 +81,9 @@ namespace KalaPhysics::Physics::Collision
 	class LIB_API Collider
 	{	
 		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class Broadphase;
+		friend class Narrowphase;
+		friend class KalaPhysics::Physics::BodyStore;
 	public:
 		static KalaPhysicsRegistry<Collider>& GetRegistry();
 
@@ -79,21 +101,38 @@ namespace KalaPhysics::Physics::Collision
 		void SetTriggerState(bool newValue);
 		bool IsTrigger() const;
 
-		//Assign a new parent rigidbody to this collider, or 0 if no parent
+		//Moves this collider to a new parent rigidbody, or detaches it with 0.
+		//The collider keeps its world pose and follows the new body from then on
 		void SetParentRigidBody(u32 newValue);
 		u32 GetParentRigidBody() const;
 
 		//Set collider layer by name, use "NONE" to remove the layer completely
 		void SetLayer(const string& layer);
 		string GetLayer();
+		//Layer index without the name lookup, 255 if this collider has no layer
+		u8 GetLayerIndex() const;
+		//Bit of this collider layer, 0 if this collider has no layer
+		u32 GetLayerBit() const;
+		//Bits of every layer this collider collides with, cached from the world collision rules
+		u32 GetCollisionMask() const;
 
 		ColliderShape GetColliderShape() const;
 		ColliderType GetColliderType() const;
 
-		//Returns a reference to this collider vertices
-		const vector<vec3>& GetVertices() const;
+		//False for shapes that always stay axis-aligned, a rigidbody carrying one never rotates
+		bool FollowsRotation() const;
+
+		//Returns a view of this collider vertices
+		span<const vec3> GetVertices() const;
 		//Returns a reference to this collider transform
 		const Transform3D& GetTransform() const;
+
+		//Returns the tight world-space axis-aligned bounds of this collider
+		virtual ColliderBounds GetBounds() const { return {}; }
+
+		//Moves this collider by delta in world space,
+		//a collider carried by a rigidbody keeps its new place relative to that rigidbody
+		virtual void Translate(const vec3& delta) {}
 		
 		void SetOnTriggerEnter(const function<void()>& func);
 		void SetOnTriggerExit(const function<void()>& func);
@@ -103,9 +142,49 @@ namespace KalaPhysics::Physics::Collision
 		void ClearOnTriggerExit();
 		void ClearOnTriggerStay();
 		
-		virtual ~Collider() = default;
+		virtual ~Collider();
 	protected:
-		virtual void Update(Collider* c, f32 deltaTime) {};
+		//Links this collider to its parent rigidbody if that rigidbody exists and has room,
+		//shapeName and logTag only label the log messages, success is not logged when isQuiet is true
+		void AttachToParent(
+			u32 newParent,
+			const string& shapeName,
+			const string& logTag,
+			bool isQuiet);
+
+		//Replaces this collider vertices with count uninitialized arena vertices and returns them for writing
+		vec3* ResizeVertices(u32 count);
+
+		//Publishes a shape or transform change of a static collider so the static broadphase tree is refitted,
+		//dynamic colliders are refreshed every step anyway but store their new pose relative to their rigidbody
+		//and refresh the inertia it derives from its colliders
+		void MarkMoved();
+
+		//World-space reference point and rotation of this shape, shapes that can't rotate report no rotation
+		virtual void GetPose(
+			vec3& outPos,
+			quat& outRot) const {}
+		//Places this shape at a world-space pose without touching its pose relative to its rigidbody,
+		//shapes that can't rotate only use the position
+		virtual void SetPose(
+			const vec3& newPos,
+			const quat& newRot) {}
+
+		//Returns the volume of this shape and fills its centroid relative to its pose
+		//and its principal inertia per unit mass in its pose frame, shapes without volume return 0
+		virtual f32 GetMassProperties(
+			vec3& outCentroid,
+			vec3& outInertia) const { return 0.0f; }
+
+		//Stores the current world pose relative to the parent rigidbody pose
+		void StoreLocalPose();
+		//Derives the world pose from the parent rigidbody pose and the stored local pose
+		void FollowParent(
+			const vec3& bodyPos,
+			const quat& bodyRot);
+
+		//Recomputes the cached layer bit and collision mask from the current layer and world collision rules
+		void RefreshLayerMasks();
 
 		bool isInitialized{};
 
@@ -115,17 +194,30 @@ namespace KalaPhysics::Physics::Collision
 		bool isTrigger{};
 
 		u32 parentRigidBody{};
+		//pose relative to the parent rigidbody, only used while this collider is carried by it
+		vec3 localPos{};
+		quat localRot{};
 
 		u8 layer = 255;
+		//cached so the broadphase pair filter is a single AND
+		u32 layerBit{};
+		u32 collisionMask{};
 	
 		ColliderShape shape{};
 		ColliderType type{};
 
-		vector<vec3> vertices;
+		//owned range in the shared vertex arena
+		vec3* vertexData{};
+		u32 vertexCount{};
+
 		Transform3D transform;
 
 		function<void()> onTriggerEnter{};
 		function<void()> onTriggerExit{};
 		function<void()> onTriggerStay{};
+
+		//broadphase proxy of this collider, only valid while proxyEpoch matches the broadphase epoch
+		i32 proxyID = -1;
+		u32 proxyEpoch{};
 	};
 }
\ No newline at end of file
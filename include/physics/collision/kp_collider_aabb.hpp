@@ -14,6 +14,11 @@ namespace KalaPhysics::Core
 	class PhysicsWorld;
 }
 
+namespace KalaPhysics::Physics::Collision
+{
+	class Narrowphase;
+}
+
 namespace KalaPhysics::Physics::Collision
 {
 	using KalaHeaders::KalaMath::kclamp;
@@ -25,22 +30,61 @@ namespace KalaPhysics::Physics::Collision
 	class LIB_API Collider_AABB : public Collider
 	{
 		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class Narrowphase;
 	public:
+		//Creation parameters of one AABB collider for CreateMany
+		struct Desc
+		{
+			u32 parentRigidBody{};
+			vec3 minCorner{};
+			vec3 maxCorner{};
+		};
+
 		//Initializes a broadphase-only AABB collider
 		static Collider_AABB* Initialize(
 			u32 parentRigidBody,
 			const vec3& minCorner,
 			const vec3& maxCorner);
 
+		//Initializes one AABB collider per desc and appends them to outColliders,
+		//every storage grows once up front and only a summary is logged
+		static void CreateMany(
+			span<const Desc> descs,
+			vector<Collider_AABB*>& outColliders);
+
+		//AABB colliders are carved from a shared fixed-size block pool
+		static void* operator new(size_t size);
+		static void operator delete(
+			void* ptr,
+			size_t size);
+
 		const vec3& GetMinCorner() const;
 		void SetMinCorner(const vec3& newValue);
 
 		const vec3& GetMaxCorner() const;
 		void SetMaxCorner(const vec3& newValue);
 
+		ColliderBounds GetBounds() const override;
+		void Translate(const vec3& delta) override;
+
+		//Support mapping of this shape for the GJK and EPA narrowphase
+		ConvexSupport GetSupport() const;
+
 		~Collider_AABB() override;
 	private:
-		void Update(Collider* c, f32 deltaTime) override;
+		void GetPose(
+			vec3& outPos,
+			quat& outRot) const override;
+		void SetPose(
+			const vec3& newPos,
+			const quat& newRot) override;
+		f32 GetMassProperties(
+			vec3& outCentroid,
+			vec3& outInertia) const override;
+
+		static Collider_AABB* Create(
+			const Desc& desc,
+			bool isQuiet);
 
 		vec3 minCorner{};
 		vec3 maxCorner{};
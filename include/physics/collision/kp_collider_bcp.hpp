@@ -14,6 +14,11 @@ namespace KalaPhysics::Core
 	class PhysicsWorld;
 }
 
+namespace KalaPhysics::Physics::Collision
+{
+	class Narrowphase;
+}
+
 namespace KalaPhysics::Physics::Collision
 {
 	using KalaHeaders::KalaMath::kclamp;
@@ -32,7 +37,18 @@ namespace KalaPhysics::Physics::Collision
 	class LIB_API Collider_BCP : public Collider
 	{
 		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class Narrowphase;
 	public:
+		//Creation parameters of one BCP collider for CreateMany
+		struct Desc
+		{
+			u32 parentRigidBody{};
+			vec3 pos{};
+			f32 height{};
+			f32 radius{};
+			ColliderType type{};
+		};
+
 		//Initializes a broadphase or narrowphase BCP collider
 		static Collider_BCP* Initialize(
 			u32 parentRigidBody,
@@ -41,6 +57,18 @@ namespace KalaPhysics::Physics::Collision
 			f32 radius,
 			ColliderType type);
 
+		//Initializes one BCP collider per desc and appends them to outColliders,
+		//every storage grows once up front and only a summary is logged
+		static void CreateMany(
+			span<const Desc> descs,
+			vector<Collider_BCP*>& outColliders);
+
+		//BCP colliders are carved from a shared fixed-size block pool
+		static void* operator new(size_t size);
+		static void operator delete(
+			void* ptr,
+			size_t size);
+
 		const vec3& GetPos() const;
 		void SetPos(const vec3& newValue);
 
@@ -50,9 +78,27 @@ namespace KalaPhysics::Physics::Collision
 		f32 GetRadius() const;
 		void SetRadius(f32 newValue);
 
+		ColliderBounds GetBounds() const override;
+		void Translate(const vec3& delta) override;
+
+		//Support mapping of this shape for the GJK and EPA narrowphase
+		ConvexSupport GetSupport() const;
+
 		~Collider_BCP() override;
 	private:
-		void Update(Collider* c, f32 deltaTime) override;
+		void GetPose(
+			vec3& outPos,
+			quat& outRot) const override;
+		void SetPose(
+			const vec3& newPos,
+			const quat& newRot) override;
+		f32 GetMassProperties(
+			vec3& outCentroid,
+			vec3& outInertia) const override;
+
+		static Collider_BCP* Create(
+			const Desc& desc,
+			bool isQuiet);
 
 		vec3 pos{};
 		f32 height{};
@@ -14,6 +14,11 @@ namespace KalaPhysics::Core
 	class PhysicsWorld;
 }
 
+namespace KalaPhysics::Physics::Collision
+{
+	class Narrowphase;
+}
+
 namespace KalaPhysics::Physics::Collision
 {
 	using KalaHeaders::KalaMath::kclamp;
@@ -32,22 +37,61 @@ namespace KalaPhysics::Physics::Collision
 	class LIB_API Collider_BSP : public Collider
 	{
 		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class Narrowphase;
 	public:
+		//Creation parameters of one BSP collider for CreateMany
+		struct Desc
+		{
+			u32 parentRigidBody{};
+			vec3 center{};
+			f32 radius{};
+		};
+
 		//Initializes a broadphase-only BSP collider
 		static Collider_BSP* Initialize(
 			u32 parentRigidBody,
 			const vec3& center,
 			f32 radius);
 
+		//Initializes one BSP collider per desc and appends them to outColliders,
+		//every storage grows once up front and only a summary is logged
+		static void CreateMany(
+			span<const Desc> descs,
+			vector<Collider_BSP*>& outColliders);
+
+		//BSP colliders are carved from a shared fixed-size block pool
+		static void* operator new(size_t size);
+		static void operator delete(
+			void* ptr,
+			size_t size);
+
 		const vec3& GetCenter() const;
 		void SetCenter(const vec3& newValue);
 
 		f32 GetRadius() const;
 		void SetRadius(f32 newValue);
 
+		ColliderBounds GetBounds() const override;
+		void Translate(const vec3& delta) override;
+
+		//Support mapping of this shape for the GJK and EPA narrowphase
+		ConvexSupport GetSupport() const;
+
 		~Collider_BSP() override;
 	private:
-		void Update(Collider* c, f32 deltaTime) override;
+		void GetPose(
+			vec3& outPos,
+			quat& outRot) const override;
+		void SetPose(
+			const vec3& newPos,
+			const quat& newRot) override;
+		f32 GetMassProperties(
+			vec3& outCentroid,
+			vec3& outInertia) const override;
+
+		static Collider_BSP* Create(
+			const Desc& desc,
+			bool isQuiet);
 
 		vec3 center{};
 		f32 radius{};
@@ -14,6 +14,11 @@ namespace KalaPhysics::Core
 	class PhysicsWorld;
 }
 
+namespace KalaPhysics::Physics::Collision
+{
+	class Narrowphase;
+}
+
 namespace KalaPhysics::Physics::Collision
 {
 	using KalaHeaders::KalaMath::kclamp;
@@ -33,7 +38,19 @@ namespace KalaPhysics::Physics::Collision
 	class LIB_API Collider_KDOP : public Collider
 	{
 		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class Narrowphase;
 	public:
+		//Creation parameters of one KDOP collider for CreateMany,
+		//vertices are copied so they only need to outlive the call
+		struct Desc
+		{
+			u32 parentRigidBody{};
+			vec3 pos{};
+			quat rot{};
+			span<const vec3> vertices{};
+			KDOPShape shape{};
+		};
+
 		//Initializes a broadphase-only KDOP collider
 		static Collider_KDOP* Initialize(
 			u32 parentRigidBody,
@@ -42,25 +59,51 @@ namespace KalaPhysics::Physics::Collision
 			const vector<vec3>& vertices,
 			KDOPShape shape);
 
+		//Initializes one KDOP collider per desc and appends them to outColliders,
+		//every storage grows once up front and only a summary is logged
+		static void CreateMany(
+			span<const Desc> descs,
+			vector<Collider_KDOP*>& outColliders);
+
+		//KDOP colliders are carved from a shared fixed-size block pool
+		static void* operator new(size_t size);
+		static void operator delete(
+			void* ptr,
+			size_t size);
+
 		const vec3& GetPos() const;
 		void SetPos(const vec3& newValue);
 
 		const quat& GetRot() const;
 		void SetRot(const quat& newValue);
 
-		const vector<vec3>& GetVertices() const;
-
 		KDOPShape GetKDOPShape() const;
 
+		ColliderBounds GetBounds() const override;
+		void Translate(const vec3& delta) override;
+
+		//Support mapping of this shape for the GJK and EPA narrowphase
+		ConvexSupport GetSupport() const;
+
 		~Collider_KDOP() override;
 	private:
-		void Update(Collider* c, f32 deltaTime) override;
+		void GetPose(
+			vec3& outPos,
+			quat& outRot) const override;
+		void SetPose(
+			const vec3& newPos,
+			const quat& newRot) override;
+		f32 GetMassProperties(
+			vec3& outCentroid,
+			vec3& outInertia) const override;
+
+		static Collider_KDOP* Create(
+			const Desc& desc,
+			bool isQuiet);
 
 		vec3 pos{};
 		quat rot{};
 
-		vector<vec3> vertices{};
-
 		KDOPShape kdopShape{};
 	};
 }
\ No newline at end of file
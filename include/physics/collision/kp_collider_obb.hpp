@@ -14,6 +14,11 @@ namespace KalaPhysics::Core
 	class PhysicsWorld;
 }
 
+namespace KalaPhysics::Physics::Collision
+{
+	class Narrowphase;
+}
+
 namespace KalaPhysics::Physics::Collision
 {
 	using KalaHeaders::KalaMath::kclamp;
@@ -28,7 +33,18 @@ namespace KalaPhysics::Physics::Collision
 	class LIB_API Collider_OBB : public Collider
 	{
 		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class Narrowphase;
 	public:
+		//Creation parameters of one OBB collider for CreateMany
+		struct Desc
+		{
+			u32 parentRigidBody{};
+			vec3 pos{};
+			quat rot{};
+			vec3 halfExtents{};
+			ColliderType type{};
+		};
+
 		//Initializes a broadphase or narrowphase OBB collider
 		static Collider_OBB* Initialize(
 			u32 parentRigidBody,
@@ -37,6 +53,18 @@ namespace KalaPhysics::Physics::Collision
 			const vec3& halfExtents,
 			ColliderType type);
 
+		//Initializes one OBB collider per desc and appends them to outColliders,
+		//every storage grows once up front and only a summary is logged
+		static void CreateMany(
+			span<const Desc> descs,
+			vector<Collider_OBB*>& outColliders);
+
+		//OBB colliders are carved from a shared fixed-size block pool
+		static void* operator new(size_t size);
+		static void operator delete(
+			void* ptr,
+			size_t size);
+
 		const vec3& GetPos() const;
 		void SetPos(const vec3& newValue);
 
@@ -46,9 +74,27 @@ namespace KalaPhysics::Physics::Collision
 		const vec3& GetHalfExtents() const;
 		void SetHalfExtents(const vec3& newValue);
 
+		ColliderBounds GetBounds() const override;
+		void Translate(const vec3& delta) override;
+
+		//Support mapping of this shape for the GJK and EPA narrowphase
+		ConvexSupport GetSupport() const;
+
 		~Collider_OBB() override;
 	private:
-		void Update(Collider* c, f32 deltaTime) override;
+		void GetPose(
+			vec3& outPos,
+			quat& outRot) const override;
+		void SetPose(
+			const vec3& newPos,
+			const quat& newRot) override;
+		f32 GetMassProperties(
+			vec3& outCentroid,
+			vec3& outInertia) const override;
+
+		static Collider_OBB* Create(
+			const Desc& desc,
+			bool isQuiet);
 
 		vec3 pos{};
 		quat rot{};
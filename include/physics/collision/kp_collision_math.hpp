@@ -0,0 +1,203 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+#include "core_utils.hpp"
+#include "math_utils.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::fabs;
+	using std::sqrt;
+	using std::fmin;
+	using std::fmax;
+
+	using KalaHeaders::KalaMath::vec3;
+	using KalaHeaders::KalaMath::quat;
+
+	//
+	// SMALL VECTOR HELPERS SHARED BY THE COLLISION PIPELINE
+	//
+	// These are prefixed with 'v' so they never clash with
+	// the KalaMath equivalents found through argument-dependent lookup.
+	//
+
+	inline f32 vdot(const vec3& a, const vec3& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+	inline vec3 vcross(const vec3& a, const vec3& b)
+	{
+		return vec3(
+			a.y * b.z - a.z * b.y,
+			a.z * b.x - a.x * b.z,
+			a.x * b.y - a.y * b.x);
+	}
+	inline f32 vlength2(const vec3& a) { return vdot(a, a); }
+	inline f32 vlength(const vec3& a) { return sqrt(vdot(a, a)); }
+	inline vec3 vnormalize(const vec3& a)
+	{
+		f32 len = vlength(a);
+		return len > 1e-12f ? a * (1.0f / len) : vec3(0.0f);
+	}
+
+	//Scalar min and max that compile to a single minss and maxss instead of fminf and fmaxf calls.
+	//Unlike fmin and fmax they return b if either side is NaN, the same as the sse kernels
+	inline f32 vminf(f32 a, f32 b) { return a < b ? a : b; }
+	inline f32 vmaxf(f32 a, f32 b) { return a > b ? a : b; }
+
+	inline vec3 vmin(const vec3& a, const vec3& b)
+	{
+		return vec3(fmin(a.x, b.x), fmin(a.y, b.y), fmin(a.z, b.z));
+	}
+	inline vec3 vmax(const vec3& a, const vec3& b)
+	{
+		return vec3(fmax(a.x, b.x), fmax(a.y, b.y), fmax(a.z, b.z));
+	}
+	inline vec3 vabs(const vec3& a)
+	{
+		return vec3(fabs(a.x), fabs(a.y), fabs(a.z));
+	}
+	inline vec3 vmul(const vec3& a, const vec3& b)
+	{
+		return vec3(a.x * b.x, a.y * b.y, a.z * b.z);
+	}
+	inline f32 vcomp(const vec3& a, u8 axis)
+	{
+		return axis == 0 ? a.x : (axis == 1 ? a.y : a.z);
+	}
+
+	//Rotates v by the unit quaternion q
+	inline vec3 vrotate(const quat& q, const vec3& v)
+	{
+		vec3 u(q.x, q.y, q.z);
+		vec3 t = vcross(u, v) * 2.0f;
+		return v + t * q.w + vcross(u, t);
+	}
+	//Rotates v by the inverse of the unit quaternion q
+	inline vec3 vrotate_inv(const quat& q, const vec3& v)
+	{
+		vec3 u(-q.x, -q.y, -q.z);
+		vec3 t = vcross(u, v) * 2.0f;
+		return v + t * q.w + vcross(u, t);
+	}
+
+	//Product of two quaternions, rotates by b first and by a second
+	inline quat qmul(const quat& a, const quat& b)
+	{
+		quat q{};
+		q.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+		q.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+		q.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+		q.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+		return q;
+	}
+	//Product of the inverse of the unit quaternion a with b, the rotation b relative to a
+	inline quat qmul_inv(const quat& a, const quat& b)
+	{
+		quat inv{};
+		inv.w = a.w;
+		inv.x = -a.x;
+		inv.y = -a.y;
+		inv.z = -a.z;
+		return qmul(inv, b);
+	}
+
+	//Principal moments of inertia of a solid box per unit mass around its center
+	inline vec3 vbox_inertia(const vec3& halfExtents)
+	{
+		vec3 h2 = vmul(halfExtents, halfExtents);
+		return vec3(h2.y + h2.z, h2.x + h2.z, h2.x + h2.y) * (1.0f / 3.0f);
+	}
+
+	//Fills the three world-space basis axes of the unit quaternion q
+	inline void vbasis(
+		const quat& q,
+		vec3& outX,
+		vec3& outY,
+		vec3& outZ)
+	{
+		outX = vrotate(q, vec3(1.0f, 0.0f, 0.0f));
+		outY = vrotate(q, vec3(0.0f, 1.0f, 0.0f));
+		outZ = vrotate(q, vec3(0.0f, 0.0f, 1.0f));
+	}
+
+	//Fills two unit tangents perpendicular to the unit normal n and to each other,
+	//the same normal always gives the same tangents so impulses along them can be carried across frames
+	inline void vtangents(
+		const vec3& n,
+		vec3& outT1,
+		vec3& outT2)
+	{
+		outT1 = fabs(n.x) >= 0.57735f
+			? vnormalize(vec3(n.y, -n.x, 0.0f))
+			: vnormalize(vec3(0.0f, n.z, -n.y));
+		outT2 = vcross(n, outT1);
+	}
+
+	//World-space axis-aligned bounds used by the broadphase and scene queries
+	struct LIB_API ColliderBounds
+	{
+		vec3 min{};
+		vec3 max{};
+
+		inline bool Overlaps(const ColliderBounds& o) const
+		{
+			return min.x <= o.max.x && max.x >= o.min.x
+				&& min.y <= o.max.y && max.y >= o.min.y
+				&& min.z <= o.max.z && max.z >= o.min.z;
+		}
+		inline bool Contains(const ColliderBounds& o) const
+		{
+			return min.x <= o.min.x && min.y <= o.min.y && min.z <= o.min.z
+				&& max.x >= o.max.x && max.y >= o.max.y && max.z >= o.max.z;
+		}
+
+		inline ColliderBounds Merged(const ColliderBounds& o) const
+		{
+			return { vmin(min, o.min), vmax(max, o.max) };
+		}
+		inline ColliderBounds Expanded(f32 margin) const
+		{
+			return { min - vec3(margin), max + vec3(margin) };
+		}
+
+		//Slab test against the precomputed inverse ray direction, outNear is the entry distance
+		//or 0 if the origin is inside. Returns false if the ray misses or only enters past maxDistance
+		inline bool IntersectsRay(
+			const vec3& origin,
+			const vec3& invDirection,
+			f32 maxDistance,
+			f32& outNear) const
+		{
+			f32 tx1 = (min.x - origin.x) * invDirection.x;
+			f32 tx2 = (max.x - origin.x) * invDirection.x;
+			f32 ty1 = (min.y - origin.y) * invDirection.y;
+			f32 ty2 = (max.y - origin.y) * invDirection.y;
+			f32 tz1 = (min.z - origin.z) * invDirection.z;
+			f32 tz2 = (max.z - origin.z) * invDirection.z;
+
+			f32 tNear = vmaxf(vmaxf(vminf(tx1, tx2), vminf(ty1, ty2)), vmaxf(vminf(tz1, tz2), 0.0f));
+			f32 tFar = vminf(vminf(vmaxf(tx1, tx2), vmaxf(ty1, ty2)), vminf(vmaxf(tz1, tz2), maxDistance));
+
+			outNear = tNear;
+			return tNear <= tFar;
+		}
+
+		inline vec3 GetCenter() const { return (min + max) * 0.5f; }
+		inline vec3 GetExtents() const { return (max - min) * 0.5f; }
+
+		//Half of the surface area, enough for comparing tree costs
+		inline f32 GetPerimeter() const
+		{
+			vec3 d = max - min;
+			return d.x * d.y + d.y * d.z + d.z * d.x;
+		}
+	};
+}
\ No newline at end of file
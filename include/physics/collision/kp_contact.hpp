@@ -0,0 +1,94 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <array>
+
+#include "core_utils.hpp"
+#include "math_utils.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::array;
+
+	using u8 = uint8_t;
+
+	using KalaHeaders::KalaMath::vec3;
+	using KalaHeaders::KalaMath::quat;
+
+	class Collider;
+
+	//Max contact points kept per colliding pair
+	constexpr u8 MAX_CONTACT_POINTS = 4;
+
+	struct LIB_API ContactPoint
+	{
+		vec3 position{}; //world-space point between both surfaces
+		f32 depth{};     //penetration depth along the manifold normal
+
+		//accumulated solver impulses, carried over from the matching point
+		//of the previous frame by the pair cache so the solver can warm start
+		f32 normalImpulse{};
+		array<f32, 2> tangentImpulse{};
+	};
+
+	struct LIB_API ContactManifold
+	{
+		Collider* a{};
+		Collider* b{};
+
+		//world-space normal pointing from a towards b
+		vec3 normal{};
+
+		array<ContactPoint, MAX_CONTACT_POINTS> points{};
+		u8 pointCount{};
+	};
+
+	//
+	// SHARED CONTACT GENERATORS
+	//
+	// All of these write a manifold whose normal points from the first shape to the second
+	// and return false without touching the manifold if the shapes are apart.
+	//
+
+	LIB_API bool CollideSpheres(
+		const vec3& centerA,
+		f32 radiusA,
+		const vec3& centerB,
+		f32 radiusB,
+		ContactManifold& outManifold);
+
+	LIB_API bool CollideSphereBox(
+		const vec3& center,
+		f32 radius,
+		const vec3& boxMin,
+		const vec3& boxMax,
+		ContactManifold& outManifold);
+
+	LIB_API bool CollideBoxes(
+		const vec3& minA,
+		const vec3& maxA,
+		const vec3& minB,
+		const vec3& maxB,
+		ContactManifold& outManifold);
+
+	//Separating axis test over the 15 box axes followed by reference face clipping,
+	//produces up to MAX_CONTACT_POINTS points for resting boxes.
+	//inOutAxis is tested before the 15 axes so a pair that stayed apart exits after one test,
+	//it receives the separating axis or the reverse contact normal for the next frame
+	LIB_API bool CollideOrientedBoxes(
+		const vec3& centerA,
+		const quat& rotA,
+		const vec3& halfA,
+		const vec3& centerB,
+		const quat& rotB,
+		const vec3& halfB,
+		vec3& inOutAxis,
+		ContactManifold& outManifold);
+
+	//Swaps the roles of both shapes in a manifold by flipping its normal
+	LIB_API void FlipManifold(ContactManifold& manifold);
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+
+#include "core_utils.hpp"
+
+#include "physics/collision/kp_collision_math.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+
+	using i32 = int32_t;
+	using u32 = uint32_t;
+
+	class Collider;
+
+	constexpr i32 NULL_NODE = -1;
+
+	//Max depth of the traversal stack used by queries,
+	//the tree is height-balanced so this is never reached in practice
+	constexpr i32 MAX_TREE_STACK = 256;
+
+	struct LIB_API DynamicTreeNode
+	{
+		//fat bounds for leaves, union of both children for branches
+		ColliderBounds bounds{};
+
+		//only set for leaves
+		Collider* collider{};
+
+		//layer bit of the leaf collider, union of both children for branches
+		u32 mask{};
+
+		//doubles as the next free node while this node is in the free list
+		i32 parent = NULL_NODE;
+		i32 child1 = NULL_NODE;
+		i32 child2 = NULL_NODE;
+
+		//0 for leaves, -1 for free nodes
+		i32 height = -1;
+
+		inline bool IsLeaf() const { return child1 == NULL_NODE; }
+	};
+
+	//Incrementally updated bounding volume hierarchy of fat AABBs.
+	//Leaves are only reinserted when the tight bounds escape the fat bounds,
+	//so slowly moving colliders cost nothing after their first frame
+	class LIB_API DynamicTree
+	{
+	public:
+		//Inserts a new leaf and returns its proxy ID
+		i32 CreateProxy(
+			const ColliderBounds& fatBounds,
+			Collider* collider,
+			u32 mask);
+		//Removes an existing leaf
+		void DestroyProxy(i32 proxyID);
+
+		//Refits the leaf if the tight bounds are no longer contained by the fat bounds,
+		//returns true if the leaf was reinserted
+		bool MoveProxy(
+			i32 proxyID,
+			const ColliderBounds& tightBounds,
+			f32 margin);
+
+		//Replaces the layer mask of the leaf and its ancestors if it changed
+		void SetProxyMask(
+			i32 proxyID,
+			u32 mask);
+
+		//Returns true if the proxy ID points to a live leaf
+		bool IsValidProxy(i32 proxyID) const;
+
+		Collider* GetCollider(i32 proxyID) const;
+		const ColliderBounds& GetFatBounds(i32 proxyID) const;
+
+		i32 GetRoot() const;
+		const vector<DynamicTreeNode>& GetNodes() const;
+
+		u32 GetProxyCount() const;
+		i32 GetHeight() const;
+
+		//Removes all nodes but keeps the allocated node storage
+		void Clear();
+
+		//Calls 'callback(i32 proxyID)' for every leaf whose fat bounds overlap the passed bounds,
+		//return false from the callback to stop the query early
+		template<typename F>
+		inline void Query(
+			const ColliderBounds& bounds,
+			F&& callback) const
+		{
+			if (root == NULL_NODE) return;
+
+			i32 stack[MAX_TREE_STACK];
+			i32 count = 0;
+			stack[count++] = root;
+
+			while (count > 0)
+			{
+				const DynamicTreeNode& node = nodes[stack[--count]];
+
+				if (!node.bounds.Overlaps(bounds)) continue;
+
+				if (node.IsLeaf())
+				{
+					if (!callback(scast<i32>(&node - nodes.data()))) return;
+				}
+				else if (count + 2 <= MAX_TREE_STACK)
+				{
+					stack[count++] = node.child1;
+					stack[count++] = node.child2;
+				}
+			}
+		}
+
+		//Query that also skips every subtree whose layer mask shares no bit with mask
+		template<typename F>
+		inline void Query(
+			const ColliderBounds& bounds,
+			u32 mask,
+			F&& callback) const
+		{
+			if (root == NULL_NODE) return;
+
+			i32 stack[MAX_TREE_STACK];
+			i32 count = 0;
+			stack[count++] = root;
+
+			while (count > 0)
+			{
+				const DynamicTreeNode& node = nodes[stack[--count]];
+
+				if (!(node.mask & mask)
+					|| !node.bounds.Overlaps(bounds))
+				{
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					if (!callback(scast<i32>(&node - nodes.data()))) return;
+				}
+				else if (count + 2 <= MAX_TREE_STACK)
+				{
+					stack[count++] = node.child1;
+					stack[count++] = node.child2;
+				}
+			}
+		}
+	private:
+		i32 AllocateNode();
+		void FreeNode(i32 nodeID);
+
+		void InsertLeaf(i32 leaf);
+		void RemoveLeaf(i32 leaf);
+
+		//AVL-style rotation, returns the new root of the rotated subtree
+		i32 Balance(i32 nodeID);
+
+		vector<DynamicTreeNode> nodes{};
+
+		i32 root = NULL_NODE;
+		i32 freeList = NULL_NODE;
+
+		u32 proxyCount{};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <span>
+
+#include "core_utils.hpp"
+#include "math_utils.hpp"
+
+#include "physics/collision/kp_contact.hpp"
+#include "physics/collision/kp_collision_math.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+	using std::span;
+
+	using u8 = uint8_t;
+	using u32 = uint32_t;
+
+	using KalaHeaders::KalaMath::vec3;
+	using KalaHeaders::KalaMath::quat;
+
+	class Collider;
+
+	//Iteration cap of a single GJK query, coherent frames converge in a few
+	constexpr u32 GJK_MAX_ITERATIONS = 32;
+	//Relative tolerance GJK stops at once the distance estimate can't improve further
+	constexpr f32 GJK_TOLERANCE = 1e-5f;
+
+	//Iteration cap of a single EPA query
+	constexpr u32 EPA_MAX_ITERATIONS = 48;
+	//EPA stops once a new support point lies this close to the nearest face
+	constexpr f32 EPA_TOLERANCE = 1e-4f;
+	//Polytope capacity of a single EPA query, queries running out of room
+	//return the best face found so far
+	constexpr u32 EPA_MAX_VERTICES = 64;
+	constexpr u32 EPA_MAX_FACES = 128;
+
+	//Iteration cap of a single conservative advancement cast
+	constexpr u32 CONVEX_CAST_MAX_ITERATIONS = 20;
+
+	//Point clouds with at least this many vertices use hill climbing over
+	//hull adjacency, smaller clouds are faster to scan linearly
+	constexpr u32 HULL_HILL_CLIMB_MIN_VERTICES = 16;
+
+	enum class SupportKind : u8
+	{
+		SUPPORT_POINT = 0,   //single point, spheres are a point with a radius
+		SUPPORT_BOX = 1,     //box of halfExtents around pos, rotated by rot
+		SUPPORT_SEGMENT = 2, //local Y segment of halfHeight around pos, capsules add a radius
+		SUPPORT_POINTS = 3   //local-space point cloud rotated by rot and offset by pos
+	};
+
+	enum class ConvexCastResult : u8
+	{
+		CAST_MISS = 0,       //the shapes stay apart over the whole motion
+		CAST_HIT = 1,        //the moving shape reaches the target separation within the motion
+		CAST_OVERLAPPING = 2 //the shapes already overlap before moving
+	};
+
+	//Support mapping of one convex shape for GJK and EPA.
+	//Shapes are described by a core and a radius, queries run on the cores
+	//and only fall back to the full shapes once the cores overlap.
+	//Built on the stack per query, the hill climbing hint makes it single-threaded
+	struct LIB_API ConvexSupport
+	{
+		SupportKind kind{};
+
+		vec3 pos{};
+		quat rot{};
+		bool isRotated{};
+
+		vec3 halfExtents{};
+		f32 halfHeight{};
+		f32 radius{};
+
+		const vec3* vertices{};
+		u32 vertexCount{};
+
+		//hull adjacency in compressed rows, vertex i neighbours
+		//adjacency[adjacencyStart[i]] up to adjacency[adjacencyStart[i + 1]]
+		const u32* adjacencyStart{};
+		const u32* adjacency{};
+
+		//hull vertex the next hill climb starts from
+		mutable u32 hint{};
+
+		//Furthest point of the core in direction dir, in world space
+		vec3 Support(const vec3& dir) const;
+	};
+
+	//Closest points or deepest penetration between two convex shapes,
+	//the normal always points from a towards b
+	struct LIB_API ConvexResult
+	{
+		bool isTouching{};
+
+		vec3 pointA{};
+		vec3 pointB{};
+		vec3 normal{};
+
+		f32 distance{}; //surface distance, negative while penetrating
+	};
+
+	//Support mapping of any collider, for queries that don't know the shape at compile time
+	LIB_API ConvexSupport GetColliderSupport(const Collider* c);
+
+	//Runs GJK on the cores of both shapes and EPA if the cores overlap.
+	//inOutAxis seeds the first search direction and receives the final one,
+	//keep it per pair across frames so coherent frames converge in one or two iterations.
+	//Returns false if the shapes are further than their radii apart
+	LIB_API bool ConvexQuery(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		vec3& inOutAxis,
+		ConvexResult& outResult);
+
+	//Conservative advancement of a translating shape against a stationary one,
+	//a is moved by motion until it is separation away from b. outTime is the fraction of motion
+	//travelled and outNormal points from a towards b at that time
+	LIB_API ConvexCastResult ConvexCast(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		const vec3& motion,
+		f32 separation,
+		f32 tolerance,
+		f32& outTime,
+		vec3& outNormal);
+
+	//ConvexQuery as a single-point manifold, writes nothing if the shapes are apart
+	LIB_API bool CollideConvex(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		vec3& inOutAxis,
+		ContactManifold& outManifold);
+
+	//Builds the convex hull of points and returns its edge graph in compressed rows,
+	//interior points get no neighbours. Returns the first hull vertex to start hill climbing from,
+	//or the vertex count if the points are too flat for a hull and have to be scanned linearly
+	LIB_API u32 BuildHullAdjacency(
+		span<const vec3> points,
+		vector<u32>& outStart,
+		vector<u32>& outAdjacency);
+}
\ No newline at end of file
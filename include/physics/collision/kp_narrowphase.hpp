@@ -0,0 +1,78 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "core_utils.hpp"
+
+#include "physics/collision/kp_contact.hpp"
+#include "physics/collision/kp_broadphase.hpp"
+
+namespace KalaPhysics::Core
+{
+	class PhysicsWorld;
+}
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+
+	using u8 = uint8_t;
+	using u32 = uint32_t;
+
+	enum class ColliderShape : u8;
+
+	//Contacts and separating axes produced by one narrowphase job
+	struct NarrowphaseChunkOutput;
+
+	//Pairs handed to a single job, small enough to balance uneven pair costs
+	//and large enough to keep the scheduling overhead low
+	constexpr u32 NARROWPHASE_CHUNK_SIZE = 64;
+
+	//Count of ColliderShape values, the dispatch table has one entry per shape pair
+	constexpr u8 COLLIDER_SHAPE_COUNT = 10;
+
+	class LIB_API Narrowphase
+	{
+		friend class KalaPhysics::Core::PhysicsWorld;
+	public:
+		//Returns the contacts of the last narrowphase update grouped by shape pair,
+		//within a group contacts keep broadphase pair order regardless of how many threads ran it
+		static const vector<ContactManifold>& GetContacts();
+	private:
+		//Tests a run of pairs that all share the same two shapes
+		using BucketFunc = void(*)(
+			const ColliderPair* pairs,
+			u32 count,
+			NarrowphaseChunkOutput& out);
+
+		//Groups pairs by shape pair, then tests every group in parallel chunks on the job system
+		//and merges the per-chunk contact buffers in chunk order
+		static void Update(const vector<ColliderPair>& pairs);
+
+		//Contact routine of one concrete shape pair, GJK and EPA unless the pair has an analytic specialization.
+		//inOutAxis is the separating axis of the pair from the previous frame, zero for new pairs
+		template<typename A, typename B>
+		static bool CollidePair(
+			const A& a,
+			const B& b,
+			vec3& inOutAxis,
+			ContactManifold& outManifold);
+
+		//Tight loop over one group with both shapes known at compile time
+		template<ColliderShape SA, ColliderShape SB>
+		static void CollideBucket(
+			const ColliderPair* pairs,
+			u32 count,
+			NarrowphaseChunkOutput& out);
+
+		//Dispatch table entry for shape pair index I
+		template<size_t I>
+		static constexpr BucketFunc MakeBucketEntry();
+	};
+}
\ No newline at end of file
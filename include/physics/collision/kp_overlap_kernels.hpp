@@ -0,0 +1,195 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+
+#include "core_utils.hpp"
+
+#include "physics/collision/kp_collision_math.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+
+	using u8 = uint8_t;
+	using u32 = uint32_t;
+
+	//Rays per packet, one AVX2 step or two SSE2 steps
+	constexpr u32 RAY_PACKET_SIZE = 8;
+	//Boxes OverlapAABBBlock tests at once, one AVX2 step or two SSE2 steps
+	constexpr u32 OVERLAP_BLOCK_SIZE = 8;
+
+	enum class SimdLevel : u8
+	{
+		SIMD_SCALAR = 0, //one collider per step, always available
+		SIMD_SSE2 = 1,   //4 colliders per step
+		SIMD_AVX2 = 2    //8 colliders per step
+	};
+
+	//Bounds of many colliders packed as one array per component
+	struct LIB_API PackedBounds
+	{
+		vector<f32> minX{};
+		vector<f32> minY{};
+		vector<f32> minZ{};
+		vector<f32> maxX{};
+		vector<f32> maxY{};
+		vector<f32> maxZ{};
+
+		inline u32 GetCount() const { return scast<u32>(minX.size()); }
+
+		inline void Push(const ColliderBounds& b)
+		{
+			minX.push_back(b.min.x);
+			minY.push_back(b.min.y);
+			minZ.push_back(b.min.z);
+			maxX.push_back(b.max.x);
+			maxY.push_back(b.max.y);
+			maxZ.push_back(b.max.z);
+		}
+		inline void Set(
+			u32 index,
+			const ColliderBounds& b)
+		{
+			minX[index] = b.min.x;
+			minY[index] = b.min.y;
+			minZ[index] = b.min.z;
+			maxX[index] = b.max.x;
+			maxY[index] = b.max.y;
+			maxZ[index] = b.max.z;
+		}
+		//Pushes inverted bounds that never overlap anything, keeps indices of dead slots aligned
+		inline void PushEmpty()
+		{
+			minX.push_back(1e30f);
+			minY.push_back(1e30f);
+			minZ.push_back(1e30f);
+			maxX.push_back(-1e30f);
+			maxY.push_back(-1e30f);
+			maxZ.push_back(-1e30f);
+		}
+		inline void Clear()
+		{
+			minX.clear();
+			minY.clear();
+			minZ.clear();
+			maxX.clear();
+			maxY.clear();
+			maxZ.clear();
+		}
+	};
+
+	//Spheres of many colliders packed as one array per component
+	struct LIB_API PackedSpheres
+	{
+		vector<f32> x{};
+		vector<f32> y{};
+		vector<f32> z{};
+		vector<f32> radius{};
+
+		inline u32 GetCount() const { return scast<u32>(x.size()); }
+
+		inline void Push(
+			const vec3& center,
+			f32 r)
+		{
+			x.push_back(center.x);
+			y.push_back(center.y);
+			z.push_back(center.z);
+			radius.push_back(r);
+		}
+		//Pushes a far away point that never overlaps anything, keeps indices of non-sphere slots aligned
+		inline void PushEmpty()
+		{
+			x.push_back(1e30f);
+			y.push_back(1e30f);
+			z.push_back(1e30f);
+			radius.push_back(0.0f);
+		}
+		inline void Clear()
+		{
+			x.clear();
+			y.clear();
+			z.clear();
+			radius.clear();
+		}
+	};
+
+	//Rays traced together, packed as one array per component.
+	//Lanes with a negative max distance never hit anything, so unused and finished lanes
+	//stay in the packet without branching
+	struct LIB_API RayPacket
+	{
+		alignas(32) f32 originX[RAY_PACKET_SIZE]{};
+		alignas(32) f32 originY[RAY_PACKET_SIZE]{};
+		alignas(32) f32 originZ[RAY_PACKET_SIZE]{};
+		alignas(32) f32 invDirectionX[RAY_PACKET_SIZE]{};
+		alignas(32) f32 invDirectionY[RAY_PACKET_SIZE]{};
+		alignas(32) f32 invDirectionZ[RAY_PACKET_SIZE]{};
+		alignas(32) f32 maxDistance[RAY_PACKET_SIZE]{};
+	};
+
+	//Tests one shape or ray packet against a packed batch of others, 4 or 8 at a time.
+	//The instruction set is picked once from the cpu features at startup,
+	//every level performs the same float operations in the same order
+	//so all of them return exactly the same indices on every machine
+	class LIB_API OverlapKernels
+	{
+	public:
+		//Best level supported by this cpu
+		static SimdLevel GetSupportedLevel();
+
+		static SimdLevel GetLevel();
+		//Force a lower level, for example to compare results against the scalar path,
+		//levels above the supported level are clamped down
+		static void SetLevel(SimdLevel newValue);
+
+		//Appends the index of every box in [begin, end) that overlaps the query box,
+		//touching boxes count as overlapping just like ColliderBounds::Overlaps
+		static void OverlapAABB(
+			const ColliderBounds& query,
+			const PackedBounds& batch,
+			u32 begin,
+			u32 end,
+			vector<u32>& outIndices);
+
+		//Appends the index of every sphere in [begin, end) that overlaps the query sphere,
+		//touching spheres count as overlapping
+		static void OverlapSphere(
+			const vec3& center,
+			f32 radius,
+			const PackedSpheres& batch,
+			u32 begin,
+			u32 end,
+			vector<u32>& outIndices);
+
+		//Appends the index of every box in [begin, end) that overlaps the query sphere,
+		//touching counts as overlapping
+		static void OverlapSphereAABB(
+			const vec3& center,
+			f32 radius,
+			const PackedBounds& batch,
+			u32 begin,
+			u32 end,
+			vector<u32>& outIndices);
+
+		//Tests the OVERLAP_BLOCK_SIZE boxes from begin on against the query box in one step
+		//and returns one bit per overlapping box, same rules as OverlapAABB.
+		//batch has to hold that many boxes from begin on, pad its end with PushEmpty
+		static u32 OverlapAABBBlock(
+			const ColliderBounds& query,
+			const PackedBounds& batch,
+			u32 begin);
+
+		//Slab test of one box against every lane of a ray packet, same rules as ColliderBounds::IntersectsRay.
+		//Returns one bit per lane that reaches the box and writes the entry distance of every lane to outNear
+		static u32 IntersectRayPacket(
+			const ColliderBounds& box,
+			const RayPacket& packet,
+			f32* outNear);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+
+#include "core_utils.hpp"
+
+#include "physics/collision/kp_contact.hpp"
+
+namespace KalaPhysics::Core
+{
+	class PhysicsWorld;
+}
+
+namespace KalaPhysics::Physics
+{
+	class ContactSolver;
+}
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+
+	using u32 = uint32_t;
+	using u64 = uint64_t;
+
+	//New contact points within this distance of a point from the previous frame
+	//are treated as the same point and inherit its accumulated impulses
+	constexpr f32 PAIR_CACHE_MATCH_DISTANCE = 0.05f;
+
+	//Persistent overlapping pair cache, keyed by the collider IDs of both sides.
+	//Every narrowphase update is merged into the cache, pairs that keep touching inherit the impulses
+	//of their previous manifold point by point, pairs that stopped touching are dropped.
+	//Keys are built from generational IDs so a removed collider can never match a new one
+	class LIB_API PairCache
+	{
+		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class KalaPhysics::Physics::ContactSolver;
+	public:
+		//Returns the manifolds of the last update, one per touching pair
+		static const vector<ContactManifold>& GetManifolds();
+
+		//Returns the cached manifold of two colliders in either order, or nullptr if they are not touching
+		static const ContactManifold* Find(
+			u32 colliderA,
+			u32 colliderB);
+
+		static u32 GetPairCount();
+		//Pairs of the last update that were already touching the update before
+		static u32 GetPersistentCount();
+
+		//Forget every pair, the next update starts cold
+		static void Clear();
+	private:
+		//Merges fresh narrowphase contacts into the cache and evicts every pair missing from them
+		static void Update(const vector<ContactManifold>& contacts);
+
+		//Writable manifolds for the solver, impulses written here are warm start values next frame
+		static vector<ContactManifold>& GetMutableManifolds();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <span>
+#include <utility>
+
+#include "core_utils.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+	using std::span;
+
+	using u32 = uint32_t;
+	using i32 = int32_t;
+	using u64 = uint64_t;
+
+	//Order-independent key of two collider IDs, never 0 because registry IDs are never 0
+	inline u64 MakePairKey(
+		u32 a,
+		u32 b)
+	{
+		if (a > b) std::swap(a, b);
+
+		return (scast<u64>(a) << 32) | b;
+	}
+
+	//Open addressing lookup from pair keys to their index in a caller-owned array,
+	//rebuilt in one go whenever the array changes. Lookups are read-only
+	//so any number of threads can query the table between builds
+	class LIB_API PairTable
+	{
+	public:
+		//Maps every key to its index in keys, keys must be unique
+		void Build(span<const u64> keys);
+
+		//Returns the index key was built with, or -1
+		i32 Find(u64 key) const;
+
+		void Clear();
+	private:
+		//capacity is a power of two, empty slots hold key 0
+		vector<u64> slotKeys{};
+		vector<u32> slotIndices{};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include "core_utils.hpp"
+#include "math_utils.hpp"
+
+#include "physics/collision/kp_collision_math.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using KalaHeaders::KalaMath::vec3;
+	using KalaHeaders::KalaMath::quat;
+
+	class Collider;
+	struct ConvexSupport;
+
+	//Distance tolerance of rays against shapes without an analytic test
+	constexpr f32 RAYCAST_TOLERANCE = 1e-4f;
+	//Shallowest angle cosine at which the last tolerance gap is still stepped over,
+	//below it the hit stays where the advancement stopped
+	constexpr f32 RAYCAST_MIN_APPROACH = 0.01f;
+
+	//
+	// RAY PRIMITIVES
+	//
+	// All of these take a normalized direction and return the distance along the ray
+	// to the first surface point and the outward surface normal there.
+	// Origins inside the shape hit at distance 0 with the normal facing against the ray.
+	//
+
+	LIB_API bool RaycastSphere(
+		const vec3& center,
+		f32 radius,
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal);
+
+	//Slab test that also reports which face was entered
+	LIB_API bool RaycastBox(
+		const vec3& boxMin,
+		const vec3& boxMax,
+		const vec3& origin,
+		const vec3& invDirection,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal);
+
+	//RaycastBox in the local space of the box
+	LIB_API bool RaycastOrientedBox(
+		const vec3& center,
+		const quat& rot,
+		const vec3& halfExtents,
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal);
+
+	//Capsule along the world Y axis, halfHeight is half the length of the segment between both cap centers
+	LIB_API bool RaycastCapsule(
+		const vec3& center,
+		f32 halfHeight,
+		f32 radius,
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal);
+
+	//Conservative advancement of a point against any support mapping, used for point clouds
+	LIB_API bool RaycastConvex(
+		const ConvexSupport& shape,
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal);
+
+	//Dispatches to the primitive of the collider shape,
+	//invDirection is the precomputed 1 / direction shared by every slab test of one ray
+	LIB_API bool RaycastCollider(
+		const Collider* c,
+		const vec3& origin,
+		const vec3& direction,
+		const vec3& invDirection,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal);
+}
\ No newline at end of file
@@ -0,0 +1,310 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "core_utils.hpp"
+
+#include "physics/collision/kp_collision_math.hpp"
+#include "physics/collision/kp_overlap_kernels.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+	using std::floor;
+	using std::max;
+
+	using i32 = int32_t;
+	using u32 = uint32_t;
+	using u64 = uint64_t;
+
+	class Collider;
+
+	constexpr f32 DEFAULT_HASH_CELL_SIZE = 4.0f;
+	constexpr f32 MIN_HASH_CELL_SIZE = 0.01f;
+	constexpr f32 MAX_HASH_CELL_SIZE = 10000.0f;
+
+	//Colliders covering more cells than this skip the grid
+	//and are tested against every other collider instead
+	constexpr u32 MAX_CELLS_PER_PROXY = 64;
+
+	struct LIB_API SpatialHashStats
+	{
+		u32 tableCapacity{};      //slots in the open-addressing cell table
+		u32 occupiedCells{};      //cells holding at least one collider
+		u32 entryCount{};         //collider-to-cell entries
+		u32 maxCellOccupancy{};   //colliders in the fullest cell
+		u32 oversizedProxies{};   //colliders too large for the current cell size
+
+		f32 averageCellOccupancy{}; //entries per occupied cell
+		f32 averageProbeLength{};   //slots visited per cell lookup
+	};
+
+	//Hashed uniform grid for crowds of similarly sized colliders.
+	//The cell table is a flat open-addressing array that is reused across frames,
+	//stale cells are recognized by their frame stamp so the table is never cleared
+	class LIB_API SpatialHash
+	{
+	public:
+		void SetCellSize(f32 newValue);
+		f32 GetCellSize() const;
+
+		i32 CreateProxy(
+			const ColliderBounds& bounds,
+			Collider* collider);
+		void DestroyProxy(i32 proxyID);
+		void MoveProxy(
+			i32 proxyID,
+			const ColliderBounds& bounds);
+
+		bool IsValidProxy(i32 proxyID) const;
+		Collider* GetCollider(i32 proxyID) const;
+
+		u32 GetProxyCount() const;
+
+		//Returns cell occupancy of the last Build call
+		const SpatialHashStats& GetStats() const;
+
+		//Rebins every live proxy into the cell table
+		void Build();
+
+		//Calls 'callback(i32 proxyA, i32 proxyB)' once for every overlapping pair,
+		//Build must be called first
+		template<typename F>
+		inline void FindPairs(F&& callback) const
+		{
+			for (u32 slot : occupiedSlots)
+			{
+				const HashCell& cell = table[slot];
+
+				if (cell.sphereCount > 0)
+				{
+					FindCellPairsBatched(cell, callback);
+					continue;
+				}
+
+				for (u32 i = cell.head; i != NULL_ENTRY; i = entries[i].next)
+				{
+					i32 a = entries[i].proxy;
+					const ColliderBounds& ba = proxies[a].bounds;
+
+					for (u32 j = entries[i].next; j != NULL_ENTRY; j = entries[j].next)
+					{
+						i32 b = entries[j].proxy;
+						const ColliderBounds& bb = proxies[b].bounds;
+
+						if (!ba.Overlaps(bb)) continue;
+
+						ReportCellPair(cell, a, b, callback);
+					}
+				}
+			}
+
+			//oversized proxies are tested against everything else
+			for (i32 a : oversized)
+			{
+				batchHits.clear();
+				OverlapKernels::OverlapAABB(
+					proxies[a].bounds,
+					packed,
+					0,
+					packed.GetCount(),
+					batchHits);
+
+				for (u32 hit : batchHits)
+				{
+					i32 b = scast<i32>(hit);
+					if (b == a) continue;
+
+					//two oversized proxies would see each other twice
+					if (proxies[b].isOversized && b < a) continue;
+
+					if (a < b) callback(a, b);
+					else callback(b, a);
+				}
+			}
+		}
+
+		//Removes all proxies but keeps the allocated storage
+		void Clear();
+	private:
+		static constexpr u32 NULL_ENTRY = 0xFFFFFFFFu;
+
+		struct HashProxy
+		{
+			ColliderBounds bounds{};
+			Collider* collider{};
+
+			i32 nextFree = -1;
+
+			bool isAlive{};
+			bool isOversized{};
+			//spheres and capsules, tested through their bounding sphere
+			bool isSphere{};
+		};
+		struct HashCell
+		{
+			i32 x{};
+			i32 y{};
+			i32 z{};
+
+			//frame this cell was last written, older cells count as empty
+			u32 stamp{};
+
+			u32 head = NULL_ENTRY;
+			u32 count{};
+			u32 sphereCount{};
+		};
+		struct HashEntry
+		{
+			i32 proxy{};
+			u32 next = NULL_ENTRY;
+		};
+
+		inline i32 CellCoord(f32 v) const
+		{
+			return scast<i32>(floor(v * inverseCellSize));
+		}
+
+		//Bounding sphere of a sphere or capsule proxy, taken from its bounds.
+		//Capsules stay upright, so one fits in the sphere around its midpoint with its half height as radius
+		static inline void GetProxySphere(
+			const HashProxy& p,
+			vec3& outCenter,
+			f32& outRadius)
+		{
+			vec3 extents = (p.bounds.max - p.bounds.min) * 0.5f;
+
+			outCenter = p.bounds.min + extents;
+			outRadius = max(extents.x, max(extents.y, extents.z));
+		}
+
+		//a pair shares several cells, only the cell holding
+		//the min corner of their intersection reports it
+		template<typename F>
+		inline void ReportCellPair(
+			const HashCell& cell,
+			i32 a,
+			i32 b,
+			F& callback) const
+		{
+			vec3 corner = vmax(proxies[a].bounds.min, proxies[b].bounds.min);
+			if (CellCoord(corner.x) != cell.x
+				|| CellCoord(corner.y) != cell.y
+				|| CellCoord(corner.z) != cell.z)
+			{
+				return;
+			}
+
+			if (a < b) callback(a, b);
+			else callback(b, a);
+		}
+
+		//Cells holding spheres or capsules are packed with the spheres first,
+		//so each sphere runs one sphere-sphere batch over the later spheres
+		//and one sphere-box batch over the boxes, and each box one box batch over the later boxes
+		template<typename F>
+		inline void FindCellPairsBatched(
+			const HashCell& cell,
+			F& callback) const
+		{
+			cellProxies.clear();
+			cellBounds.Clear();
+			cellSpheres.Clear();
+
+			for (u32 i = cell.head; i != NULL_ENTRY; i = entries[i].next)
+			{
+				if (proxies[entries[i].proxy].isSphere) cellProxies.push_back(entries[i].proxy);
+			}
+			for (u32 i = cell.head; i != NULL_ENTRY; i = entries[i].next)
+			{
+				if (!proxies[entries[i].proxy].isSphere) cellProxies.push_back(entries[i].proxy);
+			}
+
+			u32 count = scast<u32>(cellProxies.size());
+			u32 sphereCount = cell.sphereCount;
+
+			for (u32 i = 0; i < count; i++)
+			{
+				const HashProxy& p = proxies[cellProxies[i]];
+				cellBounds.Push(p.bounds);
+
+				if (i < sphereCount)
+				{
+					vec3 center{};
+					f32 radius{};
+					GetProxySphere(p, center, radius);
+					cellSpheres.Push(center, radius);
+				}
+			}
+
+			for (u32 i = 0; i < count; i++)
+			{
+				i32 a = cellProxies[i];
+				const ColliderBounds& ba = proxies[a].bounds;
+
+				batchHits.clear();
+				if (i < sphereCount)
+				{
+					vec3 center{};
+					f32 radius{};
+					GetProxySphere(proxies[a], center, radius);
+
+					OverlapKernels::OverlapSphere(center, radius, cellSpheres, i + 1, sphereCount, batchHits);
+					OverlapKernels::OverlapSphereAABB(center, radius, cellBounds, sphereCount, count, batchHits);
+				}
+				else OverlapKernels::OverlapAABB(ba, cellBounds, i + 1, count, batchHits);
+
+				for (u32 hit : batchHits)
+				{
+					i32 b = cellProxies[hit];
+
+					//capsule spheres reach past their bounds on the short axes
+					if (!ba.Overlaps(proxies[b].bounds)) continue;
+
+					ReportCellPair(cell, a, b, callback);
+				}
+			}
+		}
+
+		//Returns the table slot of the cell, inserting it if it was empty this frame
+		u32 FindOrInsertCell(
+			i32 x,
+			i32 y,
+			i32 z);
+
+		vector<HashProxy> proxies{};
+		vector<HashCell> table{};
+		vector<HashEntry> entries{};
+
+		//table slots written during the last build
+		vector<u32> occupiedSlots{};
+		//proxies that skipped the grid during the last build
+		vector<i32> oversized{};
+		//bounds of every proxy slot, only packed while there are oversized proxies
+		PackedBounds packed{};
+		//kernel output scratch for FindPairs
+		mutable vector<u32> batchHits{};
+		//packed scratch of the cell FindPairs is batching
+		mutable vector<i32> cellProxies{};
+		mutable PackedBounds cellBounds{};
+		mutable PackedSpheres cellSpheres{};
+
+		f32 cellSize = DEFAULT_HASH_CELL_SIZE;
+		f32 inverseCellSize = 1.0f / DEFAULT_HASH_CELL_SIZE;
+
+		i32 freeList = -1;
+		u32 proxyCount{};
+
+		u32 stamp{};
+		u64 probeCount{};
+
+		SpatialHashStats stats{};
+	};
+}
\ No newline at end of file
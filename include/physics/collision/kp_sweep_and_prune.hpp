@@ -0,0 +1,152 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <array>
+
+#include "core_utils.hpp"
+
+#include "physics/collision/kp_collision_math.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using std::vector;
+	using std::array;
+
+	using u8 = uint8_t;
+	using i32 = int32_t;
+	using u32 = uint32_t;
+	using u64 = uint64_t;
+
+	class Collider;
+
+	struct LIB_API SAPEndpoint
+	{
+		f32 value{};
+		//proxy ID shifted left by one, lowest bit is set for max endpoints
+		u32 data{};
+
+		inline i32 GetProxy() const { return scast<i32>(data >> 1); }
+		inline bool IsMax() const { return (data & 1u) != 0; }
+	};
+
+	//Sweep and prune over persistent per-axis endpoint arrays.
+	//Endpoints are re-sorted with insertion sort every frame,
+	//which is close to linear when colliders only move a little between frames
+	class LIB_API SweepAndPrune
+	{
+	public:
+		i32 CreateProxy(
+			const ColliderBounds& bounds,
+			Collider* collider);
+		void DestroyProxy(i32 proxyID);
+		void MoveProxy(
+			i32 proxyID,
+			const ColliderBounds& bounds);
+
+		bool IsValidProxy(i32 proxyID) const;
+		Collider* GetCollider(i32 proxyID) const;
+
+		u32 GetProxyCount() const;
+		//Endpoint swaps done by the last SortEndpoints call
+		u64 GetSwapCount() const;
+		//Axis the last FindPairs call swept along
+		u8 GetSweepAxis() const;
+
+		//Refreshes endpoint values from the proxy bounds and re-sorts all three axes
+		void SortEndpoints();
+
+		//Sweeps along the axis with the largest spread and calls
+		//'callback(i32 proxyA, i32 proxyB)' for every overlapping pair,
+		//SortEndpoints must be called first
+		template<typename F>
+		inline void FindPairs(F&& callback)
+		{
+			sweepAxis = PickSweepAxis();
+
+			u8 axis1 = (sweepAxis + 1) % 3;
+			u8 axis2 = (sweepAxis + 2) % 3;
+
+			active.clear();
+
+			for (const auto& e : endpoints[sweepAxis])
+			{
+				i32 p = e.GetProxy();
+
+				if (e.IsMax())
+				{
+					//swap-remove from the active list
+					i32 slot = proxies[p].activeSlot;
+					i32 last = active.back();
+
+					active[slot] = last;
+					proxies[last].activeSlot = slot;
+					active.pop_back();
+
+					continue;
+				}
+
+				const ColliderBounds& b = proxies[p].bounds;
+				f32 min1 = vcomp(b.min, axis1);
+				f32 max1 = vcomp(b.max, axis1);
+				f32 min2 = vcomp(b.min, axis2);
+				f32 max2 = vcomp(b.max, axis2);
+
+				for (i32 q : active)
+				{
+					const ColliderBounds& o = proxies[q].bounds;
+
+					if (min1 <= vcomp(o.max, axis1)
+						&& max1 >= vcomp(o.min, axis1)
+						&& min2 <= vcomp(o.max, axis2)
+						&& max2 >= vcomp(o.min, axis2))
+					{
+						if (q < p) callback(q, p);
+						else callback(p, q);
+					}
+				}
+
+				proxies[p].activeSlot = scast<i32>(active.size());
+				active.push_back(p);
+			}
+		}
+
+		//Removes all proxies but keeps the allocated storage
+		void Clear();
+	private:
+		struct SAPProxy
+		{
+			ColliderBounds bounds{};
+			Collider* collider{};
+
+			//index into the active list while sweeping, next free proxy while dead
+			i32 activeSlot = -1;
+			i32 nextFree = -1;
+
+			bool isAlive{};
+		};
+
+		u8 PickSweepAxis() const;
+
+		vector<SAPProxy> proxies{};
+		array<vector<SAPEndpoint>, 3> endpoints{};
+
+		//proxies overlapping the sweep position, reused across frames
+		vector<i32> active{};
+
+		i32 freeList = -1;
+		u32 proxyCount{};
+
+		//dead endpoints are only compacted away once per sort
+		bool hasRemovals{};
+		//endpoints appended since the last sort
+		u32 pendingInserts{};
+
+		u64 swapCount{};
+		u8 sweepAxis{};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include "core_utils.hpp"
+#include "math_utils.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	using u32 = uint32_t;
+
+	using KalaHeaders::KalaMath::vec3;
+
+	//Vertices per arena chunk, larger requests get a chunk of their own
+	constexpr u32 VERTEX_ARENA_CHUNK_SIZE = 16384;
+	//Freed ranges up to this many vertices are recycled through exact-size bins,
+	//longer ranges go to a first-fit list where neighbouring free ranges merge
+	constexpr u32 VERTEX_ARENA_MAX_BINNED = 64;
+
+	//Shared storage for collider point data, every collider vertex range is carved
+	//from a few large chunks instead of owning its own heap vector.
+	//Chunks are never moved or released so returned pointers stay valid until freed.
+	//Not thread-safe, colliders are created and destroyed from the main thread
+	class LIB_API VertexArena
+	{
+	public:
+		//Returns storage for count vertices, or nullptr if count is 0
+		static vec3* Allocate(u32 count);
+		//Returns a range from Allocate back to the arena, count must match the allocation
+		static void Free(
+			vec3* data,
+			u32 count);
+
+		//Make sure the next allocations totalling count vertices fit without a new chunk
+		static void Reserve(u32 count);
+
+		//Vertices currently handed out
+		static u32 GetLiveCount();
+		//Vertices owned by the arena, live or free
+		static u32 GetCapacity();
+	};
+}
\ No newline at end of file
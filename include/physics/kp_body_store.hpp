@@ -0,0 +1,110 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <span>
+
+#include "core_utils.hpp"
+#include "math_utils.hpp"
+
+namespace KalaPhysics::Core
+{
+	class PhysicsWorld;
+}
+
+namespace KalaPhysics::Physics
+{
+	using std::vector;
+	using std::span;
+
+	using u8 = uint8_t;
+	using u32 = uint32_t;
+	using f32 = float;
+
+	using KalaHeaders::KalaMath::vec3;
+	using KalaHeaders::KalaMath::quat;
+
+	class RigidBody;
+	struct RigidBodyVars;
+
+	constexpr u8 BODY_FLAG_SLEEPING = 1u << 0; //body is asleep and skipped by integration
+	constexpr u8 BODY_FLAG_CCD = 1u << 1;      //body uses continuous collision detection
+	//body carries a collider that can't turn with it, contacts never spin it and it keeps its rotation
+	constexpr u8 BODY_FLAG_FIXED_ROTATION = 1u << 2;
+
+	//Contiguous structure-of-arrays storage for every live rigidbody.
+	//Each array is addressed by the dense body index stored in the owning RigidBody handle,
+	//removing a body swap-removes its entries so the arrays never have holes
+	class LIB_API BodyStore
+	{
+		friend class KalaPhysics::Core::PhysicsWorld;
+	public:
+		//
+		// HOT DATA, READ BY EVERY SIMULATION STEP
+		//
+
+		static inline vector<vec3> positions{};
+		static inline vector<quat> rotations{};
+		static inline vector<vec3> velocities{};
+		static inline vector<vec3> angularVelocities{};
+		static inline vector<f32> inverseMasses{};
+		//inverse principal moments of inertia in body space
+		static inline vector<vec3> inverseInertias{};
+		static inline vector<u8> flags{};
+		//seconds each awake body has stayed below the sleep thresholds
+		static inline vector<f32> sleepTimes{};
+
+		//
+		// COLD DATA, ONLY READ WHEN SETTING UP OR RESPONDING TO CONTACTS
+		//
+
+		static inline vector<RigidBodyVars> vars{};
+		static inline vector<RigidBody*> owners{};
+		//island a sleeping body fell asleep with, 0 while awake
+		static inline vector<u32> sleepGroups{};
+		//state at the start of the last fixed step, blended with the current state for rendering
+		static inline vector<vec3> previousPositions{};
+		static inline vector<quat> previousRotations{};
+
+		//Appends a new body and returns its dense index
+		static u32 AddBody(RigidBody* owner);
+		//Swap-removes the body at the dense index and patches the handle of the body moved into its place
+		static void RemoveBody(u32 index);
+
+		static u32 GetBodyCount();
+
+		//Puts the bodies to sleep as one group and clears their velocities,
+		//waking any of them later wakes the whole group
+		static void SleepBodies(span<const u32> indices);
+		//Wakes the bodies and every body that fell asleep in the same group,
+		//awake bodies only restart their sleep timer
+		static void WakeBodies(span<const u32> indices);
+		static void WakeBody(u32 index);
+
+		//Places every collider carried by the body on the body's current position and rotation,
+		//static colliders are not affected by their body and stay where they are
+		static void UpdateColliderPoses(u32 index);
+		//Sets BODY_FLAG_FIXED_ROTATION if the body carries a collider that can't rotate,
+		//called whenever the carried colliders change
+		static void RefreshRotationLock(u32 index);
+		//Derives the principal inertia from the mass and the shapes of the carried colliders
+		//unless it was set by hand, called whenever the mass or the carried colliders change
+		static void RefreshInertia(u32 index);
+	private:
+		//Copies the current positions and rotations over the previous ones
+		static void StorePreviousState();
+
+		//Applies gravity and damping to the velocities of every awake dynamic body,
+		//runs before the contact solver so contacts see this step's velocities
+		static void IntegrateVelocities(
+			f32 deltaTime,
+			const vec3& gravity);
+		//Moves every awake dynamic body by its solved velocities
+		//and places their colliders on the new poses
+		static void IntegratePositions(f32 deltaTime);
+	};
+}
\ No newline at end of file
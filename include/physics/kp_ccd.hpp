@@ -0,0 +1,53 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include "core_utils.hpp"
+
+namespace KalaPhysics::Core
+{
+	class PhysicsWorld;
+}
+
+namespace KalaPhysics::Physics
+{
+	using u32 = uint32_t;
+	using f32 = float;
+
+	//Bodies moving less than this share of their smallest half extent per step can't tunnel and are not swept
+	constexpr f32 CCD_MOTION_THRESHOLD = 0.5f;
+	//Impacts resolved per body and step, motion left after the last one is dropped
+	constexpr u32 CCD_MAX_IMPACTS = 4;
+	//Gap left between a swept body and what it hit so the next step starts just out of contact
+	constexpr f32 CCD_TARGET_SEPARATION = 0.01f;
+	//Advancement stops once the gap is within this of the target separation
+	constexpr f32 CCD_TOLERANCE = 0.0025f;
+
+	struct LIB_API CCDStats
+	{
+		u32 sweptBodies{};    //flagged bodies fast enough to be swept last step
+		u32 candidateTests{}; //collider pairs advanced last step
+		u32 impacts{};        //impacts resolved last step
+	};
+
+	//Continuous collision for bodies flagged with RigidBody::SetCCD.
+	//After the discrete step every flagged body that moved far enough is swept from its previous to its current position,
+	//candidates come from the broadphase through the swept bounds and the time of impact is found by
+	//conservative advancement on GJK distances. Impacts are resolved in time order, the body is moved back
+	//to the impact, loses its approach velocity or bounces by its restitution, and the rest of its motion
+	//is swept again locally so the global timestep is never shortened.
+	//Only translation is swept, the rotation of the step is applied to the colliders at its end and
+	//everything a swept body can hit is treated as stationary at its end of step transform
+	class LIB_API ContinuousCollision
+	{
+		friend class KalaPhysics::Core::PhysicsWorld;
+	public:
+		static const CCDStats& GetStats();
+	private:
+		//Sweeps every flagged body over the last step of deltaTime seconds
+		static void Resolve(f32 deltaTime);
+	};
+}
\ No newline at end of file
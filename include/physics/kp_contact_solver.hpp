@@ -0,0 +1,71 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <span>
+#include <climits>
+
+#include "core_utils.hpp"
+
+namespace KalaPhysics::Core
+{
+	class PhysicsWorld;
+}
+
+namespace KalaPhysics::Physics
+{
+	using std::span;
+
+	using u32 = uint32_t;
+	using f32 = float;
+
+	//Gauss-Seidel passes over every contact per step
+	constexpr u32 SOLVER_VELOCITY_ITERATIONS = 8;
+	//Fraction of the penetration removed per step through the velocity bias
+	constexpr f32 SOLVER_BAUMGARTE = 0.2f;
+	//Penetration left alone so resting contacts don't lose touch every other step
+	constexpr f32 SOLVER_PENETRATION_SLOP = 0.005f;
+	//Upper bound of the penetration recovery speed so deep overlaps don't explode apart
+	constexpr f32 SOLVER_MAX_CORRECTION_SPEED = 4.0f;
+	//Contacts approaching slower than this don't bounce, keeps resting stacks from jittering
+	constexpr f32 SOLVER_RESTITUTION_THRESHOLD = 1.0f;
+
+	//Bodies slower than this in m/s count as resting
+	constexpr f32 SLEEP_LINEAR_VELOCITY = 0.05f;
+	//Bodies spinning slower than this in rad/s count as resting
+	constexpr f32 SLEEP_ANGULAR_VELOCITY = 0.05f;
+	//Seconds every body of an island has to rest before the island falls asleep
+	constexpr f32 SLEEP_TIME = 0.5f;
+
+	//Island index of bodies that were not simulated by the last solve
+	constexpr u32 INVALID_ISLAND = UINT_MAX;
+
+	//Projected Gauss-Seidel sequential impulse solver for the manifolds in the pair cache.
+	//Bodies touching each other are grouped into islands with union-find, every island is solved
+	//sequentially on one thread and independent islands run in parallel on the job system,
+	//so results don't depend on the thread count. Accumulated impulses are written back to the
+	//pair cache and warm start the next step. Static colliders, colliders without a rigidbody,
+	//massless bodies and sleeping bodies are immovable to the solver and never join islands.
+	//Islands whose bodies all rested for SLEEP_TIME fall asleep together, an awake body
+	//touching a sleeping one wakes its group and the group rejoins the solve on the next step
+	class LIB_API ContactSolver
+	{
+		friend class KalaPhysics::Core::PhysicsWorld;
+	public:
+		//Islands of the last solve, every awake dynamic body is in exactly one island
+		static u32 GetIslandCount();
+		//Returns the dense body indices of an island from the last solve
+		static span<const u32> GetIslandBodies(u32 island);
+		//Returns the island of a dense body index from the last solve, or INVALID_ISLAND
+		static u32 GetBodyIsland(u32 bodyIndex);
+	private:
+		//Builds islands from the cached manifolds, solves them and stores the impulses for warm starting
+		static void Solve(f32 deltaTime);
+		//Advances the sleep timers of the islands from the last solve and puts resting islands to sleep,
+		//runs after the positions are integrated
+		static void UpdateSleeping(f32 deltaTime);
+	};
+}
\ No newline at end of file
@@ -9,10 +9,12 @@
 #include <string>
 
 #include "core_utils.hpp"
+#include "math_utils.hpp"
 #include "log_utils.hpp"
 
 #include "core/kp_registry.hpp"
 #include "core/kp_physics_world.hpp"
+#include "physics/kp_ray.hpp"
 
 namespace KalaPhysics::Core
 {
@@ -28,12 +30,21 @@ namespace KalaPhysics::Physics
 	using u32 = uint32_t;
 	using f32 = float;
 
+	using KalaHeaders::KalaMath::vec3;
 	using KalaHeaders::KalaLog::Log;
 	using KalaHeaders::KalaLog::LogType;
 	
 	using KalaPhysics::Core::KalaPhysicsRegistry;
 	using KalaPhysics::Core::MAX_LAYERS;
+
+	//default launch speed in meters per second
+	constexpr f32 DEFAULT_DELAYED_RAY_SPEED = 100.0f;
+	//default seconds a projectile flies before it expires
+	constexpr f32 DEFAULT_DELAYED_RAY_LIFETIME = 5.0f;
 	
+	//Describes how the projectiles it fires fly, the projectiles themselves live in the ProjectileStore.
+	//Every fixed step moves each projectile, sweeps the segment it travelled against the ray scene
+	//and reports hits through ProjectileStore::GetHits. Changing the delayed ray only affects projectiles fired after it
 	class LIB_API DelayedRay
 	{
 		friend class KalaPhysics::Core::PhysicsWorld;
@@ -48,6 +59,42 @@ namespace KalaPhysics::Physics
 		bool IsInitialized() const;
 
 		u32 GetID() const;
+
+		//Launches a projectile from origin along direction at the launch speed,
+		//returns its projectile ID or 0 if direction has no length
+		u32 Fire(
+			const vec3& origin,
+			const vec3& direction) const;
+
+		//Launch speed in meters per second
+		void SetSpeed(f32 newValue);
+		f32 GetSpeed() const;
+
+		//Acceleration along the flight direction in meters per second squared,
+		//negative values decelerate
+		void SetAcceleration(f32 newValue);
+		f32 GetAcceleration() const;
+
+		//Weight of the projectile as a multiplier of the world gravity, 0 flies straight
+		void SetGravityScale(f32 newValue);
+		f32 GetGravityScale() const;
+
+		//Steady wind acceleration in any direction in meters per second squared
+		void SetWind(const vec3& newValue);
+		const vec3& GetWind() const;
+
+		//Quadratic drag coefficient, opposes the motion by drag * speed^2
+		void SetDrag(f32 newValue);
+		f32 GetDrag() const;
+
+		//Seconds a projectile flies before it expires without hitting anything
+		void SetLifetime(f32 newValue);
+		f32 GetLifetime() const;
+
+		//How projectiles hit colliders that move during a step, moving targets are followed along
+		//their interpolated path so fast targets are not skipped without raising the substeps
+		void SetTargetMode(RayTargetMode newValue);
+		RayTargetMode GetTargetMode() const;
 		
 		//Set mask directly
 		void SetMask(u32 m);
@@ -63,12 +110,18 @@ namespace KalaPhysics::Physics
 		
 		~DelayedRay();
 	private:
-		void Update(f32 deltaTime);
-
 		bool isInitialized{};
 
 		u32 ID{};
 	
 		u32 mask = ~0u; //default - collide with everything
+
+		f32 speed = DEFAULT_DELAYED_RAY_SPEED;
+		f32 acceleration{};
+		f32 gravityScale = 1.0f;
+		vec3 wind{};
+		f32 drag{};
+		f32 lifetime = DEFAULT_DELAYED_RAY_LIFETIME;
+		RayTargetMode targetMode = RayTargetMode::TARGET_MOVING;
 	};
 }
\ No newline at end of file
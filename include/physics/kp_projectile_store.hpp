@@ -0,0 +1,140 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+
+#include "core_utils.hpp"
+#include "math_utils.hpp"
+
+#include "physics/kp_ray.hpp"
+
+namespace KalaPhysics::Core
+{
+	class PhysicsWorld;
+}
+
+namespace KalaPhysics::Physics::Collision
+{
+	class Collider;
+}
+
+namespace KalaPhysics::Physics
+{
+	using std::vector;
+
+	using u32 = uint32_t;
+	using f32 = float;
+
+	using KalaHeaders::KalaMath::vec3;
+
+	using KalaPhysics::Physics::Collision::Collider;
+
+	//Launch state of one projectile, copied from its delayed ray when it is fired
+	struct LIB_API ProjectileDesc
+	{
+		vec3 position{};
+		vec3 velocity{};
+		//steady acceleration on top of gravity, for example wind
+		vec3 force{};
+
+		//multiplier of the world gravity, 0 flies straight
+		f32 gravityScale{};
+		//acceleration along the flight direction, negative values decelerate
+		f32 thrust{};
+		//quadratic drag coefficient, slows the projectile by drag * speed^2
+		f32 drag{};
+		//seconds until the projectile expires without hitting anything
+		f32 lifetime{};
+
+		u32 mask{};
+		u32 rayID{};
+
+		//how colliders that move during a step are hit
+		RayTargetMode targetMode{};
+	};
+
+	struct LIB_API DelayedRayHit
+	{
+		//delayed ray that fired the projectile and the projectile ID its Fire call returned
+		u32 rayID{};
+		u32 projectileID{};
+
+		//non-owning pointer to the hit collider
+		Collider* collider{};
+		vec3 point{};
+		vec3 normal{};
+
+		//velocity at the end of the step the projectile hit in
+		vec3 velocity{};
+		//seconds the projectile was alive when it hit
+		f32 age{};
+		//fraction of the step the projectile hit at, point is where it was at that time
+		f32 time{};
+	};
+
+	//Contiguous structure-of-arrays storage for every live delayed ray projectile.
+	//Projectiles are plain entries instead of registry objects, every fixed step integrates all of them
+	//in one pass, sweeps each travel segment against the ray scene and swap-removes the ones
+	//that hit something or ran out of lifetime
+	class LIB_API ProjectileStore
+	{
+		friend class KalaPhysics::Core::PhysicsWorld;
+	public:
+		//
+		// HOT DATA, READ BY EVERY SIMULATION STEP
+		//
+
+		static inline vector<f32> positionsX{};
+		static inline vector<f32> positionsY{};
+		static inline vector<f32> positionsZ{};
+		static inline vector<f32> velocitiesX{};
+		static inline vector<f32> velocitiesY{};
+		static inline vector<f32> velocitiesZ{};
+		static inline vector<f32> forcesX{};
+		static inline vector<f32> forcesY{};
+		static inline vector<f32> forcesZ{};
+		static inline vector<f32> gravityScales{};
+		static inline vector<f32> thrusts{};
+		static inline vector<f32> drags{};
+		static inline vector<f32> ages{};
+		static inline vector<f32> lifetimes{};
+
+		//
+		// COLD DATA, ONLY READ BY THE SWEEP AND WHEN A PROJECTILE HITS
+		//
+
+		//positions at the start of the last step, the sweep runs from here to the current position
+		static inline vector<f32> previousX{};
+		static inline vector<f32> previousY{};
+		static inline vector<f32> previousZ{};
+		static inline vector<u32> masks{};
+		static inline vector<RayTargetMode> targetModes{};
+		static inline vector<u32> rayIDs{};
+		static inline vector<u32> projectileIDs{};
+
+		//Appends a new projectile and returns its projectile ID
+		static u32 AddProjectile(const ProjectileDesc& desc);
+
+		static u32 GetProjectileCount();
+
+		//Returns every projectile that hit a collider during the last update, in step order
+		static const vector<DelayedRayHit>& GetHits();
+
+		//Drops every live projectile without reporting hits
+		static void Clear();
+	private:
+		//Integrates all projectiles, sweeps their travel segments and removes the ones that are done.
+		//Runs after the ray scene update so projectiles see the final poses of the step
+		static void Update(
+			f32 deltaTime,
+			const vec3& gravity);
+		//Forgets the hits of the previous update, every step of the next one appends to them
+		static void ClearHits();
+
+		static void RemoveProjectile(u32 index);
+	};
+}
\ No newline at end of file
@@ -7,22 +7,31 @@
 
 #include <initializer_list>
 #include <string>
+#include <span>
 
 #include "core_utils.hpp"
 #include "math_utils.hpp"
 #include "log_utils.hpp"
 
 #include "core/kp_physics_world.hpp"
+#include "physics/collision/kp_broadphase.hpp"
 
 namespace KalaPhysics::Core
 {
 	class PhysicsWorld;
+	class KalaPhysicsCore;
+}
+
+namespace KalaPhysics::Physics::Collision
+{
+	class Collider; //forward declare collider so Ray can return Collider
 }
 
 namespace KalaPhysics::Physics
 {
 	using std::initializer_list;
 	using std::string;
+	using std::span;
 
 	using KalaHeaders::KalaMath::vec3;
 	using KalaHeaders::KalaLog::Log;
@@ -30,30 +39,94 @@ namespace KalaPhysics::Physics
 	
 	using KalaPhysics::Core::MAX_LAYERS;
 	
+	using KalaPhysics::Physics::Collision::Collider;
+	using KalaPhysics::Physics::Collision::StaticTreeUpdate;
+
 	constexpr f32 MAX_DISTANCE = 10000.0f;
+	//Rays per job of a batch cast, a multiple of the packet size so jobs never split a packet
+	constexpr u32 RAY_BATCH_CHUNK_SIZE = 64;
 
-	class Collider; //forward declare collider so Ray can return Collider
+	enum class RayTargetMode : u8
+	{
+		TARGET_STATIC = 0, //every collider is tested at its pose at the end of the last step
+		TARGET_MOVING = 1, //colliders that moved during the last step are tested along their interpolated path
+		TARGET_SWEPT = 2   //colliders that moved during the last step fill all the space they passed through
+	};
+
+	struct RayQuery
+	{
+		vec3 origin{};
+		vec3 direction{};
+		//0.0f means ray max distance is 10000 units
+		f32 maxDistance{};
+	};
+
+	struct RayHit
+	{
+		//non-owning pointer to the closest collider, nullptr on a miss
+		Collider* collider{};
+		vec3 point{};
+		//outward surface normal, faces against the ray if it started inside the collider
+		vec3 normal{};
+		f32 distance{};
+	};
 	
 	class LIB_API Ray
 	{
 		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class KalaPhysics::Core::KalaPhysicsCore;
 	public:
 		//Create a new mask from multiple layers
 		static u32 MakeMaskFromLayers(initializer_list<u8> layers);
 		
-		//Returns true if this ray hit any collider with the valid layer,
+		//Returns true if this ray hit any collider with a layer in the mask,
+		//stops at the first hit instead of searching for the closest one,
 		//a maxDistance of 0.0f means ray max distance is 10000 units
-		static bool HitAny(
+		bool HitAny(
 			const vec3& origin,
 			const vec3& direction,
-			f32 maxDistance = 0.0f);
+			f32 maxDistance = 0.0f) const;
 			
-		//Returns the collider non-owning pointer this ray hit,
+		//Returns the non-owning pointer to the closest collider with a layer in the mask,
+		//a maxDistance of 0.0f means ray max distance is 10000 units
+		Collider* HitCollider(
+			const vec3& origin,
+			const vec3& direction,
+			f32 maxDistance = 0.0f) const;
+
+		//Same as HitCollider but also returns the hit point, normal and distance
+		bool Cast(
+			const vec3& origin,
+			const vec3& direction,
+			RayHit& outHit,
+			f32 maxDistance = 0.0f) const;
+
+		//Casts every query like Cast and writes its result to the same index of outHits,
+		//which has to be at least as long as queries. Neighbouring queries pointing into the same
+		//octant are traced together as packets, mixed packets fall back to single rays.
+		//Large batches are split across the job system, nothing is allocated
+		void CastBatch(
+			span<const RayQuery> queries,
+			span<RayHit> outHits) const;
+
+		//Casts a ray that travelled from origin to origin + direction * maxDistance during the last step.
+		//Colliders that moved during that step are tested by mode, colliders at rest like Cast.
+		//The hit distance over maxDistance is the fraction of the step the hit happened at
+		//and the hit point is where the ray was at that time,
 		//a maxDistance of 0.0f means ray max distance is 10000 units
-		static Collider* HitCollider(
+		bool CastSwept(
 			const vec3& origin,
 			const vec3& direction,
-			f32 maxDistance = 0.0f);
+			RayHit& outHit,
+			RayTargetMode mode,
+			f32 maxDistance = 0.0f) const;
+
+		//Casts every query like CastSwept and writes its result to the same index of outHits,
+		//which has to be at least as long as queries. Runs like CastBatch if nothing moved during the last step
+		void CastSweptBatch(
+			span<const RayQuery> queries,
+			span<RayHit> outHits,
+			RayTargetMode mode) const;
 		
 		//Set mask directly
 		void SetMask(u32 m);
@@ -67,6 +140,22 @@ namespace KalaPhysics::Physics
 		
 		u32 GetMask() const;
 	private:
+		//Brings the ray hierarchies up to date at the end of a physics step, split like the broadphase.
+		//The static hierarchy goes through staticUpdate, so it is only rebuilt when a live collider
+		//entered or left the static set. The dynamic hierarchy is rebuilt if isDynamicSetChanged
+		//and refitted otherwise, and the hierarchy of colliders that moved during the step is rebuilt
+		static void UpdateScene(
+			span<Collider* const> staticColliders,
+			span<Collider* const> dynamicColliders,
+			StaticTreeUpdate staticUpdate,
+			bool isDynamicSetChanged);
+		//Masks colliders removed since the last call out of the ray hierarchies without rebuilding them,
+		//found through the collider registry events in O(removals). Runs before every query
+		//and before the physics world drains the registry events
+		static void MaskRemovedColliders();
+		//Drops the ray hierarchies, called on shutdown
+		static void ClearScene();
+
 		u32 mask = ~0u; //default - collide with everything
 	};
 }
\ No newline at end of file
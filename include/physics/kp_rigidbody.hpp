@@ -13,6 +13,7 @@
 #include "math_utils.hpp"
 
 #include "core/kp_registry.hpp"
+#include "physics/kp_body_store.hpp"
 
 namespace KalaPhysics::Core
 {
@@ -27,39 +28,43 @@ namespace KalaPhysics::Physics
 	using KalaHeaders::KalaLog::Log;
 	using KalaHeaders::KalaLog::LogType;
 	using KalaHeaders::KalaMath::vec3;
-	using KalaHeaders::KalaMath::mat3;
+	using KalaHeaders::KalaMath::quat;
 
 	using KalaPhysics::Core::KalaPhysicsRegistry;
 	
 	constexpr u8 MAX_COLLIDERS = 50;
 
 	constexpr f32 MAX_MASS = 10000.0f;
+	constexpr f32 MAX_FRICTION = 10.0f;
 	inline const vec3 MAX_GRAVITY_SCALE = 10000.0f;
 	inline const vec3 MAX_VELOCITY = 10000.0f;
 	inline const vec3 MAX_ANGULAR_VELOCITY = 10000.0f;
+	inline const vec3 MAX_PRINCIPAL_INERTIA = 10000.0f;
 
+	//Rarely touched per-body data, position, rotation, velocities,
+	//inverse mass, inverse inertia and state flags live in the hot BodyStore arrays instead
 	struct LIB_API RigidBodyVars
 	{
-		bool isSleeping{}; //is this body currently sleeping
-		bool ccd{};	       //is continuous collision enabled
-
 		f32 mass{};
 		f32 restitution{};
+		f32 friction = 0.5f; //coulomb friction coefficient, combined per contact as sqrt(a * b)
 		f32 linearDamp{};
 		f32 angularDamp{};
 
 		vec3 gravityScale = 1.0f; //per-rb multiplier
-		vec3 velocity{};
-		vec3 angularVelocity{};
-		mat3 inertiaTensor{};
+		vec3 principalInertia{};  //diagonal of the body-space inertia tensor
+		bool isInertiaCustom{};   //set by SetPrincipalInertia, the inertia is no longer derived from the colliders
 
 		f32 accumForce{};
 		f32 accumTorque{};
 	};
 	
+	//Handle to a body stored in BodyStore, the handle owns the colliders list
+	//and knows the dense index of its body which may change when other bodies are removed
 	class LIB_API RigidBody
 	{
 		friend class KalaPhysics::Core::PhysicsWorld;
+		friend class BodyStore;
 	public:
 		static KalaPhysicsRegistry<RigidBody>& GetRegistry();
 		
@@ -68,6 +73,8 @@ namespace KalaPhysics::Physics
 		bool IsInitialized() const;
 
 		u32 GetID() const;
+		//Dense index of this body in the BodyStore arrays, only stable until another body is removed
+		u32 GetBodyIndex() const;
 		
 		//Add a new collider by its ID to this rigidbody
 		void AddCollider(u32 colliderID);
@@ -80,14 +87,36 @@ namespace KalaPhysics::Physics
 		u8 GetColliderCount() const;
 
 		bool IsSleeping() const;
+		//Wakes this body and every body that fell asleep with it
+		void Wake();
+		//Puts this body to sleep on its own until something touches or moves it
+		void Sleep();
+
+		//Fast bodies with continuous collision are swept every step so they can't tunnel through thin colliders
+		void SetCCD(bool newValue);
 		bool IsCCD() const;
 
+		//Teleports this body, its colliders keep their place relative to it
+		const vec3& GetPosition() const;
+		void SetPosition(const vec3& newValue);
+
+		const quat& GetRotation() const;
+		void SetRotation(const quat& newValue);
+
+		//Position and rotation blended between the last two fixed steps by PhysicsWorld::GetInterpolationAlpha,
+		//use these for rendering so motion stays smooth when the frame rate and step rate differ
+		vec3 GetInterpolatedPosition() const;
+		quat GetInterpolatedRotation() const;
+
 		f32 GetMass() const;
 		void SetMass(f32 newValue);
 
 		f32 GetRestitution() const;
 		void SetRestitution(f32 newValue);
 
+		f32 GetFriction() const;
+		void SetFriction(f32 newValue);
+
 		f32 GetLinearDamp() const;
 		void SetLinearDamp(f32 newValue);
 
@@ -100,10 +129,14 @@ namespace KalaPhysics::Physics
 		const vec3& GetVelocity() const;
 		void SetVelocity(const vec3& newValue);
 
+		//Ignored while the body carries an AABB or capsule collider, those shapes can't rotate with it
 		const vec3& GetAngularVelocity() const;
 		void SetAngularVelocity(const vec3& newValue);
 
-		const mat3& GetInertiaTensor() const;
+		//Principal moments of inertia in body space, 0 on an axis locks rotation around it.
+		//Derived from the mass and the carried collider shapes until it is set here
+		const vec3& GetPrincipalInertia() const;
+		void SetPrincipalInertia(const vec3& newValue);
 
 		f32 GetAccumulatedForce() const;
 
@@ -118,6 +151,7 @@ namespace KalaPhysics::Physics
 		array<u32, MAX_COLLIDERS> colliders{};
 		u8 colliderCount{};
 
-		RigidBodyVars vars{};
+		//dense index of this body in every BodyStore array
+		u32 bodyIndex{};
 	};
 }
\ No newline at end of file
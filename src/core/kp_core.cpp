@@ -12,12 +12,26 @@
 #include "log_utils.hpp"
 
 #include "core/kp_core.hpp"
+#include "core/kp_job_system.hpp"
+#include "physics/kp_rigidbody.hpp"
+#include "physics/kp_ray.hpp"
+#include "physics/kp_delayed_ray.hpp"
+#include "physics/kp_projectile_store.hpp"
+#include "physics/collision/kp_collider.hpp"
+#include "physics/collision/kp_pair_cache.hpp"
 
 using KalaHeaders::KalaLog::Log;
 using KalaHeaders::KalaLog::LogType;
 using KalaHeaders::KalaLog::TimeFormat;
 using KalaHeaders::KalaLog::DateFormat;
 
+using KalaPhysics::Physics::RigidBody;
+using KalaPhysics::Physics::Ray;
+using KalaPhysics::Physics::DelayedRay;
+using KalaPhysics::Physics::ProjectileStore;
+using KalaPhysics::Physics::Collision::Collider;
+using KalaPhysics::Physics::Collision::PairCache;
+
 #ifdef __linux__
 using std::raise;
 #endif
@@ -46,6 +60,19 @@ namespace KalaPhysics::Core
 			"Cleaning all KalaPhysics resources.",
 			"KALAPHYSICS",
 			LogType::LOG_INFO);
+
+		JobSystem::Shutdown();
+
+		//cached manifolds, the ray hierarchy and projectile hits point at colliders that are about to be destroyed
+		PairCache::Clear();
+		Ray::ClearScene();
+		ProjectileStore::Clear();
+
+		//colliders and rigidbodies return their pooled memory here
+		//instead of during static destruction in an unspecified order
+		Collider::GetRegistry().RemoveAllContent();
+		RigidBody::GetRegistry().RemoveAllContent();
+		DelayedRay::GetRegistry().RemoveAllContent();
 	}
 
 	void KalaPhysicsCore::ForceClose(
@@ -0,0 +1,309 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <string>
+
+#include "log_utils.hpp"
+
+#include "core/kp_job_system.hpp"
+
+using KalaHeaders::KalaLog::Log;
+using KalaHeaders::KalaLog::LogType;
+
+using std::vector;
+using std::unique_ptr;
+using std::make_unique;
+using std::thread;
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
+using std::condition_variable;
+using std::atomic;
+using std::min;
+using std::max;
+using std::to_string;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::memory_order_relaxed;
+
+namespace KalaPhysics::Core
+{
+	struct Job
+	{
+		const function<void(u32, u32, u32)>* func{};
+
+		u32 begin{};
+		u32 end{};
+		u32 chunkIndex{};
+
+		//chunks of the owning ParallelFor call that have not finished yet
+		atomic<u32>* remaining{};
+	};
+
+	//Ring of jobs allocated once on initialize, the owner works on the back and thieves on the front
+	struct WorkerQueue
+	{
+		mutex lock{};
+		vector<Job> jobs = vector<Job>(JOB_QUEUE_CAPACITY);
+
+		//slot of the oldest job
+		u32 head{};
+		u32 count{};
+
+		bool PushBack(const Job& job)
+		{
+			if (count == JOB_QUEUE_CAPACITY) return false;
+
+			jobs[(head + count) & (JOB_QUEUE_CAPACITY - 1)] = job;
+			++count;
+
+			return true;
+		}
+		Job PopBack()
+		{
+			--count;
+			return jobs[(head + count) & (JOB_QUEUE_CAPACITY - 1)];
+		}
+		Job PopFront()
+		{
+			Job job = jobs[head];
+			head = (head + 1) & (JOB_QUEUE_CAPACITY - 1);
+			--count;
+
+			return job;
+		}
+	};
+
+	static vector<thread> workers{};
+	//one queue per worker plus a last one shared by non-worker threads
+	static vector<unique_ptr<WorkerQueue>> queues{};
+
+	static atomic<bool> isRunning{};
+	static atomic<u32> queuedJobs{};
+
+	static mutex sleepLock{};
+	static condition_variable sleepSignal{};
+
+	//queue index of the current thread, non-worker threads use the shared last queue
+	static thread_local u32 threadQueue = 0xFFFFFFFFu;
+
+	static bool PopJob(
+		u32 selfIndex,
+		Job& outJob);
+	static void RunJob(const Job& job);
+	static void WorkerLoop(u32 index);
+
+	void JobSystem::Initialize(u32 workerCount)
+	{
+		if (isRunning)
+		{
+			Log::Print(
+				"Cannot initialize the job system because it is already running!",
+				"JOB_SYSTEM",
+				LogType::LOG_ERROR,
+				2);
+
+			return;
+		}
+
+		if (workerCount == 0)
+		{
+			u32 hardwareThreads = thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+		workerCount = min(workerCount, MAX_WORKER_THREADS);
+
+		queues.clear();
+		for (u32 i = 0; i < workerCount + 1; i++)
+		{
+			queues.push_back(make_unique<WorkerQueue>());
+		}
+
+		isRunning = true;
+
+		for (u32 i = 0; i < workerCount; i++)
+		{
+			workers.emplace_back(WorkerLoop, i);
+		}
+
+		Log::Print(
+			"Initialized job system with '" + to_string(workerCount) + "' worker threads.",
+			"JOB_SYSTEM",
+			LogType::LOG_SUCCESS);
+	}
+	void JobSystem::Shutdown()
+	{
+		if (!isRunning) return;
+
+		{
+			lock_guard<mutex> guard(sleepLock);
+			isRunning = false;
+		}
+		sleepSignal.notify_all();
+
+		for (auto& w : workers)
+		{
+			if (w.joinable()) w.join();
+		}
+
+		workers.clear();
+		queues.clear();
+		queuedJobs = 0;
+	}
+
+	bool JobSystem::IsInitialized() { return isRunning; }
+
+	u32 JobSystem::GetThreadCount() { return scast<u32>(workers.size()) + 1; }
+
+	u32 JobSystem::GetChunkCount(
+		u32 count,
+		u32 chunkSize)
+	{
+		chunkSize = max(chunkSize, 1u);
+		return (count + chunkSize - 1) / chunkSize;
+	}
+
+	void JobSystem::ParallelFor(
+		u32 count,
+		u32 chunkSize,
+		const function<void(u32, u32, u32)>& job)
+	{
+		if (count == 0 || !job) return;
+
+		chunkSize = max(chunkSize, 1u);
+		u32 chunkCount = GetChunkCount(count, chunkSize);
+
+		//nothing to share, run everything right here
+		if (!isRunning
+			|| chunkCount == 1)
+		{
+			for (u32 c = 0; c < chunkCount; c++)
+			{
+				u32 begin = c * chunkSize;
+				job(begin, min(begin + chunkSize, count), c);
+			}
+
+			return;
+		}
+
+		u32 selfIndex = threadQueue < queues.size()
+			? threadQueue
+			: scast<u32>(queues.size() - 1);
+
+		atomic<u32> remaining{ chunkCount };
+
+		//count the jobs before they become visible so a fast thief can never underflow the counter
+		queuedJobs.fetch_add(chunkCount, memory_order_release);
+
+		//deal chunks round-robin, starting from this thread so it gets the first share
+		u32 queueCount = scast<u32>(queues.size());
+		u32 queuedCount = 0;
+		for (; queuedCount < chunkCount; queuedCount++)
+		{
+			u32 begin = queuedCount * chunkSize;
+			WorkerQueue& q = *queues[(selfIndex + queuedCount) % queueCount];
+
+			lock_guard<mutex> guard(q.lock);
+			if (!q.PushBack({ &job, begin, min(begin + chunkSize, count), queuedCount, &remaining })) break;
+		}
+
+		//rings never grow, chunks that did not fit are not counted as queued
+		if (queuedCount < chunkCount) queuedJobs.fetch_sub(chunkCount - queuedCount, memory_order_relaxed);
+
+		//taking the lock orders the wakeup after any worker that is about to sleep
+		{
+			lock_guard<mutex> guard(sleepLock);
+		}
+		sleepSignal.notify_all();
+
+		//this thread runs the chunks that did not fit while the workers drain the rings
+		for (u32 c = queuedCount; c < chunkCount; c++)
+		{
+			u32 begin = c * chunkSize;
+			RunJob({ &job, begin, min(begin + chunkSize, count), c, &remaining });
+		}
+
+		//help out until every chunk of this call has finished
+		Job next{};
+		while (remaining.load(memory_order_acquire) > 0)
+		{
+			if (PopJob(selfIndex, next)) RunJob(next);
+			else std::this_thread::yield();
+		}
+	}
+
+	bool PopJob(
+		u32 selfIndex,
+		Job& outJob)
+	{
+		u32 queueCount = scast<u32>(queues.size());
+
+		//own queue first, newest job is the warmest in cache
+		{
+			WorkerQueue& own = *queues[selfIndex];
+			lock_guard<mutex> guard(own.lock);
+
+			if (own.count > 0)
+			{
+				outJob = own.PopBack();
+				queuedJobs.fetch_sub(1, memory_order_relaxed);
+
+				return true;
+			}
+		}
+
+		//steal the oldest job from everyone else
+		for (u32 i = 1; i < queueCount; i++)
+		{
+			WorkerQueue& victim = *queues[(selfIndex + i) % queueCount];
+			lock_guard<mutex> guard(victim.lock);
+
+			if (victim.count > 0)
+			{
+				outJob = victim.PopFront();
+				queuedJobs.fetch_sub(1, memory_order_relaxed);
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void RunJob(const Job& job)
+	{
+		(*job.func)(job.begin, job.end, job.chunkIndex);
+		job.remaining->fetch_sub(1, memory_order_release);
+	}
+
+	void WorkerLoop(u32 index)
+	{
+		threadQueue = index;
+
+		Job next{};
+		while (isRunning)
+		{
+			if (PopJob(index, next))
+			{
+				RunJob(next);
+				continue;
+			}
+
+			unique_lock<mutex> guard(sleepLock);
+			sleepSignal.wait(guard, []
+				{
+					return !isRunning
+						|| queuedJobs.load(memory_order_acquire) > 0;
+				});
+		}
+	}
+}
\ No newline at end of file
@@ -4,221 +4,343 @@
 //Read LICENSE.md for more information.
 
 #include <vector>
+#include <chrono>
+#include <algorithm>
 
 #include "core/kp_physics_world.hpp"
+#include "core/kp_profiler.hpp"
 #include "physics/kp_rigidbody.hpp"
+#include "physics/kp_body_store.hpp"
+#include "physics/kp_contact_solver.hpp"
+#include "physics/kp_ccd.hpp"
+#include "physics/kp_ray.hpp"
+#include "physics/kp_projectile_store.hpp"
 #include "physics/collision/kp_collider.hpp"
-#include "physics/collision/kp_collider_bsp.hpp"
-#include "physics/collision/kp_collider_aabb.hpp"
-#include "physics/collision/kp_collider_obb.hpp"
-#include "physics/collision/kp_collider_bcp.hpp"
-#include "physics/collision/kp_collider_kdop.hpp"
-#include "physics/collision/kp_collider_bch.hpp"
+#include "physics/collision/kp_broadphase.hpp"
+#include "physics/collision/kp_narrowphase.hpp"
+#include "physics/collision/kp_pair_cache.hpp"
 
 using KalaPhysics::Physics::RigidBody;
+using KalaPhysics::Physics::BodyStore;
+using KalaPhysics::Physics::BODY_FLAG_SLEEPING;
+using KalaPhysics::Physics::ContactSolver;
+using KalaPhysics::Physics::ContinuousCollision;
+using KalaPhysics::Physics::Ray;
+using KalaPhysics::Physics::ProjectileStore;
 using KalaPhysics::Physics::Collision::Collider;
 using KalaPhysics::Physics::Collision::ColliderShape;
-using KalaPhysics::Physics::Collision::Collider_BSP;
-using KalaPhysics::Physics::Collision::Collider_AABB;
-using KalaPhysics::Physics::Collision::Collider_OBB;
-using KalaPhysics::Physics::Collision::Collider_BCP;
-using KalaPhysics::Physics::Collision::Collider_KDOP;
-using KalaPhysics::Physics::Collision::Collider_BCH;
+using KalaPhysics::Physics::Collision::Broadphase;
+using KalaPhysics::Physics::Collision::Narrowphase;
+using KalaPhysics::Physics::Collision::PairCache;
+using KalaPhysics::Physics::Collision::ColliderPair;
+using KalaPhysics::Physics::Collision::StaticTreeUpdate;
 
 using std::vector;
+using std::count_if;
 using std::min;
+using std::max;
+using std::clamp;
+using std::milli;
+using std::chrono::steady_clock;
+using std::chrono::duration;
 
-static vector<Collider*> activeColliders{};
+//broadphase output, reused across frames
+static vector<ColliderPair> realCollisions{};
 
 namespace KalaPhysics::Core
 {
+	constexpr u32 NULL_SET_INDEX = 0xFFFFFFFFu;
+
+	enum class ColliderSet : u8
+	{
+		SET_NONE = 0,
+		SET_STATIC = 1, //static colliders and colliders without a parent rigidbody
+		SET_DYNAMIC = 2 //colliders carried along by their parent rigidbody
+	};
+
+	//Where one collider registry slot is stored in the world sets
+	struct ColliderSetEntry
+	{
+		u32 activeIndex = NULL_SET_INDEX;
+		u32 setIndex = NULL_SET_INDEX;
+		ColliderSet set{};
+	};
+
+	//every live collider, split into static and dynamic ones,
+	//kept in sync with the collider registry events instead of being rebuilt
+	static vector<Collider*> activeColliders{};
+	static vector<Collider*> staticColliders{};
+	static vector<Collider*> dynamicColliders{};
+	//registry slots of the colliders at the same index, removed colliders are only ever found through these
+	static vector<u32> activeSlots{};
+	static vector<u32> staticSlots{};
+	static vector<u32> dynamicSlots{};
+	//indexed by collider registry slot
+	static vector<ColliderSetEntry> colliderEntries{};
+	//what the broadphase has to do with its static tree at the next step
+	static StaticTreeUpdate staticUpdate = StaticTreeUpdate::STATIC_REBUILD;
+	//what the ray scenes have to do at the next step, they mask removed colliders themselves
+	//so only live colliders entering or leaving a set make them rebuild
+	static StaticTreeUpdate rayStaticUpdate = StaticTreeUpdate::STATIC_REBUILD;
+	static bool isRayDynamicSetChanged = true;
+
 	static array<string, MAX_LAYERS> layers{};
 	static u8 layerCount{};
 
-	static bool collisionMatrix[MAX_LAYERS][MAX_LAYERS]{};
+	//one row per layer, bit b of row a is set if layers a and b collide
+	static u32 collisionMasks[MAX_LAYERS]{};
+	//set whenever layers or collision rules change, the masks cached by colliders are refreshed at the next update
+	static bool areLayerMasksDirty{};
 
 	static vec3 gravity = vec3(0.0f, -9.81f, 0.0f);
 
+	static f32 fixedTimestep = DEFAULT_FIXED_TIMESTEP;
+	//simulation time that has not been stepped yet
+	static f32 accumulator{};
+	static f32 interpolationAlpha{};
+
+	//grows while contacts pile up, its whole part is the substep count
+	static f32 substepScale = 1.0f;
+
+	static PhysicsStepStats stepStats{};
+
+	//milliseconds since start
+	static f64 ElapsedMs(steady_clock::time_point start);
+
+	//Applies the collider registry events since the last update to the world sets, O(changes)
+	static void SyncColliderSets();
+	static void AddToSets(
+		u32 slot,
+		Collider* c,
+		ColliderSet set);
+	static void RemoveFromSets(u32 slot);
+
 	void PhysicsWorld::Update(f32 deltaTime)
 	{
-		//Can we even collide with this collider
-		auto _can_collide = [](Collider* c)
-			{
-				return !c || c->isTrigger;
-			};
+		//work done between two updates, like ray queries, is profiled into the frame of the first one
+		KP_PROFILE_NEXT_FRAME();
+		KP_PROFILE_SCOPE(ZONE_UPDATE);
+
+		//
+		// ENSURE ACTIVE COLLIDERS LIST IS UP TO DATE
+		//
+
+		{
+			KP_PROFILE_SCOPE(ZONE_ACTIVE_SET);
 
-		//Can this collider move?
-		auto _can_move = [&_can_collide](Collider* c)
+			//the ray scenes find removed colliders through the events this drains
+			Ray::MaskRemovedColliders();
+			SyncColliderSets();
+
+			if (areLayerMasksDirty)
 			{
-				//fast path to quickly check legitimate static models
-				if (!_can_collide(c)
-					|| isnear(gravity)
-					|| c->isStatic
-					|| c->parentRigidBody == 0)
-				{
-					return false;
-				}
+				for (Collider* c : activeColliders) c->RefreshLayerMasks();
 
-				RigidBody* rb = RigidBody::GetRegistry().GetContent(c->parentRigidBody);
+				//colliders on removed layers lost their layer bit
+				if (staticUpdate == StaticTreeUpdate::STATIC_KEEP) staticUpdate = StaticTreeUpdate::STATIC_REFIT;
+				if (rayStaticUpdate == StaticTreeUpdate::STATIC_KEEP) rayStaticUpdate = StaticTreeUpdate::STATIC_REFIT;
 
-				if (!rb) return false;
+				areLayerMasksDirty = false;
+			}
+		}
 
-				if (rb->vars.isSleeping
-					|| rb->vars.mass == 0
-					|| isnear(rb->vars.gravityScale)) return false;
+		//
+		// DRAIN THE ACCUMULATOR
+		//
 
-				return true;
-			};
+		//hits are reported per update, every step below appends its own
+		ProjectileStore::ClearHits();
+
+		//ignore paused, reversed or broken clocks
+		if (!(deltaTime > 0.0f)) return;
+
+		accumulator += deltaTime;
+
+		stepStats.steps = 0;
+		stepStats.droppedTime = 0.0f;
+
+		f32 maxTime = fixedTimestep * MAX_STEPS_PER_UPDATE;
+		if (accumulator > maxTime)
+		{
+			stepStats.droppedTime = accumulator - maxTime;
+			accumulator = maxTime;
+		}
+
+		while (accumulator >= fixedTimestep
+			&& stepStats.steps < MAX_STEPS_PER_UPDATE)
+		{
+			Step(fixedTimestep);
+
+			accumulator -= fixedTimestep;
+			++stepStats.steps;
+		}
 
-		//Can this collider rotate?
-		auto _can_rotate = [&_can_move](Collider* c)
+		interpolationAlpha = min(accumulator / fixedTimestep, 1.0f);
+
+		KP_PROFILE_SET(
+			COUNTER_SLEEPING_BODIES,
+			scast<u64>(count_if(
+				BodyStore::flags.begin(),
+				BodyStore::flags.end(),
+				[](u8 f) { return (f & BODY_FLAG_SLEEPING) != 0; })));
+	}
+
+	void PhysicsWorld::Step(f32 deltaTime)
+	{
+		KP_PROFILE_SCOPE(ZONE_STEP);
+		KP_PROFILE_COUNT(COUNTER_STEPS, 1);
+
+		steady_clock::time_point stepStart = steady_clock::now();
+
+		stepStats.narrowphaseTime = 0.0;
+		stepStats.solverTime = 0.0;
+		stepStats.integrateTime = 0.0;
+
+		//renderers blend from the state at the start of the step
+		BodyStore::StorePreviousState();
+
+		//only overlapping, layer-compatible pairs reach the narrowphase,
+		//see Broadphase::GetStats for how many potential pairs were culled
+		steady_clock::time_point start = steady_clock::now();
+		{
+			KP_PROFILE_SCOPE(ZONE_BROADPHASE);
+
+			Broadphase::Update(staticColliders, dynamicColliders, staticUpdate, realCollisions);
+			staticUpdate = StaticTreeUpdate::STATIC_KEEP;
+		}
+		stepStats.broadphaseTime = ElapsedMs(start);
+		KP_PROFILE_COUNT(COUNTER_BROADPHASE_PAIRS, realCollisions.size());
+
+		//handles real collisions
+		auto _collide = []()
 			{
-				//early skip if this collider can't even move
-				if (!_can_move(c)) return false;
+				KP_PROFILE_SCOPE(ZONE_NARROWPHASE);
 
-				//bounding sphere and aabb can never rotate
-				if (c->shape == ColliderShape::COLLIDER_BSP
-					|| c->shape == ColliderShape::COLLIDER_AABB)
-				{
-					return false;
-				}
+				steady_clock::time_point collideStart = steady_clock::now();
 
-				RigidBody* rb = RigidBody::GetRegistry().GetContent(c->parentRigidBody);
+				Narrowphase::Update(realCollisions);
 
-				if (isnear(rb->vars.inertiaTensor)) return false;
+				//carry impulses of pairs that were already touching over to this frame
+				PairCache::Update(Narrowphase::GetContacts());
 
-				return true;
+				stepStats.narrowphaseTime += ElapsedMs(collideStart);
 			};
 
+		_collide();
+
 		//
-		// ENSURE ACTIVE COLLIDERS LIST IS UP TO DATE
+		// PICK SUBSTEPS
 		//
 
-		//TODO: consider more efficient lookups in the future (unordered_set etc)
+		u32 contactCount{};
+		f32 maxPenetration{};
+		for (const auto& m : PairCache::GetManifolds())
+		{
+			if (m.pointCount == 0) continue;
 
-		//remove all existing invalid colliders from active colliders list
-		activeColliders.erase(remove_if(
-			activeColliders.begin(),
-			activeColliders.end(),
-			[](Collider* c)
+			++contactCount;
+			for (u8 p = 0; p < m.pointCount; p++)
 			{
-				return !c;
-			}), activeColliders.end());
+				maxPenetration = max(maxPenetration, m.points[p].depth);
+			}
+		}
 
-		//add new valid colliders to active colliders list
-		for (const auto& c : Collider::GetRegistry().runtimeContent)
+		if (contactCount >= COLLISION_THRESHOLD
+			|| maxPenetration > PENETRATION_THRESHOLD)
 		{
-			if (c
-				&& find(
-					activeColliders.begin(),
-					activeColliders.end(),
-					c)
-					== activeColliders.end())
-			{
-				activeColliders.push_back(c);
-			}
+			substepScale = min(substepScale * SUBSTEP_GROWTH_FACTOR, scast<f32>(MAX_SUBSTEPS));
 		}
+		else substepScale = max(substepScale / SUBSTEP_GROWTH_FACTOR, 1.0f);
+
+		u8 substeps = scast<u8>(substepScale);
+
+		stepStats.substeps = substeps;
+		stepStats.contactCount = contactCount;
+		stepStats.maxPenetration = maxPenetration;
+
+		KP_PROFILE_COUNT(COUNTER_SUBSTEPS, substeps);
+		KP_PROFILE_COUNT(COUNTER_CONTACTS, contactCount);
 
 		//
-		// BEGIN COLLISION AND MOTION
+		// SUBSTEPS
 		//
 
-		struct ColliderPair
+		f32 subDelta = deltaTime / substeps;
+
+		for (u8 ss = 0; ss < substeps; ss++)
 		{
-			Collider* a{};
-			Collider* b{};
-		};
+			//the first substep reuses the contacts gathered above,
+			//later ones reuse the broadphase pairs whose fat bounds cover the small substep motion
+			if (ss > 0) _collide();
 
-		vector<ColliderPair> realCollisions{};
+			//gravity first so the solver sees this step's velocities, positions only move by solved velocities
+			start = steady_clock::now();
+			{
+				KP_PROFILE_SCOPE(ZONE_INTEGRATE);
+				BodyStore::IntegrateVelocities(subDelta, gravity);
+			}
+			stepStats.integrateTime += ElapsedMs(start);
 
-		//handles real collisions and motion
-		auto _collide = [&realCollisions, &deltaTime](u8 substeps)
+			start = steady_clock::now();
 			{
-				int ss = substeps;
-			
-				while (ss > 0)
-				{
-					for (auto& c : realCollisions)
-					{
-						switch (c.a->shape)
-						{
-						case ColliderShape::COLLIDER_BSP:
-						{
-							Collider_BSP* col = scast<Collider_BSP*>(c.a);
-							col->Update(c.b, deltaTime);
-							break;
-						}
-						case ColliderShape::COLLIDER_AABB:
-						{
-							Collider_AABB* col = scast<Collider_AABB*>(c.a);
-							col->Update(c.b, deltaTime);
-							break;
-						}
-						case ColliderShape::COLLIDER_OBB:
-						{
-							Collider_OBB* col = scast<Collider_OBB*>(c.a);
-							col->Update(c.b, deltaTime);
-							break;
-						}
-						case ColliderShape::COLLIDER_BCP:
-						{
-							Collider_BCP* col = scast<Collider_BCP*>(c.a);
-							col->Update(c.b, deltaTime);
-							break;
-						}
-
-						case ColliderShape::COLLIDER_KDOP_10_X:
-						case ColliderShape::COLLIDER_KDOP_10_Y:
-						case ColliderShape::COLLIDER_KDOP_10_Z:
-						case ColliderShape::COLLIDER_KDOP_18:
-						case ColliderShape::COLLIDER_KDOP_26:
-						{
-							Collider_KDOP* col = scast<Collider_KDOP*>(c.a);
-							col->Update(c.b, deltaTime);
-							break;
-						}
-
-						case ColliderShape::COLLIDER_BCH:
-						{
-							Collider_BCH* col = scast<Collider_BCH*>(c.a);
-							col->Update(c.b, deltaTime);
-							break;
-						}
-						}
-					}
-				}
-			};
+				KP_PROFILE_SCOPE(ZONE_SOLVER);
+				ContactSolver::Solve(subDelta);
+			}
+			stepStats.solverTime += ElapsedMs(start);
 
-		//TODO: consider faster iterations in the future than this pairwise loop
+			start = steady_clock::now();
+			{
+				KP_PROFILE_SCOPE(ZONE_INTEGRATE);
+				BodyStore::IntegratePositions(subDelta);
+			}
+			stepStats.integrateTime += ElapsedMs(start);
+		}
 
-		//only handle collisions if there are more than 1 colliders active
-		if (activeColliders.size() > 1)
+		//fast flagged bodies are pulled back to whatever they passed through during the step
+		steady_clock::time_point ccdStart = steady_clock::now();
 		{
-			for (const auto& c1 : activeColliders)
-			{
-				for (const auto& c2 : activeColliders)
-				{
-					if (c1 == c2) continue; //skip self-collision
+			KP_PROFILE_SCOPE(ZONE_CCD);
+			ContinuousCollision::Resolve(deltaTime);
+		}
+		stepStats.ccdTime = ElapsedMs(ccdStart);
 
-					if (CanCollide(c1->layer, c2->layer))
-					{
-						realCollisions.push_back({ c1, c2 });
-					}
-				}
-			}
+		//resting islands fall asleep and leave the broadphase update from the next step on
+		{
+			KP_PROFILE_SCOPE(ZONE_SLEEPING);
+			ContactSolver::UpdateSleeping(deltaTime);
 		}
 
-		u8 substeps = 1;
+		//rays issued until the next step see the final poses of this one
+		{
+			KP_PROFILE_SCOPE(ZONE_RAY_SCENE);
+			Ray::UpdateScene(staticColliders, dynamicColliders, rayStaticUpdate, isRayDynamicSetChanged);
+			rayStaticUpdate = StaticTreeUpdate::STATIC_KEEP;
+			isRayDynamicSetChanged = false;
+		}
 
-		if (realCollisions.size() >= COLLISION_THRESHOLD)
+		steady_clock::time_point projectileStart = steady_clock::now();
 		{
-			substeps = scast<u8>(substeps * SUBSTEP_GROWTH_FACTOR);
-			substeps = min(substeps, MAX_SUBSTEPS);
+			KP_PROFILE_SCOPE(ZONE_PROJECTILES);
+			ProjectileStore::Update(deltaTime, gravity);
 		}
+		stepStats.projectileTime = ElapsedMs(projectileStart);
 
-		_collide(substeps);
+		stepStats.stepTime = ElapsedMs(stepStart);
+	}
+
+	f32 PhysicsWorld::GetFixedTimestep() { return fixedTimestep; }
+	void PhysicsWorld::SetFixedTimestep(f32 newValue)
+	{
+		fixedTimestep = clamp(
+			newValue,
+			MIN_FIXED_TIMESTEP,
+			MAX_FIXED_TIMESTEP);
 	}
 
+	f32 PhysicsWorld::GetInterpolationAlpha() { return interpolationAlpha; }
+
+	const PhysicsStepStats& PhysicsWorld::GetStepStats() { return stepStats; }
+
 	u64 PhysicsWorld::GetLayerCount() { return layerCount; }
 
 	void PhysicsWorld::AddLayer(const string& layer)
@@ -276,12 +398,30 @@ namespace KalaPhysics::Core
 			return;
 		}
 
-		layers[layerIndex] = layers[--layerCount];
+		u8 last = --layerCount;
+		u32 lastBit = 1u << last;
+		u32 removedBit = 1u << layerIndex;
+
+		//the last layer takes over the removed index, so its rules move along with it
+		for (u8 i = 0; i <= last; i++)
+		{
+			u32& row = collisionMasks[i];
+			u32 moved = layerIndex != last && (row & lastBit) ? removedBit : 0u;
+
+			row = (row & ~(lastBit | removedBit)) | moved;
+		}
+		collisionMasks[layerIndex] = collisionMasks[last];
+		collisionMasks[last] = 0;
+
+		layers[layerIndex] = layers[last];
+		areLayerMasksDirty = true;
 	}
 	void PhysicsWorld::RemoveAllLayers()
 	{
 		for (auto& l : layers) l.clear();
+		for (u32& row : collisionMasks) row = 0;
 		layerCount = 0;
+		areLayerMasksDirty = true;
 	}
 
 	const string& PhysicsWorld::GetLayer(u8 layer)
@@ -307,7 +447,7 @@ namespace KalaPhysics::Core
 		u8 b,
 		bool value)
 	{
-		if (GetLayer(a) == "NONE")
+		if (a >= layerCount)
 		{
 			Log::Print(
 				"Cannot set collision rule because the first layer does not exist!",
@@ -317,7 +457,7 @@ namespace KalaPhysics::Core
 
 			return;
 		}
-		if (GetLayer(b) == "NONE")
+		if (b >= layerCount)
 		{
 			Log::Print(
 				"Cannot set collision rule because the second layer does not exist!",
@@ -328,14 +468,24 @@ namespace KalaPhysics::Core
 			return;
 		}
 
-		collisionMatrix[a][b] = value;
-		collisionMatrix[b][a] = value;
+		if (value)
+		{
+			collisionMasks[a] |= 1u << b;
+			collisionMasks[b] |= 1u << a;
+		}
+		else
+		{
+			collisionMasks[a] &= ~(1u << b);
+			collisionMasks[b] &= ~(1u << a);
+		}
+
+		areLayerMasksDirty = true;
 	}
 	bool PhysicsWorld::CanCollide(
 		u8 a,
 		u8 b)
 	{
-		if (GetLayer(a) == "NONE")
+		if (a >= layerCount)
 		{
 			Log::Print(
 				"Cannot check collision state because the first layer does not exist!",
@@ -345,7 +495,7 @@ namespace KalaPhysics::Core
 
 			return false;
 		}
-		if (GetLayer(b) == "NONE")
+		if (b >= layerCount)
 		{
 			Log::Print(
 				"Cannot check collision state because the second layer does not exist!",
@@ -356,9 +506,128 @@ namespace KalaPhysics::Core
 			return false;
 		}
 
-		return collisionMatrix[a][b];
+		return (collisionMasks[a] >> b) & 1u;
+	}
+	u32 PhysicsWorld::GetCollisionMask(u8 layer)
+	{
+		return layer < layerCount
+			? collisionMasks[layer]
+			: 0u;
 	}
 
 	const vec3& PhysicsWorld::GetGravity() { return gravity; }
-	void PhysicsWorld::SetGravity(const vec3& newValue) { gravity = kclamp(newValue, vec3(0.0f), MAX_GRAVITY); }
+	void PhysicsWorld::SetGravity(const vec3& newValue) { gravity = kclamp(newValue, vec3(0.0f) - MAX_GRAVITY, MAX_GRAVITY); }
+
+	f64 ElapsedMs(steady_clock::time_point start)
+	{
+		return duration<f64, milli>(steady_clock::now() - start).count();
+	}
+
+	void SyncColliderSets()
+	{
+		Collider::GetRegistry().DrainEvents(
+			[](u32 slot, u8 events, Collider* c)
+			{
+				if (slot >= colliderEntries.size()) colliderEntries.resize(scast<size_t>(slot) + 1);
+
+				ColliderSet set = ColliderSet::SET_NONE;
+				if (c)
+				{
+					set = c->IsStatic() || c->GetParentRigidBody() == 0
+						? ColliderSet::SET_STATIC
+						: ColliderSet::SET_DYNAMIC;
+				}
+
+				ColliderSet oldSet = colliderEntries[slot].set;
+
+				//state changes that leave the same collider in the same set need no work,
+				//a removed collider may already have been replaced by a new one in its slot
+				if (!(events & REGISTRY_EVENT_REMOVED)
+					&& set == oldSet)
+				{
+					//static colliders that moved or changed layer only need the static tree refitted
+					if (set == ColliderSet::SET_STATIC)
+					{
+						if (staticUpdate == StaticTreeUpdate::STATIC_KEEP) staticUpdate = StaticTreeUpdate::STATIC_REFIT;
+						if (rayStaticUpdate == StaticTreeUpdate::STATIC_KEEP) rayStaticUpdate = StaticTreeUpdate::STATIC_REFIT;
+					}
+
+					return;
+				}
+
+				if (oldSet == ColliderSet::SET_STATIC
+					|| set == ColliderSet::SET_STATIC)
+				{
+					staticUpdate = StaticTreeUpdate::STATIC_REBUILD;
+				}
+
+				//removed colliders were masked out of the ray scenes already
+				bool isRemoved = (events & REGISTRY_EVENT_REMOVED) != 0;
+				if (set == ColliderSet::SET_STATIC
+					|| (oldSet == ColliderSet::SET_STATIC && !isRemoved))
+				{
+					rayStaticUpdate = StaticTreeUpdate::STATIC_REBUILD;
+				}
+				if (set == ColliderSet::SET_DYNAMIC
+					|| (oldSet == ColliderSet::SET_DYNAMIC && !isRemoved))
+				{
+					isRayDynamicSetChanged = true;
+				}
+
+				RemoveFromSets(slot);
+				if (c) AddToSets(slot, c, set);
+			});
+	}
+
+	void AddToSets(
+		u32 slot,
+		Collider* c,
+		ColliderSet set)
+	{
+		ColliderSetEntry& entry = colliderEntries[slot];
+
+		entry.activeIndex = scast<u32>(activeColliders.size());
+		activeColliders.push_back(c);
+		activeSlots.push_back(slot);
+
+		vector<Collider*>& colliders = set == ColliderSet::SET_STATIC ? staticColliders : dynamicColliders;
+		vector<u32>& slots = set == ColliderSet::SET_STATIC ? staticSlots : dynamicSlots;
+
+		entry.set = set;
+		entry.setIndex = scast<u32>(colliders.size());
+		colliders.push_back(c);
+		slots.push_back(slot);
+	}
+
+	void RemoveFromSets(u32 slot)
+	{
+		ColliderSetEntry& entry = colliderEntries[slot];
+		if (entry.set == ColliderSet::SET_NONE) return;
+
+		//swap-remove, the moved collider is patched through its slot and never dereferenced
+		u32 last = scast<u32>(activeColliders.size() - 1);
+		if (entry.activeIndex != last)
+		{
+			activeColliders[entry.activeIndex] = activeColliders[last];
+			activeSlots[entry.activeIndex] = activeSlots[last];
+			colliderEntries[activeSlots[last]].activeIndex = entry.activeIndex;
+		}
+		activeColliders.pop_back();
+		activeSlots.pop_back();
+
+		vector<Collider*>& colliders = entry.set == ColliderSet::SET_STATIC ? staticColliders : dynamicColliders;
+		vector<u32>& slots = entry.set == ColliderSet::SET_STATIC ? staticSlots : dynamicSlots;
+
+		last = scast<u32>(colliders.size() - 1);
+		if (entry.setIndex != last)
+		{
+			colliders[entry.setIndex] = colliders[last];
+			slots[entry.setIndex] = slots[last];
+			colliderEntries[slots[last]].setIndex = entry.setIndex;
+		}
+		colliders.pop_back();
+		slots.pop_back();
+
+		entry = {};
+	}
 }
\ No newline at end of file
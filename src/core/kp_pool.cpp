@@ -0,0 +1,89 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <new>
+#include <algorithm>
+
+#include "core/kp_pool.hpp"
+
+using std::max;
+using std::align_val_t;
+
+namespace KalaPhysics::Core
+{
+	BlockPool::BlockPool(
+		size_t blockSize,
+		size_t blockAlign,
+		u32 chunkBlocks)
+	{
+		this->blockAlign = max(blockAlign, alignof(FreeBlock));
+
+		//every block has to fit a free list link and keep the next block aligned
+		size_t size = max(blockSize, sizeof(FreeBlock));
+		this->blockSize = (size + this->blockAlign - 1) / this->blockAlign * this->blockAlign;
+
+		this->chunkBlocks = max(chunkBlocks, 1u);
+	}
+	BlockPool::~BlockPool()
+	{
+		//blocks still handed out would dangle, leak the chunks instead
+		if (freeCount != capacity) return;
+
+		for (void* c : chunks)
+		{
+			::operator delete(c, align_val_t(blockAlign));
+		}
+	}
+
+	void* BlockPool::Allocate()
+	{
+		if (!freeList) AddChunk(chunkBlocks);
+
+		FreeBlock* block = freeList;
+		freeList = block->next;
+		--freeCount;
+
+		return block;
+	}
+	void BlockPool::Free(void* block)
+	{
+		if (!block) return;
+
+		FreeBlock* b = scast<FreeBlock*>(block);
+		b->next = freeList;
+		freeList = b;
+		++freeCount;
+	}
+
+	void BlockPool::Reserve(u32 count)
+	{
+		if (count > freeCount) AddChunk(count - freeCount);
+	}
+
+	size_t BlockPool::GetBlockSize() const { return blockSize; }
+	u32 BlockPool::GetLiveCount() const { return capacity - freeCount; }
+	u32 BlockPool::GetCapacity() const { return capacity; }
+	u32 BlockPool::GetChunkCount() const { return scast<u32>(chunks.size()); }
+
+	void BlockPool::AddChunk(u32 blocks)
+	{
+		char* chunk = scast<char*>(::operator new(
+			blockSize * blocks,
+			align_val_t(blockAlign)));
+
+		chunks.push_back(chunk);
+
+		//link backwards so blocks are handed out in address order
+		for (u32 i = blocks; i-- > 0;)
+		{
+			FreeBlock* b = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+			b->next = freeList;
+			freeList = b;
+		}
+
+		freeCount += blocks;
+		capacity += blocks;
+	}
+}
\ No newline at end of file
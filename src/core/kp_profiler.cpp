@@ -0,0 +1,370 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include "core/kp_profiler.hpp"
+
+#ifdef KP_PROFILER_ENABLED
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <fstream>
+#include <algorithm>
+
+#include "log_utils.hpp"
+
+using KalaHeaders::KalaLog::Log;
+using KalaHeaders::KalaLog::LogType;
+
+using std::atomic;
+using std::atomic_thread_fence;
+using std::unique_ptr;
+using std::make_unique;
+using std::ofstream;
+using std::to_string;
+using std::min;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::memory_order_relaxed;
+
+namespace KalaPhysics::Core
+{
+	constexpr size_t COUNTER_COUNT = scast<size_t>(ProfileCounter::COUNTER_COUNT);
+
+	//One ring buffer entry, sequence is the index of the frame it holds
+	//and 0 while the owner thread is writing it
+	struct FrameSlot
+	{
+		atomic<u64> sequence{};
+		ProfileFrame frame{};
+	};
+
+	struct OpenScope
+	{
+		u64 start{};
+		ProfileZone zone{};
+	};
+
+	static atomic<bool> isEnabled{};
+
+	//allocated on first enable and never freed, so readers never see it move
+	static unique_ptr<FrameSlot[]> slots{};
+	static atomic<u64> latestFrame{};
+
+	//counters of the running frame, added to from any thread
+	static atomic<u64> liveCounters[COUNTER_COUNT]{};
+
+	//thread that records scopes, the last one that called NextFrame
+	static atomic<u32> ownerThread{};
+	static atomic<u32> nextThreadIndex = 1;
+	static thread_local u32 threadIndex{};
+
+	//everything below is only touched by the owner thread
+
+	static steady_clock::time_point epoch{};
+	//frame being recorded, null between SetEnabled(false) and the next NextFrame
+	static ProfileFrame* running{};
+	static OpenScope openScopes[MAX_PROFILE_DEPTH]{};
+	static u32 openScopeCount{};
+
+	static u64 NowNs();
+	static u32 GetThreadIndex();
+
+	f64 ProfileFrame::GetZoneTime(ProfileZone zone) const
+	{
+		u64 total{};
+		for (u32 i = 0; i < scopeCount; i++)
+		{
+			if (scopes[i].zone == zone) total += scopes[i].duration;
+		}
+
+		return scast<f64>(total) / 1e6;
+	}
+	u64 ProfileFrame::GetCounter(ProfileCounter counter) const { return counters[scast<size_t>(counter)]; }
+
+	void Profiler::SetEnabled(bool newValue)
+	{
+		if (newValue == isEnabled.load(memory_order_relaxed)) return;
+
+		if (newValue
+			&& !slots)
+		{
+			slots = make_unique<FrameSlot[]>(PROFILER_FRAME_CAPACITY);
+			epoch = steady_clock::now();
+		}
+
+		//the unfinished frame is dropped, the next NextFrame starts a fresh one
+		running = nullptr;
+		openScopeCount = 0;
+		for (auto& c : liveCounters) c.store(0, memory_order_relaxed);
+
+		isEnabled.store(newValue, memory_order_release);
+	}
+	bool Profiler::IsEnabled() { return isEnabled.load(memory_order_relaxed); }
+
+	void Profiler::NextFrame()
+	{
+		if (!isEnabled.load(memory_order_acquire)) return;
+
+		ownerThread.store(GetThreadIndex(), memory_order_relaxed);
+
+		u64 now = NowNs();
+		u64 index = latestFrame.load(memory_order_relaxed);
+
+		if (running)
+		{
+			running->duration = now - running->start;
+			for (size_t i = 0; i < COUNTER_COUNT; i++)
+			{
+				running->counters[i] = liveCounters[i].exchange(0, memory_order_relaxed);
+			}
+
+			slots[running->index % PROFILER_FRAME_CAPACITY].sequence.store(running->index, memory_order_release);
+			latestFrame.store(running->index, memory_order_release);
+
+			index = running->index;
+		}
+
+		//readers reject the slot as soon as they see the cleared sequence,
+		//the fence keeps the writes below from becoming visible before it
+		FrameSlot& slot = slots[(index + 1) % PROFILER_FRAME_CAPACITY];
+		slot.sequence.store(0, memory_order_relaxed);
+		atomic_thread_fence(memory_order_release);
+
+		running = &slot.frame;
+		running->index = index + 1;
+		running->start = now;
+		running->duration = 0;
+		running->scopeCount = 0;
+		running->droppedScopes = 0;
+		running->counters = {};
+
+		//scopes still open from the last frame are never closed into this one
+		openScopeCount = 0;
+	}
+
+	bool Profiler::BeginScope(ProfileZone zone)
+	{
+		if (!isEnabled.load(memory_order_relaxed)
+			|| GetThreadIndex() != ownerThread.load(memory_order_relaxed)
+			|| !running)
+		{
+			return false;
+		}
+
+		if (openScopeCount >= MAX_PROFILE_DEPTH)
+		{
+			++running->droppedScopes;
+			return false;
+		}
+
+		openScopes[openScopeCount++] = { NowNs(), zone };
+
+		return true;
+	}
+	void Profiler::EndScope()
+	{
+		if (openScopeCount == 0
+			|| !running)
+		{
+			return;
+		}
+
+		const OpenScope& scope = openScopes[--openScopeCount];
+
+		if (running->scopeCount >= MAX_PROFILE_SCOPES)
+		{
+			++running->droppedScopes;
+			return;
+		}
+
+		running->scopes[running->scopeCount++] =
+		{
+			scope.start - running->start,
+			NowNs() - scope.start,
+			scope.zone,
+			scast<u8>(openScopeCount)
+		};
+	}
+
+	void Profiler::AddCounter(
+		ProfileCounter counter,
+		u64 value)
+	{
+		liveCounters[scast<size_t>(counter)].fetch_add(value, memory_order_relaxed);
+	}
+	void Profiler::SetCounter(
+		ProfileCounter counter,
+		u64 value)
+	{
+		liveCounters[scast<size_t>(counter)].store(value, memory_order_relaxed);
+	}
+
+	u64 Profiler::GetLatestFrameIndex() { return latestFrame.load(memory_order_acquire); }
+
+	bool Profiler::GetFrame(
+		u64 index,
+		ProfileFrame& outFrame)
+	{
+		u64 latest = latestFrame.load(memory_order_acquire);
+		if (index == 0
+			|| index > latest
+			|| latest - index >= PROFILER_FRAME_CAPACITY)
+		{
+			return false;
+		}
+
+		const FrameSlot& slot = slots[index % PROFILER_FRAME_CAPACITY];
+		if (slot.sequence.load(memory_order_acquire) != index) return false;
+
+		outFrame = slot.frame;
+
+		//the owner thread may have started overwriting the slot while it was copied
+		atomic_thread_fence(memory_order_acquire);
+		return slot.sequence.load(memory_order_relaxed) == index;
+	}
+	void Profiler::GetFrames(
+		u32 count,
+		vector<ProfileFrame>& outFrames)
+	{
+		outFrames.clear();
+
+		u64 latest = GetLatestFrameIndex();
+		u64 available = min<u64>(min<u64>(count, PROFILER_FRAME_CAPACITY), latest);
+
+		ProfileFrame frame{};
+		for (u64 index = latest - available + 1; index <= latest; index++)
+		{
+			if (GetFrame(index, frame)) outFrames.push_back(frame);
+		}
+	}
+
+	bool Profiler::ExportChromeTrace(
+		const string& filePath,
+		u32 frameCount)
+	{
+		vector<ProfileFrame> frames{};
+		GetFrames(frameCount, frames);
+
+		if (frames.empty())
+		{
+			Log::Print(
+				"Cannot export chrome trace to '" + filePath + "' because no profiler frames were recorded!",
+				"PROFILER",
+				LogType::LOG_ERROR,
+				2);
+
+			return false;
+		}
+
+		ofstream file(filePath);
+		if (!file.is_open())
+		{
+			Log::Print(
+				"Cannot export chrome trace because '" + filePath + "' could not be opened for writing!",
+				"PROFILER",
+				LogType::LOG_ERROR,
+				2);
+
+			return false;
+		}
+
+		//trace event timestamps and durations are in microseconds
+		auto _us = [](u64 ns) { return to_string(scast<f64>(ns) / 1000.0); };
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		bool isFirst = true;
+		auto _event = [&](const string& json)
+			{
+				if (!isFirst) file << ",\n";
+				file << json;
+				isFirst = false;
+			};
+
+		for (const ProfileFrame& f : frames)
+		{
+			_event(
+				"{\"name\":\"Frame " + to_string(f.index)
+				+ "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" + _us(f.start)
+				+ ",\"dur\":" + _us(f.duration)
+				+ ",\"args\":{\"droppedScopes\":" + to_string(f.droppedScopes) + "}}");
+
+			for (u32 i = 0; i < f.scopeCount; i++)
+			{
+				const ProfileScope& s = f.scopes[i];
+
+				_event(
+					"{\"name\":\"" + string(GetZoneName(s.zone))
+					+ "\",\"cat\":\"physics\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" + _us(f.start + s.start)
+					+ ",\"dur\":" + _us(s.duration) + "}");
+			}
+
+			for (size_t i = 0; i < COUNTER_COUNT; i++)
+			{
+				const char* name = GetCounterName(scast<ProfileCounter>(i));
+
+				_event(
+					"{\"name\":\"" + string(name)
+					+ "\",\"ph\":\"C\",\"pid\":1,\"ts\":" + _us(f.start)
+					+ ",\"args\":{\"" + string(name) + "\":" + to_string(f.counters[i]) + "}}");
+			}
+		}
+
+		file << "\n]}\n";
+
+		return file.good();
+	}
+
+	const char* Profiler::GetZoneName(ProfileZone zone)
+	{
+		switch (zone)
+		{
+		case ProfileZone::ZONE_UPDATE: return "Update";
+		case ProfileZone::ZONE_ACTIVE_SET: return "ActiveSet";
+		case ProfileZone::ZONE_STEP: return "Step";
+		case ProfileZone::ZONE_BROADPHASE: return "Broadphase";
+		case ProfileZone::ZONE_NARROWPHASE: return "Narrowphase";
+		case ProfileZone::ZONE_SOLVER: return "Solver";
+		case ProfileZone::ZONE_INTEGRATE: return "Integrate";
+		case ProfileZone::ZONE_CCD: return "CCD";
+		case ProfileZone::ZONE_SLEEPING: return "Sleeping";
+		case ProfileZone::ZONE_RAY_SCENE: return "RayScene";
+		case ProfileZone::ZONE_RAY_QUERY: return "RayQuery";
+		case ProfileZone::ZONE_PROJECTILES: return "Projectiles";
+		default: return "Unknown";
+		}
+	}
+	const char* Profiler::GetCounterName(ProfileCounter counter)
+	{
+		switch (counter)
+		{
+		case ProfileCounter::COUNTER_STEPS: return "steps";
+		case ProfileCounter::COUNTER_SUBSTEPS: return "substeps";
+		case ProfileCounter::COUNTER_BROADPHASE_PAIRS: return "broadphasePairs";
+		case ProfileCounter::COUNTER_CONTACTS: return "contacts";
+		case ProfileCounter::COUNTER_SLEEPING_BODIES: return "sleepingBodies";
+		case ProfileCounter::COUNTER_GJK_ITERATIONS: return "gjkIterations";
+		case ProfileCounter::COUNTER_RAY_QUERIES: return "rayQueries";
+		default: return "unknown";
+		}
+	}
+
+	u64 NowNs()
+	{
+		return scast<u64>(duration_cast<nanoseconds>(steady_clock::now() - epoch).count());
+	}
+
+	u32 GetThreadIndex()
+	{
+		if (threadIndex == 0) threadIndex = nextThreadIndex.fetch_add(1, memory_order_relaxed);
+		return threadIndex;
+	}
+}
+
+#endif
\ No newline at end of file
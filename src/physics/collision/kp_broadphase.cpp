@@ -0,0 +1,419 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+
+#include "physics/collision/kp_broadphase.hpp"
+#include "physics/collision/kp_collider.hpp"
+#include "physics/kp_rigidbody.hpp"
+
+using KalaPhysics::Physics::RigidBody;
+
+using std::vector;
+
+namespace KalaPhysics::Physics::Collision
+{
+	struct ProxyData
+	{
+		ColliderBounds bounds{}; //tight bounds of the last update
+		u32 lastFrame{};         //last frame this proxy was refreshed
+		bool isSleeping{};       //owner body was asleep at the last update
+	};
+
+	static BroadphaseType type = BroadphaseType::BROADPHASE_DYNAMIC_TREE;
+	static BroadphaseStats stats{};
+
+	//bumped whenever all proxies are dropped so colliders know their proxy ID is stale
+	static u32 epoch = 1;
+	static u32 frame{};
+
+	static DynamicTree tree{};
+	static SweepAndPrune sap{};
+	static SpatialHash hash{};
+
+	//static colliders, kept apart from the proxies of the active type
+	static ColliderBVH staticTree{};
+	//false until the static tree is built and again after Clear
+	static bool isStaticTreeBuilt{};
+
+	//indexed by the proxy ID of the active broadphase
+	static vector<ProxyData> proxyData{};
+	//every proxy ID currently in the active broadphase, in insertion order
+	static vector<i32> liveProxies{};
+
+	static bool IsSleeping(const Collider* c);
+	static Collider* GetProxyCollider(i32 proxyID);
+	static i32 CreateProxy(
+		const ColliderBounds& bounds,
+		Collider* c);
+	static void DestroyProxy(i32 proxyID);
+
+	void Broadphase::SetType(BroadphaseType newType)
+	{
+		if (newType == type) return;
+
+		Clear();
+		type = newType;
+	}
+	BroadphaseType Broadphase::GetType() { return type; }
+
+	void Broadphase::SetHashCellSize(f32 newValue) { hash.SetCellSize(newValue); }
+	f32 Broadphase::GetHashCellSize() { return hash.GetCellSize(); }
+
+	const SpatialHashStats& Broadphase::GetHashStats() { return hash.GetStats(); }
+
+	const BroadphaseStats& Broadphase::GetStats() { return stats; }
+	bool Broadphase::MeetsCullTarget() { return stats.cullRatio >= BROADPHASE_CULL_TARGET; }
+
+	void Broadphase::Clear()
+	{
+		tree.Clear();
+		sap.Clear();
+		hash.Clear();
+		proxyData.clear();
+		liveProxies.clear();
+
+		staticTree.Clear();
+		isStaticTreeBuilt = false;
+
+		stats = {};
+		++epoch;
+	}
+
+	void Broadphase::Update(
+		const vector<Collider*>& staticColliders,
+		const vector<Collider*>& dynamicColliders,
+		StaticTreeUpdate staticUpdate,
+		vector<ColliderPair>& outPairs)
+	{
+		outPairs.clear();
+		++frame;
+
+		stats = {};
+
+		//
+		// STATIC TREE
+		//
+
+		//a cleared broadphase has no tree left to keep or refit
+		if (!isStaticTreeBuilt) staticUpdate = StaticTreeUpdate::STATIC_REBUILD;
+
+		switch (staticUpdate)
+		{
+		case StaticTreeUpdate::STATIC_KEEP:
+			break;
+		case StaticTreeUpdate::STATIC_REFIT:
+			staticTree.Refit();
+			break;
+		case StaticTreeUpdate::STATIC_REBUILD:
+			staticTree.Build(staticColliders);
+			isStaticTreeBuilt = true;
+			break;
+		}
+
+		stats.staticUpdate = staticUpdate;
+		stats.staticColliderCount = staticTree.GetItemCount();
+
+		//
+		// REFRESH PROXIES
+		//
+
+		for (Collider* c : dynamicColliders)
+		{
+			if (!c) continue;
+
+			//the stored proxy is only trusted if the broadphase still maps it back to this collider
+			bool hasProxy = c->proxyEpoch == epoch
+				&& GetProxyCollider(c->proxyID) == c;
+
+			bool isSleeping = IsSleeping(c);
+
+			//layer changes reach the tree node masks even while the body sleeps
+			if (hasProxy
+				&& type == BroadphaseType::BROADPHASE_DYNAMIC_TREE)
+			{
+				tree.SetProxyMask(c->proxyID, c->layerBit);
+			}
+
+			//sleeping bodies don't move, their proxy is kept alive without touching the broadphase
+			if (hasProxy
+				&& isSleeping)
+			{
+				proxyData[c->proxyID].isSleeping = true;
+				proxyData[c->proxyID].lastFrame = frame;
+				continue;
+			}
+
+			ColliderBounds bounds = c->GetBounds();
+
+			if (!hasProxy)
+			{
+				c->proxyID = CreateProxy(bounds, c);
+				c->proxyEpoch = epoch;
+
+				if (scast<size_t>(c->proxyID) >= proxyData.size())
+				{
+					proxyData.resize(scast<size_t>(c->proxyID) + 1);
+				}
+
+				liveProxies.push_back(c->proxyID);
+			}
+			else
+			{
+				//skip duplicate entries
+				if (proxyData[c->proxyID].lastFrame == frame) continue;
+
+				switch (type)
+				{
+				case BroadphaseType::BROADPHASE_DYNAMIC_TREE:
+					if (tree.MoveProxy(c->proxyID, bounds, BROADPHASE_FAT_MARGIN))
+					{
+						++stats.reinsertedProxies;
+					}
+					break;
+				case BroadphaseType::BROADPHASE_SWEEP_AND_PRUNE:
+					sap.MoveProxy(c->proxyID, bounds);
+					break;
+				case BroadphaseType::BROADPHASE_SPATIAL_HASH:
+					hash.MoveProxy(c->proxyID, bounds);
+					break;
+				}
+			}
+
+			proxyData[c->proxyID].bounds = bounds;
+			proxyData[c->proxyID].lastFrame = frame;
+			proxyData[c->proxyID].isSleeping = isSleeping;
+		}
+
+		//drop proxies whose colliders were not passed this frame,
+		//their collider pointers may already be dangling so they are never dereferenced
+		size_t kept = 0;
+		for (i32 id : liveProxies)
+		{
+			if (proxyData[id].lastFrame == frame) liveProxies[kept++] = id;
+			else DestroyProxy(id);
+		}
+		liveProxies.resize(kept);
+
+		//
+		// GENERATE PAIRS
+		//
+
+		stats.colliderCount = scast<u32>(liveProxies.size()) + stats.staticColliderCount;
+		stats.potentialPairs = scast<u64>(stats.colliderCount)
+			* (stats.colliderCount > 0 ? stats.colliderCount - 1 : 0) / 2;
+
+		switch (type)
+		{
+		case BroadphaseType::BROADPHASE_DYNAMIC_TREE:
+		{
+			for (i32 id : liveProxies)
+			{
+				//sleeping proxies never query, their pairs with awake proxies are found from the awake side
+				if (proxyData[id].isSleeping) continue;
+
+				const ColliderBounds& bounds = proxyData[id].bounds;
+				Collider* a = tree.GetCollider(id);
+
+				//subtrees without a layer this collider collides with are skipped whole
+				tree.Query(bounds, a->collisionMask, [&](i32 other)
+					{
+						//every pair between awake proxies is found from both sides, only keep one of them
+						if (other <= id
+							&& !proxyData[other].isSleeping)
+						{
+							return true;
+						}
+
+						if (bounds.Overlaps(proxyData[other].bounds))
+						{
+							AcceptPair(a, tree.GetCollider(other), outPairs);
+						}
+
+						return true;
+					});
+			}
+			break;
+		}
+		case BroadphaseType::BROADPHASE_SWEEP_AND_PRUNE:
+		{
+			sap.SortEndpoints();
+			stats.endpointSwaps = sap.GetSwapCount();
+
+			sap.FindPairs([&outPairs](i32 a, i32 b)
+				{
+					AcceptPair(sap.GetCollider(a), sap.GetCollider(b), outPairs);
+				});
+			break;
+		}
+		case BroadphaseType::BROADPHASE_SPATIAL_HASH:
+		{
+			hash.Build();
+
+			hash.FindPairs([&outPairs](i32 a, i32 b)
+				{
+					AcceptPair(hash.GetCollider(a), hash.GetCollider(b), outPairs);
+				});
+			break;
+		}
+		}
+
+		//sleeping proxies can't reach a static collider, awake ones look up every static collider they overlap
+		for (i32 id : liveProxies)
+		{
+			if (proxyData[id].isSleeping) continue;
+
+			Collider* a = GetProxyCollider(id);
+
+			staticTree.Query(
+				proxyData[id].bounds,
+				a->collisionMask,
+				[&](Collider* b)
+				{
+					AcceptStaticPair(a, b, outPairs);
+					return true;
+				});
+		}
+
+		stats.acceptedPairs = outPairs.size();
+		stats.cullRatio = stats.potentialPairs > 0
+			? 1.0f - scast<f32>(scast<f64>(stats.acceptedPairs) / scast<f64>(stats.potentialPairs))
+			: 1.0f;
+	}
+
+	void Broadphase::Query(
+		const ColliderBounds& bounds,
+		vector<Collider*>& outColliders)
+	{
+		outColliders.clear();
+
+		staticTree.Query(
+			bounds,
+			~0u,
+			[&](Collider* c)
+			{
+				outColliders.push_back(c);
+				return true;
+			});
+
+		if (type == BroadphaseType::BROADPHASE_DYNAMIC_TREE)
+		{
+			tree.Query(bounds, [&](i32 id)
+				{
+					if (bounds.Overlaps(proxyData[id].bounds)) outColliders.push_back(tree.GetCollider(id));
+					return true;
+				});
+
+			return;
+		}
+
+		//sweep and prune and the spatial hash only find pairs, scan the proxies instead
+		for (i32 id : liveProxies)
+		{
+			if (bounds.Overlaps(proxyData[id].bounds)) outColliders.push_back(GetProxyCollider(id));
+		}
+	}
+
+	bool IsSleeping(const Collider* c)
+	{
+		if (c->IsStatic()
+			|| c->GetParentRigidBody() == 0)
+		{
+			return false;
+		}
+
+		RigidBody* rb = RigidBody::GetRegistry().GetContent(c->GetParentRigidBody());
+
+		return rb && rb->IsSleeping();
+	}
+
+	Collider* GetProxyCollider(i32 proxyID)
+	{
+		switch (type)
+		{
+		case BroadphaseType::BROADPHASE_DYNAMIC_TREE:
+			return tree.GetCollider(proxyID);
+		case BroadphaseType::BROADPHASE_SWEEP_AND_PRUNE:
+			return sap.GetCollider(proxyID);
+		case BroadphaseType::BROADPHASE_SPATIAL_HASH:
+			return hash.GetCollider(proxyID);
+		}
+
+		return nullptr;
+	}
+	i32 CreateProxy(
+		const ColliderBounds& bounds,
+		Collider* c)
+	{
+		switch (type)
+		{
+		case BroadphaseType::BROADPHASE_DYNAMIC_TREE:
+			return tree.CreateProxy(bounds.Expanded(BROADPHASE_FAT_MARGIN), c, c->GetLayerBit());
+		case BroadphaseType::BROADPHASE_SWEEP_AND_PRUNE:
+			return sap.CreateProxy(bounds, c);
+		case BroadphaseType::BROADPHASE_SPATIAL_HASH:
+			return hash.CreateProxy(bounds, c);
+		}
+
+		return -1;
+	}
+	void DestroyProxy(i32 proxyID)
+	{
+		switch (type)
+		{
+		case BroadphaseType::BROADPHASE_DYNAMIC_TREE:
+			tree.DestroyProxy(proxyID);
+			break;
+		case BroadphaseType::BROADPHASE_SWEEP_AND_PRUNE:
+			sap.DestroyProxy(proxyID);
+			break;
+		case BroadphaseType::BROADPHASE_SPATIAL_HASH:
+			hash.DestroyProxy(proxyID);
+			break;
+		}
+	}
+
+	void Broadphase::AcceptPair(
+		Collider* a,
+		Collider* b,
+		vector<ColliderPair>& outPairs)
+	{
+		++stats.overlappingPairs;
+
+		if (!CanPair(a, b)) return;
+
+		//two sleeping colliders would only be narrowphased to be ignored
+		if (proxyData[a->proxyID].isSleeping
+			&& proxyData[b->proxyID].isSleeping)
+		{
+			return;
+		}
+
+		outPairs.push_back({ a, b });
+	}
+	void Broadphase::AcceptStaticPair(
+		Collider* a,
+		Collider* b,
+		vector<ColliderPair>& outPairs)
+	{
+		++stats.overlappingPairs;
+
+		if (!CanPair(a, b)) return;
+
+		outPairs.push_back({ a, b });
+	}
+
+	bool Broadphase::CanPair(
+		const Collider* a,
+		const Collider* b)
+	{
+		//collision rules are symmetric, so one mask against the other layer bit covers both ways
+		if (!(a->collisionMask & b->layerBit)) return false;
+
+		//colliders of the same rigidbody never collide with each other
+		return a->parentRigidBody == 0
+			|| a->parentRigidBody != b->parentRigidBody;
+	}
+}
\ No newline at end of file
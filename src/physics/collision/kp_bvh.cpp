@@ -0,0 +1,315 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <array>
+#include <cfloat>
+#include <algorithm>
+
+#include "physics/collision/kp_bvh.hpp"
+#include "physics/collision/kp_collider.hpp"
+
+using std::vector;
+using std::array;
+using std::partition;
+using std::nth_element;
+
+namespace KalaPhysics::Physics::Collision
+{
+	struct SAHBin
+	{
+		ColliderBounds bounds{};
+		u32 count{};
+	};
+
+	//build scratch, indexed by the position in the input span
+	static vector<ColliderBounds> buildBounds{};
+	static vector<vec3> buildCentroids{};
+	static vector<vec3> buildMotions{};
+	//input positions in leaf order, partitioned in place while building
+	static vector<u32> buildOrder{};
+
+	static ColliderBounds EmptyBounds();
+	static ColliderBounds GetItemBounds(
+		const Collider* c,
+		span<const vec3> motions,
+		u32 index);
+	static f32 GetAxis(
+		const vec3& v,
+		u32 axis);
+
+	void ColliderBVH::Build(span<Collider* const> colliders) { Build(colliders, {}); }
+	void ColliderBVH::Build(
+		span<Collider* const> colliders,
+		span<const vec3> motions)
+	{
+		Clear();
+
+		buildBounds.clear();
+		buildCentroids.clear();
+		buildOrder.clear();
+		buildMotions.clear();
+
+		for (u32 i = 0; i < colliders.size(); i++)
+		{
+			Collider* c = colliders[i];
+			if (!c) continue;
+
+			ColliderBounds b = GetItemBounds(c, motions, i);
+			if (!motions.empty()) buildMotions.push_back(motions[i]);
+
+			items.push_back(c);
+			buildBounds.push_back(b);
+			buildCentroids.push_back(b.GetCenter());
+			buildOrder.push_back(scast<u32>(buildOrder.size()));
+		}
+
+		u32 count = scast<u32>(items.size());
+		if (count == 0) return;
+
+		nodes.reserve(2 * count);
+		nodes.push_back({});
+		BuildNode(0, 0, count, 0);
+
+		//store the items in leaf order so every leaf is one contiguous range
+		vector<Collider*> unordered = items;
+
+		itemBounds.resize(count);
+		itemMasks.resize(count);
+		if (!buildMotions.empty()) itemMotions.resize(count);
+		for (u32 i = 0; i < count; i++)
+		{
+			u32 source = buildOrder[i];
+
+			items[i] = unordered[source];
+			itemBounds[i] = buildBounds[source];
+			itemMasks[i] = items[i]->GetLayerBit();
+			if (!buildMotions.empty()) itemMotions[i] = buildMotions[source];
+		}
+
+		for (u32 i = 0; i < count; i++) packedItemBounds.Push(itemBounds[i]);
+		for (u32 i = 1; i < OVERLAP_BLOCK_SIZE; i++) packedItemBounds.PushEmpty();
+
+		Refit();
+	}
+
+	void ColliderBVH::BuildNode(
+		u32 nodeIndex,
+		u32 begin,
+		u32 end,
+		u32 depth)
+	{
+		u32 count = end - begin;
+
+		ColliderBounds centroidBounds = EmptyBounds();
+		for (u32 i = begin; i < end; i++)
+		{
+			const vec3& c = buildCentroids[buildOrder[i]];
+			centroidBounds.min = vmin(centroidBounds.min, c);
+			centroidBounds.max = vmax(centroidBounds.max, c);
+		}
+
+		if (count <= BVH_MAX_LEAF_SIZE
+			|| depth >= BVH_MAX_DEPTH)
+		{
+			nodes[nodeIndex].offset = begin;
+			nodes[nodeIndex].count = count;
+			return;
+		}
+
+		//split along the widest spread of centroids
+		vec3 spread = centroidBounds.max - centroidBounds.min;
+		u32 axis = 0;
+		if (spread.y > spread.x) axis = 1;
+		if (spread.z > GetAxis(spread, axis)) axis = 2;
+
+		f32 axisMin = GetAxis(centroidBounds.min, axis);
+		f32 axisSpread = GetAxis(spread, axis);
+
+		u32 mid = begin;
+
+		if (axisSpread > 1e-6f)
+		{
+			//
+			// BINNED SAH
+			//
+
+			array<SAHBin, BVH_SAH_BINS> bins{};
+			for (auto& b : bins) b.bounds = EmptyBounds();
+
+			f32 binScale = BVH_SAH_BINS / axisSpread;
+			auto _bin_of = [&](u32 item)
+				{
+					u32 bin = scast<u32>((GetAxis(buildCentroids[item], axis) - axisMin) * binScale);
+					return bin < BVH_SAH_BINS ? bin : BVH_SAH_BINS - 1;
+				};
+
+			for (u32 i = begin; i < end; i++)
+			{
+				u32 item = buildOrder[i];
+				SAHBin& b = bins[_bin_of(item)];
+
+				b.bounds = b.bounds.Merged(buildBounds[item]);
+				++b.count;
+			}
+
+			//right-to-left sweep of the areas right of every split
+			array<f32, BVH_SAH_BINS> rightCost{};
+			ColliderBounds right = EmptyBounds();
+			u32 rightCount{};
+			for (u32 i = BVH_SAH_BINS - 1; i > 0; i--)
+			{
+				right = right.Merged(bins[i].bounds);
+				rightCount += bins[i].count;
+				rightCost[i] = rightCount > 0 ? right.GetPerimeter() * rightCount : 0.0f;
+			}
+
+			u32 bestSplit{};
+			f32 bestCost = FLT_MAX;
+
+			ColliderBounds left = EmptyBounds();
+			u32 leftCount{};
+			for (u32 i = 1; i < BVH_SAH_BINS; i++)
+			{
+				left = left.Merged(bins[i - 1].bounds);
+				leftCount += bins[i - 1].count;
+
+				if (leftCount == 0
+					|| leftCount == count)
+				{
+					continue;
+				}
+
+				f32 cost = left.GetPerimeter() * leftCount + rightCost[i];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = i;
+				}
+			}
+
+			if (bestSplit > 0)
+			{
+				u32* first = buildOrder.data() + begin;
+				u32* last = buildOrder.data() + end;
+
+				mid = scast<u32>(partition(first, last,
+					[&](u32 item)
+					{
+						return _bin_of(item) < bestSplit;
+					}) - buildOrder.data());
+			}
+		}
+
+		//centroids too close to bin, split by count instead
+		if (mid == begin
+			|| mid == end)
+		{
+			mid = begin + count / 2;
+
+			nth_element(
+				buildOrder.begin() + begin,
+				buildOrder.begin() + mid,
+				buildOrder.begin() + end,
+				[&](u32 a, u32 b)
+				{
+					return GetAxis(buildCentroids[a], axis) < GetAxis(buildCentroids[b], axis);
+				});
+		}
+
+		//the left child always directly follows its parent
+		u32 leftIndex = scast<u32>(nodes.size());
+		nodes.push_back({});
+		BuildNode(leftIndex, begin, mid, depth + 1);
+
+		u32 rightIndex = scast<u32>(nodes.size());
+		nodes.push_back({});
+		nodes[nodeIndex].offset = rightIndex;
+		BuildNode(rightIndex, mid, end, depth + 1);
+	}
+
+	void ColliderBVH::Refit()
+	{
+		for (u32 i = 0; i < items.size(); i++)
+		{
+			if (!items[i]) continue;
+
+			itemBounds[i] = GetItemBounds(items[i], itemMotions, i);
+			itemMasks[i] = items[i]->GetLayerBit();
+			packedItemBounds.Set(i, itemBounds[i]);
+		}
+
+		//children are always stored after their parent
+		for (u32 i = scast<u32>(nodes.size()); i-- > 0;)
+		{
+			BVHNode& node = nodes[i];
+
+			if (node.count > 0)
+			{
+				node.bounds = itemBounds[node.offset];
+				node.mask = itemMasks[node.offset];
+
+				for (u32 j = node.offset + 1; j < node.offset + node.count; j++)
+				{
+					node.bounds = node.bounds.Merged(itemBounds[j]);
+					node.mask |= itemMasks[j];
+				}
+			}
+			else
+			{
+				const BVHNode& left = nodes[i + 1];
+				const BVHNode& right = nodes[node.offset];
+
+				node.bounds = left.bounds.Merged(right.bounds);
+				node.mask = left.mask | right.mask;
+			}
+		}
+	}
+
+	void ColliderBVH::MaskItem(u32 index)
+	{
+		if (index >= items.size()) return;
+
+		//empty bounds drop out of every merge, the nodes above keep their old bounds until the next refit
+		items[index] = nullptr;
+		itemBounds[index] = EmptyBounds();
+		itemMasks[index] = 0;
+		packedItemBounds.Set(index, itemBounds[index]);
+	}
+
+	void ColliderBVH::Clear()
+	{
+		nodes.clear();
+		items.clear();
+		itemBounds.clear();
+		packedItemBounds.Clear();
+		itemMasks.clear();
+		itemMotions.clear();
+	}
+
+	ColliderBounds EmptyBounds()
+	{
+		return { vec3(FLT_MAX), vec3(-FLT_MAX) };
+	}
+
+	ColliderBounds GetItemBounds(
+		const Collider* c,
+		span<const vec3> motions,
+		u32 index)
+	{
+		ColliderBounds b = c->GetBounds();
+		if (motions.empty()) return b;
+
+		//the path is approximated by both end bounds, rotation within a single step is small
+		return b.Merged({ b.min - motions[index], b.max - motions[index] });
+	}
+
+	f32 GetAxis(
+		const vec3& v,
+		u32 axis)
+	{
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+}
\ No newline at end of file
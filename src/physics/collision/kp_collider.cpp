@@ -4,9 +4,13 @@
 //Read LICENSE.md for more information.'
 
 #include "physics/collision/kp_collider.hpp"
+#include "physics/collision/kp_vertex_arena.hpp"
+#include "physics/kp_rigidbody.hpp"
 #include "core/kp_physics_world.hpp"
 
 using KalaPhysics::Core::PhysicsWorld;
+using KalaPhysics::Physics::RigidBody;
+using KalaPhysics::Physics::MAX_COLLIDERS;
 
 using std::to_string;
 
@@ -14,19 +18,60 @@ namespace KalaPhysics::Physics::Collision
 {
 	static KalaPhysicsRegistry<Collider> registry{};
 
+	//Short shape name used by the log messages of the shape classes
+	static string GetShapeName(ColliderShape shape);
+
 	KalaPhysicsRegistry<Collider>& Collider::GetRegistry() { return registry; }
 
 	bool Collider::IsInitialized() const { return isInitialized; }
 
 	u32 Collider::GetID() const { return ID; }
 
-	void Collider::SetStaticState(bool newValue) { isStatic = newValue; }
+	void Collider::SetStaticState(bool newValue)
+	{
+		if (isStatic == newValue) return;
+
+		isStatic = newValue;
+		StoreLocalPose();
+		GetRegistry().MarkChanged(ID);
+
+		//carried shapes decide whether their rigidbody can rotate
+		RigidBody* rb = RigidBody::GetRegistry().GetContent(parentRigidBody);
+		if (rb)
+		{
+			BodyStore::RefreshRotationLock(rb->GetBodyIndex());
+			BodyStore::RefreshInertia(rb->GetBodyIndex());
+		}
+	}
 	bool Collider::IsStatic() const { return isStatic; }
 
-	void Collider::SetTriggerState(bool newValue) { isTrigger = newValue; }
+	void Collider::SetTriggerState(bool newValue)
+	{
+		if (isTrigger == newValue) return;
+
+		isTrigger = newValue;
+		GetRegistry().MarkChanged(ID);
+	}
 	bool Collider::IsTrigger() const { return isTrigger; }
 
-	void Collider::SetParentRigidBody(u32 newValue) { parentRigidBody = newValue; }
+	void Collider::SetParentRigidBody(u32 newValue)
+	{
+		if (parentRigidBody == newValue) return;
+
+		//leave the collider list of the old body so it stops carrying this collider and refreshes its rotation lock
+		RigidBody* oldRb = RigidBody::GetRegistry().GetContent(parentRigidBody);
+		if (oldRb) oldRb->RemoveCollider(ID);
+
+		parentRigidBody = 0;
+		GetRegistry().MarkChanged(ID);
+
+		string shapeName = GetShapeName(shape);
+		AttachToParent(
+			newValue,
+			shapeName,
+			shapeName + "_COLLIDER",
+			true);
+	}
 	u32 Collider::GetParentRigidBody() const { return parentRigidBody; }
 
 	void Collider::SetLayer(const string& newLayer)
@@ -43,7 +88,11 @@ namespace KalaPhysics::Physics::Collision
 			return;
 		}
 
+		if (layer == foundLayer) return;
+
 		layer = foundLayer;
+		RefreshLayerMasks();
+		GetRegistry().MarkChanged(ID);
 	}
 	string Collider::GetLayer()
 	{
@@ -61,11 +110,20 @@ namespace KalaPhysics::Physics::Collision
 
 		return foundLayer;
 	}
+	u8 Collider::GetLayerIndex() const { return layer; }
+	u32 Collider::GetLayerBit() const { return layerBit; }
+	u32 Collider::GetCollisionMask() const { return collisionMask; }
 
 	ColliderShape Collider::GetColliderShape() const { return shape; }
 	ColliderType Collider::GetColliderType() const { return type; }
 
-	const vector<vec3>& Collider::GetVertices() const { return vertices; }
+	bool Collider::FollowsRotation() const
+	{
+		return shape != ColliderShape::COLLIDER_AABB
+			&& shape != ColliderShape::COLLIDER_BCP;
+	}
+
+	span<const vec3> Collider::GetVertices() const { return { vertexData, vertexCount }; }
 	const Transform3D& Collider::GetTransform() const { return transform; }
 
 	void Collider::SetOnTriggerEnter(const function<void()>& func) { if (func) onTriggerEnter = func; }
@@ -75,4 +133,133 @@ namespace KalaPhysics::Physics::Collision
 	void Collider::ClearOnTriggerEnter() { onTriggerEnter = nullptr; }
 	void Collider::ClearOnTriggerExit() { onTriggerExit = nullptr; }
 	void Collider::ClearOnTriggerStay() { onTriggerStay = nullptr; }
+
+	void Collider::MarkMoved()
+	{
+		if (isStatic
+			|| parentRigidBody == 0)
+		{
+			GetRegistry().MarkChanged(ID);
+			return;
+		}
+
+		StoreLocalPose();
+
+		//the new shape or place changes how the mass of the rigidbody is spread
+		RigidBody* rb = RigidBody::GetRegistry().GetContent(parentRigidBody);
+		if (rb) BodyStore::RefreshInertia(rb->GetBodyIndex());
+	}
+
+	void Collider::StoreLocalPose()
+	{
+		if (isStatic
+			|| parentRigidBody == 0)
+		{
+			return;
+		}
+
+		RigidBody* rb = RigidBody::GetRegistry().GetContent(parentRigidBody);
+		if (!rb) return;
+
+		vec3 pos{};
+		quat rot{};
+		GetPose(pos, rot);
+
+		const quat& bodyRot = rb->GetRotation();
+
+		localPos = vrotate_inv(bodyRot, pos - rb->GetPosition());
+		localRot = qmul_inv(bodyRot, rot);
+	}
+
+	void Collider::FollowParent(
+		const vec3& bodyPos,
+		const quat& bodyRot)
+	{
+		SetPose(
+			bodyPos + vrotate(bodyRot, localPos),
+			qmul(bodyRot, localRot));
+	}
+
+	void Collider::RefreshLayerMasks()
+	{
+		layerBit = layer < PhysicsWorld::GetLayerCount()
+			? 1u << layer
+			: 0u;
+		collisionMask = PhysicsWorld::GetCollisionMask(layer);
+	}
+
+	void Collider::AttachToParent(
+		u32 newParent,
+		const string& shapeName,
+		const string& logTag,
+		bool isQuiet)
+	{
+		if (newParent == 0) return;
+
+		RigidBody* rb = RigidBody::GetRegistry().GetContent(newParent);
+
+		if (rb == nullptr)
+		{
+			Log::Print(
+				"Cannot add parent rigidbody for " + shapeName + " collider with ID '" + to_string(ID) + "' because that rigidbody does not exist!",
+				logTag,
+				LogType::LOG_ERROR,
+				2);
+
+			return;
+		}
+
+		if (rb->GetColliderCount() >= MAX_COLLIDERS)
+		{
+			Log::Print(
+				"Cannot add parent rigidbody for " + shapeName + " collider with ID '" + to_string(ID) + "' because that rigidbody already has a max number of colliders!",
+				logTag,
+				LogType::LOG_ERROR,
+				2);
+
+			return;
+		}
+
+		parentRigidBody = newParent;
+		rb->AddCollider(ID);
+		StoreLocalPose();
+		GetRegistry().MarkChanged(ID);
+
+		if (isQuiet) return;
+
+		Log::Print(
+			"Added " + shapeName + " collider with ID '" + to_string(ID) + "' to rigidbody with ID '" + to_string(newParent) + "'!",
+			logTag,
+			LogType::LOG_SUCCESS);
+	}
+
+	string GetShapeName(ColliderShape shape)
+	{
+		switch (shape)
+		{
+		case ColliderShape::COLLIDER_BSP: return "BSP";
+		case ColliderShape::COLLIDER_AABB: return "AABB";
+		case ColliderShape::COLLIDER_OBB: return "OBB";
+		case ColliderShape::COLLIDER_BCP: return "BCP";
+		case ColliderShape::COLLIDER_BCH: return "BCH";
+		default: return "KDOP";
+		}
+	}
+
+	vec3* Collider::ResizeVertices(u32 count)
+	{
+		if (count == vertexCount) return vertexData;
+
+		VertexArena::Free(vertexData, vertexCount);
+
+		vertexData = VertexArena::Allocate(count);
+		vertexCount = count;
+
+		return vertexData;
+	}
+
+	Collider::~Collider()
+	{
+		VertexArena::Free(vertexData, vertexCount);
+	}
 }
\ No newline at end of file
@@ -9,22 +9,27 @@
 #include "math_utils.hpp"
 
 #include "physics/collision/kp_collider_aabb.hpp"
-#include "physics/kp_rigidbody.hpp"
-#include "core/kp_core.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "physics/collision/kp_vertex_arena.hpp"
+#include "core/kp_pool.hpp"
 
 using KalaHeaders::KalaMath::vec3;
 
-using KalaPhysics::Physics::RigidBody;
-using KalaPhysics::Core::KalaPhysicsCore;
+using KalaPhysics::Physics::Collision::Collider_AABB;
+using KalaPhysics::Physics::Collision::VertexArena;
+using KalaPhysics::Core::BlockPool;
 
 using std::vector;
 using std::to_string;
 using std::make_unique;
 using std::unique_ptr;
 
-static vector<vec3> GenerateCube(
+static BlockPool& GetPool();
+//Writes the 8 corners of the box to outVertices
+static void GenerateCube(
 	const vec3& minCorner,
-	const vec3& maxCorner);
+	const vec3& maxCorner,
+	vec3* outVertices);
 
 namespace KalaPhysics::Physics::Collision
 {
@@ -33,73 +38,110 @@ namespace KalaPhysics::Physics::Collision
 		const vec3& minCorner,
 		const vec3& maxCorner)
 	{
-		u32 newID = KalaPhysicsCore::GetGlobalID() + 1;
-		KalaPhysicsCore::SetGlobalID(newID);
+		return Create({ parentRigidBody, minCorner, maxCorner }, false);
+	}
 
-		unique_ptr<Collider_AABB> newCol = make_unique<Collider_AABB>();
-		Collider_AABB* colPtr = newCol.get();
+	void Collider_AABB::CreateMany(
+		span<const Desc> descs,
+		vector<Collider_AABB*>& outColliders)
+	{
+		u32 count = scast<u32>(descs.size());
+		if (count == 0) return;
+
+		//grow every storage once so the loop below never reaches the system allocator
+		GetPool().Reserve(count);
+		VertexArena::Reserve(count * 8);
+		GetRegistry().Reserve(count);
+		outColliders.reserve(outColliders.size() + count);
+
+		u32 created{};
+		for (const auto& d : descs)
+		{
+			Collider_AABB* colPtr = Create(d, true);
+			if (!colPtr) continue;
+
+			outColliders.push_back(colPtr);
+			++created;
+		}
 
 		Log::Print(
-			"Creating new AABB collider with ID '" + to_string(newID) + "'.",
+			"Created '" + to_string(created) + "' new AABB colliders!",
 			"AABB_COLLIDER",
-			LogType::LOG_DEBUG);
+			LogType::LOG_SUCCESS);
+	}
 
-		colPtr->ID = newID;
+	void* Collider_AABB::operator new(size_t size)
+	{
+		//classes deriving from this shape don't fit the pool blocks
+		if (size != sizeof(Collider_AABB)) return ::operator new(size);
 
-		if (parentRigidBody != 0)
+		return GetPool().Allocate();
+	}
+	void Collider_AABB::operator delete(
+		void* ptr,
+		size_t size)
+	{
+		if (size != sizeof(Collider_AABB))
 		{
-			RigidBody* rb = RigidBody::GetRegistry().GetContent(parentRigidBody);
-
-			if (rb == nullptr)
-			{
-				Log::Print(
-					"Cannot add parent rigidbody for AABB collider with ID '" + to_string(newID) + "' because that rigidbody does not exist!",
-					"AABB_COLLIDER",
-					LogType::LOG_ERROR,
-					2);
-			}
-			else
-			{
-				if (rb->GetColliderCount() >= MAX_COLLIDERS)
-				{
-					Log::Print(
-						"Cannot add parent rigidbody for AABB collider with ID '" + to_string(newID) + "' because that rigidbody already has a max number of colliders!",
-						"AABB_COLLIDER",
-						LogType::LOG_ERROR,
-						2);
-				}
-				else
-				{
-					colPtr->parentRigidBody = parentRigidBody;
-					rb->AddCollider(newID);
-
-					Log::Print(
-						"Added AABB collider with ID '" + to_string(newID) + "' to rigidbody with ID '" + to_string(parentRigidBody) + "'!",
-						"AABB_COLLIDER",
-						LogType::LOG_SUCCESS);
-				}
-			}
+			::operator delete(ptr);
+			return;
 		}
 
-		colPtr->SetMinCorner(minCorner);
-		colPtr->SetMaxCorner(maxCorner);
-		colPtr->vertices = GenerateCube(colPtr->minCorner, colPtr->maxCorner);
+		GetPool().Free(ptr);
+	}
+
+	Collider_AABB* Collider_AABB::Create(
+		const Desc& desc,
+		bool isQuiet)
+	{
+		unique_ptr<Collider_AABB> newCol = make_unique<Collider_AABB>();
+		Collider_AABB* colPtr = newCol.get();
 
-		GetRegistry().AddContent(newID, std::move(newCol));
+		u32 newID = GetRegistry().AddContent(std::move(newCol));
+		if (newID == 0)
+		{
+			Log::Print(
+				"Cannot create a new AABB collider because the collider registry is full!",
+				"AABB_COLLIDER",
+				LogType::LOG_ERROR,
+				2);
 
-		colPtr->isInitialized = true;
+			return nullptr;
+		}
 
-		Log::Print(
-			"Created new AABB collider with ID '" + to_string(newID) + "'!",
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Creating new AABB collider with ID '" + to_string(newID) + "'.",
+				"AABB_COLLIDER",
+				LogType::LOG_DEBUG);
+		}
+
+		colPtr->ID = newID;
+		colPtr->shape = ColliderShape::COLLIDER_AABB;
+		colPtr->type = ColliderType::COLLIDER_TYPE_BP;
+
+		colPtr->AttachToParent(
+			desc.parentRigidBody,
+			"AABB",
 			"AABB_COLLIDER",
-			LogType::LOG_SUCCESS);
+			isQuiet);
 
-		return colPtr;
-	}
+		colPtr->SetMinCorner(desc.minCorner);
+		colPtr->SetMaxCorner(desc.maxCorner);
+		GenerateCube(colPtr->minCorner, colPtr->maxCorner, colPtr->ResizeVertices(8));
 
-	void Collider_AABB::Update(Collider* c, f32 deltaTime)
-	{
+		colPtr->isInitialized = true;
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Created new AABB collider with ID '" + to_string(newID) + "'!",
+				"AABB_COLLIDER",
+				LogType::LOG_SUCCESS);
+		}
 
+		return colPtr;
 	}
 
 	const vec3& Collider_AABB::GetMinCorner() const { return minCorner; }
@@ -107,6 +149,7 @@ namespace KalaPhysics::Physics::Collision
 	{
 		minCorner = kclamp(newValue, MIN_AABB_CORNER, MAX_AABB_CORNER);
 		maxCorner = kclamp(maxCorner, minCorner + MIN_AABB_CORNER_DISTANCE, MAX_AABB_CORNER);
+		MarkMoved();
 	}
 
 	const vec3& Collider_AABB::GetMaxCorner() const { return maxCorner; }
@@ -114,6 +157,59 @@ namespace KalaPhysics::Physics::Collision
 	{
 		maxCorner = kclamp(newValue, MIN_AABB_CORNER, MAX_AABB_CORNER);
 		minCorner = kclamp(minCorner, MIN_AABB_CORNER, maxCorner - MIN_AABB_CORNER_DISTANCE);
+		MarkMoved();
+	}
+
+	ColliderBounds Collider_AABB::GetBounds() const
+	{
+		return { minCorner, maxCorner };
+	}
+
+	void Collider_AABB::Translate(const vec3& delta)
+	{
+		minCorner += delta;
+		maxCorner += delta;
+		MarkMoved();
+	}
+
+	void Collider_AABB::GetPose(
+		vec3& outPos,
+		quat& outRot) const
+	{
+		outPos = (minCorner + maxCorner) * 0.5f;
+		//no rotation
+		outRot = {};
+		outRot.w = 1.0f;
+	}
+	void Collider_AABB::SetPose(
+		const vec3& newPos,
+		const quat& newRot)
+	{
+		vec3 delta = newPos - (minCorner + maxCorner) * 0.5f;
+		minCorner += delta;
+		maxCorner += delta;
+	}
+
+	f32 Collider_AABB::GetMassProperties(
+		vec3& outCentroid,
+		vec3& outInertia) const
+	{
+		vec3 h = (maxCorner - minCorner) * 0.5f;
+
+		outCentroid = vec3(0.0f);
+		outInertia = vbox_inertia(h);
+
+		return 8.0f * h.x * h.y * h.z;
+	}
+
+	ConvexSupport Collider_AABB::GetSupport() const
+	{
+		ConvexSupport s{};
+		s.kind = SupportKind::SUPPORT_BOX;
+		s.pos = (minCorner + maxCorner) * 0.5f;
+		s.halfExtents = (maxCorner - minCorner) * 0.5f;
+
+		return s;
 	}
 
 	Collider_AABB::~Collider_AABB()
@@ -122,9 +218,26 @@ namespace KalaPhysics::Physics::Collision
 	}
 }
 
-vector<vec3> GenerateCube(
+void GenerateCube(
 	const vec3& minCorner,
-	const vec3& maxCorner)
+	const vec3& maxCorner,
+	vec3* outVertices)
+{
+	for (u32 i = 0; i < 8; i++)
+	{
+		outVertices[i] = vec3(
+			(i & 1) ? maxCorner.x : minCorner.x,
+			(i & 2) ? maxCorner.y : minCorner.y,
+			(i & 4) ? maxCorner.z : minCorner.z);
+	}
+}
+
+//never destroyed so colliders released during static teardown can still return their blocks
+BlockPool& GetPool()
 {
-	return{};
+	static BlockPool* pool = new BlockPool(
+		sizeof(Collider_AABB),
+		alignof(Collider_AABB));
+
+	return *pool;
 }
\ No newline at end of file
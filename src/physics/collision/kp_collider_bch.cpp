@@ -3,7 +3,25 @@
 //This is free software, and you are welcome to redistribute it under certain conditions.
 //Read LICENSE.md for more information.
 
+#include <algorithm>
+#include <memory>
+#include <string>
+
 #include "physics/collision/kp_collider_bch.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "physics/collision/kp_vertex_arena.hpp"
+#include "core/kp_pool.hpp"
+
+using KalaPhysics::Physics::Collision::Collider_BCH;
+using KalaPhysics::Physics::Collision::VertexArena;
+using KalaPhysics::Core::BlockPool;
+
+using std::copy;
+using std::to_string;
+using std::make_unique;
+using std::unique_ptr;
+
+static BlockPool& GetPool();
 
 namespace KalaPhysics::Physics::Collision
 {
@@ -13,30 +31,233 @@ namespace KalaPhysics::Physics::Collision
 		const quat& rot,
 		const vector<vec3>& vertices)
 	{
-		return nullptr;
+		return Create({ parentRigidbody, pos, rot, vertices }, false);
+	}
+
+	void Collider_BCH::CreateMany(
+		span<const Desc> descs,
+		vector<Collider_BCH*>& outColliders)
+	{
+		u32 count = scast<u32>(descs.size());
+		if (count == 0) return;
+
+		u32 vertexCount{};
+		for (const auto& d : descs) vertexCount += scast<u32>(d.vertices.size());
+
+		//grow every storage once so the loop below never reaches the system allocator
+		GetPool().Reserve(count);
+		VertexArena::Reserve(vertexCount);
+		GetRegistry().Reserve(count);
+		outColliders.reserve(outColliders.size() + count);
+
+		u32 created{};
+		for (const auto& d : descs)
+		{
+			Collider_BCH* colPtr = Create(d, true);
+			if (!colPtr) continue;
+
+			outColliders.push_back(colPtr);
+			++created;
+		}
+
+		Log::Print(
+			"Created '" + to_string(created) + "' new BCH colliders!",
+			"BCH_COLLIDER",
+			LogType::LOG_SUCCESS);
+	}
+
+	void* Collider_BCH::operator new(size_t size)
+	{
+		//classes deriving from this shape don't fit the pool blocks
+		if (size != sizeof(Collider_BCH)) return ::operator new(size);
+
+		return GetPool().Allocate();
 	}
+	void Collider_BCH::operator delete(
+		void* ptr,
+		size_t size)
+	{
+		if (size != sizeof(Collider_BCH))
+		{
+			::operator delete(ptr);
+			return;
+		}
 
-	void Collider_BCH::Update(Collider* c, f32 deltaTime)
+		GetPool().Free(ptr);
+	}
+
+	Collider_BCH* Collider_BCH::Create(
+		const Desc& desc,
+		bool isQuiet)
 	{
+		unique_ptr<Collider_BCH> newCol = make_unique<Collider_BCH>();
+		Collider_BCH* colPtr = newCol.get();
+
+		u32 newID = GetRegistry().AddContent(std::move(newCol));
+		if (newID == 0)
+		{
+			Log::Print(
+				"Cannot create a new BCH collider because the collider registry is full!",
+				"BCH_COLLIDER",
+				LogType::LOG_ERROR,
+				2);
+
+			return nullptr;
+		}
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Creating new BCH collider with ID '" + to_string(newID) + "'.",
+				"BCH_COLLIDER",
+				LogType::LOG_DEBUG);
+		}
+
+		colPtr->ID = newID;
+		colPtr->shape = ColliderShape::COLLIDER_BCH;
+		colPtr->type = ColliderType::COLLIDER_TYPE_NP;
+
+		colPtr->AttachToParent(
+			desc.parentRigidBody,
+			"BCH",
+			"BCH_COLLIDER",
+			isQuiet);
+
+		colPtr->SetPos(desc.pos);
+		colPtr->SetRot(desc.rot);
+		copy(
+			desc.vertices.begin(),
+			desc.vertices.end(),
+			colPtr->ResizeVertices(scast<u32>(desc.vertices.size())));
+
+		colPtr->hullStart = BuildHullAdjacency(
+			colPtr->GetVertices(),
+			colPtr->hullAdjacencyStart,
+			colPtr->hullAdjacency);
+
+		colPtr->isInitialized = true;
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Created new BCH collider with ID '" + to_string(newID) + "'!",
+				"BCH_COLLIDER",
+				LogType::LOG_SUCCESS);
+		}
 
+		return colPtr;
 	}
 
 	const vec3& Collider_BCH::GetPos() const { return pos; }
 	void Collider_BCH::SetPos(const vec3& newValue)
 	{
 		pos = kclamp(newValue, MIN_BCH_POS, MAX_BCH_POS);
+		MarkMoved();
 	}
 
 	const quat& Collider_BCH::GetRot() const { return rot; }
 	void Collider_BCH::SetRot(const quat& newValue)
 	{
 		rot = normalize_q(newValue);
+		MarkMoved();
 	}
 
-	const vector<vec3>& Collider_BCH::GetVertices() const { return vertices; }
+	ColliderBounds Collider_BCH::GetBounds() const
+	{
+		if (vertexCount == 0) return { pos, pos };
+
+		vec3 first = pos + vrotate(rot, vertexData[0]);
+		ColliderBounds b{ first, first };
+
+		for (const auto& v : GetVertices())
+		{
+			vec3 w = pos + vrotate(rot, v);
+			b.min = vmin(b.min, w);
+			b.max = vmax(b.max, w);
+		}
+
+		return b;
+	}
+
+	void Collider_BCH::Translate(const vec3& delta)
+	{
+		pos += delta;
+		MarkMoved();
+	}
+
+	void Collider_BCH::GetPose(
+		vec3& outPos,
+		quat& outRot) const
+	{
+		outPos = pos;
+		outRot = rot;
+	}
+	void Collider_BCH::SetPose(
+		const vec3& newPos,
+		const quat& newRot)
+	{
+		pos = newPos;
+		rot = newRot;
+	}
+
+	f32 Collider_BCH::GetMassProperties(
+		vec3& outCentroid,
+		vec3& outInertia) const
+	{
+		outCentroid = vec3(0.0f);
+		outInertia = vec3(0.0f);
+		if (vertexCount == 0) return 0.0f;
+
+		//approximated by the box around the local vertices
+		vec3 minV = vertexData[0];
+		vec3 maxV = vertexData[0];
+		for (const auto& v : GetVertices())
+		{
+			minV = vmin(minV, v);
+			maxV = vmax(maxV, v);
+		}
+
+		vec3 h = (maxV - minV) * 0.5f;
+
+		outCentroid = (minV + maxV) * 0.5f;
+		outInertia = vbox_inertia(h);
+
+		return 8.0f * h.x * h.y * h.z;
+	}
+
+	ConvexSupport Collider_BCH::GetSupport() const
+	{
+		ConvexSupport s{};
+		s.kind = SupportKind::SUPPORT_POINTS;
+		s.pos = pos;
+		s.rot = rot;
+		s.isRotated = true;
+		s.vertices = vertexData;
+		s.vertexCount = vertexCount;
+
+		//flat clouds have no hull to climb and fall back to a linear scan
+		if (hullStart < vertexCount)
+		{
+			s.adjacencyStart = hullAdjacencyStart.data();
+			s.adjacency = hullAdjacency.data();
+			s.hint = hullStart;
+		}
+
+		return s;
+	}
 
 	Collider_BCH::~Collider_BCH()
 	{
 
 	}
+}
+
+//never destroyed so colliders released during static teardown can still return their blocks
+BlockPool& GetPool()
+{
+	static BlockPool* pool = new BlockPool(
+		sizeof(Collider_BCH),
+		alignof(Collider_BCH));
+
+	return *pool;
 }
\ No newline at end of file
@@ -3,14 +3,29 @@
 //This is free software, and you are welcome to redistribute it under certain conditions.
 //Read LICENSE.md for more information.
 
+#include <memory>
+#include <string>
 #include <algorithm>
 
 #include "physics/collision/kp_collider_bcp.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "core/kp_pool.hpp"
 
 using std::clamp;
 using std::fmin;
 using std::fmax;
 
+using KalaHeaders::KalaMath::PI;
+
+using KalaPhysics::Physics::Collision::Collider_BCP;
+using KalaPhysics::Core::BlockPool;
+
+using std::to_string;
+using std::make_unique;
+using std::unique_ptr;
+
+static BlockPool& GetPool();
+
 namespace KalaPhysics::Physics::Collision
 {
 	Collider_BCP* Collider_BCP::Initialize(
@@ -20,18 +35,116 @@ namespace KalaPhysics::Physics::Collision
 		f32 radius,
 		ColliderType type)
 	{
-		return nullptr;
+		return Create({ parentRigidbody, pos, height, radius, type }, false);
+	}
+
+	void Collider_BCP::CreateMany(
+		span<const Desc> descs,
+		vector<Collider_BCP*>& outColliders)
+	{
+		u32 count = scast<u32>(descs.size());
+		if (count == 0) return;
+
+		//grow every storage once so the loop below never reaches the system allocator
+		GetPool().Reserve(count);
+		GetRegistry().Reserve(count);
+		outColliders.reserve(outColliders.size() + count);
+
+		u32 created{};
+		for (const auto& d : descs)
+		{
+			Collider_BCP* colPtr = Create(d, true);
+			if (!colPtr) continue;
+
+			outColliders.push_back(colPtr);
+			++created;
+		}
+
+		Log::Print(
+			"Created '" + to_string(created) + "' new BCP colliders!",
+			"BCP_COLLIDER",
+			LogType::LOG_SUCCESS);
 	}
 
-	void Collider_BCP::Update(Collider* c, f32 deltaTime)
+	void* Collider_BCP::operator new(size_t size)
+	{
+		//classes deriving from this shape don't fit the pool blocks
+		if (size != sizeof(Collider_BCP)) return ::operator new(size);
+
+		return GetPool().Allocate();
+	}
+	void Collider_BCP::operator delete(
+		void* ptr,
+		size_t size)
 	{
+		if (size != sizeof(Collider_BCP))
+		{
+			::operator delete(ptr);
+			return;
+		}
 
+		GetPool().Free(ptr);
+	}
+
+	Collider_BCP* Collider_BCP::Create(
+		const Desc& desc,
+		bool isQuiet)
+	{
+		unique_ptr<Collider_BCP> newCol = make_unique<Collider_BCP>();
+		Collider_BCP* colPtr = newCol.get();
+
+		u32 newID = GetRegistry().AddContent(std::move(newCol));
+		if (newID == 0)
+		{
+			Log::Print(
+				"Cannot create a new BCP collider because the collider registry is full!",
+				"BCP_COLLIDER",
+				LogType::LOG_ERROR,
+				2);
+
+			return nullptr;
+		}
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Creating new BCP collider with ID '" + to_string(newID) + "'.",
+				"BCP_COLLIDER",
+				LogType::LOG_DEBUG);
+		}
+
+		colPtr->ID = newID;
+		colPtr->shape = ColliderShape::COLLIDER_BCP;
+		colPtr->type = desc.type;
+
+		colPtr->AttachToParent(
+			desc.parentRigidBody,
+			"BCP",
+			"BCP_COLLIDER",
+			isQuiet);
+
+		colPtr->SetPos(desc.pos);
+		colPtr->SetHeight(desc.height);
+		colPtr->SetRadius(desc.radius);
+
+		colPtr->isInitialized = true;
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Created new BCP collider with ID '" + to_string(newID) + "'!",
+				"BCP_COLLIDER",
+				LogType::LOG_SUCCESS);
+		}
+
+		return colPtr;
 	}
 
 	const vec3& Collider_BCP::GetPos() const { return pos; }
 	void Collider_BCP::SetPos(const vec3& newValue)
 	{
 		pos = kclamp(newValue, MIN_BCP_POS, MAX_BCP_POS);
+		MarkMoved();
 	}
 
 	f32 Collider_BCP::GetHeight() const { return height; }
@@ -39,6 +152,7 @@ namespace KalaPhysics::Physics::Collision
 	{
 		height = clamp(newValue, MIN_BCP_HEIGHT, MAX_BCP_HEIGHT);
 		radius = fmin(radius, height * 0.5f);
+		MarkMoved();
 	}
 
 	f32 Collider_BCP::GetRadius() const { return radius; }
@@ -46,10 +160,94 @@ namespace KalaPhysics::Physics::Collision
 	{
 		radius = clamp(newValue, MIN_BCP_RADIUS, MAX_BCP_RADIUS);
 		height = fmax(height, 2 * radius);
+		MarkMoved();
+	}
+
+	ColliderBounds Collider_BCP::GetBounds() const
+	{
+		//upright capsule, height covers the full capsule including both caps
+		vec3 extents(radius, height * 0.5f, radius);
+
+		return { pos - extents, pos + extents };
+	}
+
+	void Collider_BCP::Translate(const vec3& delta)
+	{
+		pos += delta;
+		MarkMoved();
+	}
+
+	void Collider_BCP::GetPose(
+		vec3& outPos,
+		quat& outRot) const
+	{
+		outPos = pos;
+		//no rotation
+		outRot = {};
+		outRot.w = 1.0f;
+	}
+	void Collider_BCP::SetPose(
+		const vec3& newPos,
+		const quat& newRot)
+	{
+		pos = newPos;
+	}
+
+	f32 Collider_BCP::GetMassProperties(
+		vec3& outCentroid,
+		vec3& outInertia) const
+	{
+		//cylinder between the cap centers plus both hemispheres, upright along Y
+		f32 r2 = radius * radius;
+		f32 length = fmax(height - 2.0f * radius, 0.0f);
+
+		f32 cylinderVolume = PI * r2 * length;
+		f32 sphereVolume = (4.0f / 3.0f) * PI * r2 * radius;
+		f32 volume = cylinderVolume + sphereVolume;
+
+		outCentroid = vec3(0.0f);
+		if (!(volume > 0.0f))
+		{
+			outInertia = vec3(0.0f);
+			return 0.0f;
+		}
+
+		f32 cylinderShare = cylinderVolume / volume;
+		f32 sphereShare = sphereVolume / volume;
+
+		f32 axial = cylinderShare * 0.5f * r2 + sphereShare * 0.4f * r2;
+		f32 lateral = cylinderShare * (3.0f * r2 + length * length) / 12.0f
+			+ sphereShare * (0.4f * r2 + 0.25f * length * length + 0.375f * length * radius);
+
+		outInertia = vec3(lateral, axial, lateral);
+
+		return volume;
+	}
+
+	ConvexSupport Collider_BCP::GetSupport() const
+	{
+		//the core is the segment between both cap centers
+		ConvexSupport s{};
+		s.kind = SupportKind::SUPPORT_SEGMENT;
+		s.pos = pos;
+		s.halfHeight = fmax(height * 0.5f - radius, 0.0f);
+		s.radius = radius;
+
+		return s;
 	}
 
 	Collider_BCP::~Collider_BCP()
 	{
 
 	}
+}
+
+//never destroyed so colliders released during static teardown can still return their blocks
+BlockPool& GetPool()
+{
+	static BlockPool* pool = new BlockPool(
+		sizeof(Collider_BCP),
+		alignof(Collider_BCP));
+
+	return *pool;
 }
\ No newline at end of file
@@ -9,22 +9,28 @@
 #include "math_utils.hpp"
 
 #include "physics/collision/kp_collider_bsp.hpp"
-#include "physics/kp_rigidbody.hpp"
-#include "core/kp_core.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "physics/collision/kp_vertex_arena.hpp"
+#include "core/kp_pool.hpp"
 
 using KalaHeaders::KalaMath::vec3;
 using KalaHeaders::KalaMath::PI;
 
 using KalaPhysics::Physics::Collision::SPHERE_QUALITY;
-using KalaPhysics::Physics::RigidBody;
-using KalaPhysics::Core::KalaPhysicsCore;
+using KalaPhysics::Physics::Collision::Collider_BSP;
+using KalaPhysics::Physics::Collision::VertexArena;
+using KalaPhysics::Core::BlockPool;
 
 using std::vector;
 using std::to_string;
 using std::make_unique;
 using std::unique_ptr;
 
-static vector<vec3> GenerateSphere(f32 radius);
+static BlockPool& GetPool();
+//Writes SPHERE_QUALITY vertices of a sphere outline to outVertices
+static void GenerateSphere(
+	f32 radius,
+	vec3* outVertices);
 
 namespace KalaPhysics::Physics::Collision
 {
@@ -33,85 +39,171 @@ namespace KalaPhysics::Physics::Collision
 		const vec3& center,
 		f32 radius)
 	{
-		u32 newID = KalaPhysicsCore::GetGlobalID() + 1;
-		KalaPhysicsCore::SetGlobalID(newID);
+		return Create({ parentRigidBody, center, radius }, false);
+	}
 
-		unique_ptr<Collider_BSP> newCol = make_unique<Collider_BSP>();
-		Collider_BSP* colPtr = newCol.get();
+	void Collider_BSP::CreateMany(
+		span<const Desc> descs,
+		vector<Collider_BSP*>& outColliders)
+	{
+		u32 count = scast<u32>(descs.size());
+		if (count == 0) return;
+
+		//grow every storage once so the loop below never reaches the system allocator
+		GetPool().Reserve(count);
+		VertexArena::Reserve(count * SPHERE_QUALITY);
+		GetRegistry().Reserve(count);
+		outColliders.reserve(outColliders.size() + count);
+
+		u32 created{};
+		for (const auto& d : descs)
+		{
+			Collider_BSP* colPtr = Create(d, true);
+			if (!colPtr) continue;
+
+			outColliders.push_back(colPtr);
+			++created;
+		}
 
 		Log::Print(
-			"Creating new BSP collider with ID '" + to_string(newID) + "'.",
+			"Created '" + to_string(created) + "' new BSP colliders!",
 			"BSP_COLLIDER",
-			LogType::LOG_DEBUG);
+			LogType::LOG_SUCCESS);
+	}
 
-		colPtr->ID = newID;
+	void* Collider_BSP::operator new(size_t size)
+	{
+		//classes deriving from this shape don't fit the pool blocks
+		if (size != sizeof(Collider_BSP)) return ::operator new(size);
 
-		if (parentRigidBody != 0)
+		return GetPool().Allocate();
+	}
+	void Collider_BSP::operator delete(
+		void* ptr,
+		size_t size)
+	{
+		if (size != sizeof(Collider_BSP))
 		{
-			RigidBody* rb = RigidBody::GetRegistry().GetContent(parentRigidBody);
-
-			if (rb == nullptr)
-			{
-				Log::Print(
-					"Cannot add parent rigidbody for BSP collider with ID '" + to_string(newID) + "' because that rigidbody does not exist!",
-					"BSP_COLLIDER",
-					LogType::LOG_ERROR,
-					2);
-			}
-			else
-			{
-				if (rb->GetColliderCount() >= MAX_COLLIDERS)
-				{
-					Log::Print(
-						"Cannot add parent rigidbody for BSP collider with ID '" + to_string(newID) + "' because that rigidbody already has a max number of colliders!",
-						"BSP_COLLIDER",
-						LogType::LOG_ERROR,
-						2);
-				}
-				else
-				{
-					colPtr->parentRigidBody = parentRigidBody;
-					rb->AddCollider(newID);
-
-					Log::Print(
-						"Added BSP collider with ID '" + to_string(newID) + "' to rigidbody with ID '" + to_string(parentRigidBody) + "'!",
-						"BSP_COLLIDER",
-						LogType::LOG_SUCCESS);
-				}
-			}
+			::operator delete(ptr);
+			return;
 		}
 
-		colPtr->SetCenter(center);
-		colPtr->SetRadius(radius);
-		colPtr->vertices = GenerateSphere(colPtr->radius);
+		GetPool().Free(ptr);
+	}
 
-		GetRegistry().AddContent(newID, std::move(newCol));
+	Collider_BSP* Collider_BSP::Create(
+		const Desc& desc,
+		bool isQuiet)
+	{
+		unique_ptr<Collider_BSP> newCol = make_unique<Collider_BSP>();
+		Collider_BSP* colPtr = newCol.get();
 
-		colPtr->isInitialized = true;
+		u32 newID = GetRegistry().AddContent(std::move(newCol));
+		if (newID == 0)
+		{
+			Log::Print(
+				"Cannot create a new BSP collider because the collider registry is full!",
+				"BSP_COLLIDER",
+				LogType::LOG_ERROR,
+				2);
 
-		Log::Print(
-			"Created new BSP collider with ID '" + to_string(newID) + "'!",
+			return nullptr;
+		}
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Creating new BSP collider with ID '" + to_string(newID) + "'.",
+				"BSP_COLLIDER",
+				LogType::LOG_DEBUG);
+		}
+
+		colPtr->ID = newID;
+		colPtr->shape = ColliderShape::COLLIDER_BSP;
+		colPtr->type = ColliderType::COLLIDER_TYPE_BP;
+
+		colPtr->AttachToParent(
+			desc.parentRigidBody,
+			"BSP",
 			"BSP_COLLIDER",
-			LogType::LOG_SUCCESS);
+			isQuiet);
 
-		return colPtr;
-	}
+		colPtr->SetCenter(desc.center);
+		colPtr->SetRadius(desc.radius);
+		GenerateSphere(colPtr->radius, colPtr->ResizeVertices(SPHERE_QUALITY));
 
-	void Collider_BSP::Update(Collider* c, f32 deltaTime)
-	{
+		colPtr->isInitialized = true;
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Created new BSP collider with ID '" + to_string(newID) + "'!",
+				"BSP_COLLIDER",
+				LogType::LOG_SUCCESS);
+		}
 
+		return colPtr;
 	}
 
 	const vec3& Collider_BSP::GetCenter() const { return center; }
 	void Collider_BSP::SetCenter(const vec3& newValue)
 	{
 		center = kclamp(newValue, MIN_BSP_CENTER, MAX_BSP_CENTER);
+		MarkMoved();
 	}
 
 	f32 Collider_BSP::GetRadius() const { return radius; }
 	void Collider_BSP::SetRadius(f32 newValue)
 	{
 		radius = clamp(newValue, MIN_BSP_RADIUS, MAX_BSP_RADIUS);
+		MarkMoved();
+	}
+
+	ColliderBounds Collider_BSP::GetBounds() const
+	{
+		return { center - vec3(radius), center + vec3(radius) };
+	}
+
+	void Collider_BSP::Translate(const vec3& delta)
+	{
+		center += delta;
+		MarkMoved();
+	}
+
+	void Collider_BSP::GetPose(
+		vec3& outPos,
+		quat& outRot) const
+	{
+		outPos = center;
+		//no rotation
+		outRot = {};
+		outRot.w = 1.0f;
+	}
+	void Collider_BSP::SetPose(
+		const vec3& newPos,
+		const quat& newRot)
+	{
+		center = newPos;
+	}
+
+	f32 Collider_BSP::GetMassProperties(
+		vec3& outCentroid,
+		vec3& outInertia) const
+	{
+		outCentroid = vec3(0.0f);
+		outInertia = vec3(0.4f * radius * radius);
+
+		return (4.0f / 3.0f) * PI * radius * radius * radius;
+	}
+
+	ConvexSupport Collider_BSP::GetSupport() const
+	{
+		ConvexSupport s{};
+		s.kind = SupportKind::SUPPORT_POINT;
+		s.pos = center;
+		s.radius = radius;
+
+		return s;
 	}
 
 	Collider_BSP::~Collider_BSP()
@@ -120,10 +212,10 @@ namespace KalaPhysics::Physics::Collision
 	}
 }
 
-vector<vec3> GenerateSphere(f32 radius)
+void GenerateSphere(
+	f32 radius,
+	vec3* outVertices)
 {
-	vector<vec3> vertices{};
-
 	for (int i = 0; i < SPHERE_QUALITY; ++i)
 	{
 		//vertex angle
@@ -135,8 +227,16 @@ vector<vec3> GenerateSphere(f32 radius)
 		f32 y = radius * sinf(theta) * sinf(0.0f);
 		f32 z = radius * cosf(theta);
 
-		vertices.push_back({x, y, z});
+		outVertices[i] = vec3(x, y, z);
 	}
+}
+
+//never destroyed so colliders released during static teardown can still return their blocks
+BlockPool& GetPool()
+{
+	static BlockPool* pool = new BlockPool(
+		sizeof(Collider_BSP),
+		alignof(Collider_BSP));
 
-	return vertices;
+	return *pool;
 }
\ No newline at end of file
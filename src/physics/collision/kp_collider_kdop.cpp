@@ -3,7 +3,25 @@
 //This is free software, and you are welcome to redistribute it under certain conditions.
 //Read LICENSE.md for more information.
 
+#include <algorithm>
+#include <memory>
+#include <string>
+
 #include "physics/collision/kp_collider_kdop.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "physics/collision/kp_vertex_arena.hpp"
+#include "core/kp_pool.hpp"
+
+using KalaPhysics::Physics::Collision::Collider_KDOP;
+using KalaPhysics::Physics::Collision::VertexArena;
+using KalaPhysics::Core::BlockPool;
+
+using std::copy;
+using std::to_string;
+using std::make_unique;
+using std::unique_ptr;
+
+static BlockPool& GetPool();
 
 namespace KalaPhysics::Physics::Collision
 {
@@ -14,32 +32,224 @@ namespace KalaPhysics::Physics::Collision
 		const vector<vec3>& vertices,
 		KDOPShape shape)
 	{
-		return nullptr;
+		return Create({ parentRigidbody, pos, rot, vertices, shape }, false);
+	}
+
+	void Collider_KDOP::CreateMany(
+		span<const Desc> descs,
+		vector<Collider_KDOP*>& outColliders)
+	{
+		u32 count = scast<u32>(descs.size());
+		if (count == 0) return;
+
+		u32 vertexCount{};
+		for (const auto& d : descs) vertexCount += scast<u32>(d.vertices.size());
+
+		//grow every storage once so the loop below never reaches the system allocator
+		GetPool().Reserve(count);
+		VertexArena::Reserve(vertexCount);
+		GetRegistry().Reserve(count);
+		outColliders.reserve(outColliders.size() + count);
+
+		u32 created{};
+		for (const auto& d : descs)
+		{
+			Collider_KDOP* colPtr = Create(d, true);
+			if (!colPtr) continue;
+
+			outColliders.push_back(colPtr);
+			++created;
+		}
+
+		Log::Print(
+			"Created '" + to_string(created) + "' new KDOP colliders!",
+			"KDOP_COLLIDER",
+			LogType::LOG_SUCCESS);
+	}
+
+	void* Collider_KDOP::operator new(size_t size)
+	{
+		//classes deriving from this shape don't fit the pool blocks
+		if (size != sizeof(Collider_KDOP)) return ::operator new(size);
+
+		return GetPool().Allocate();
 	}
+	void Collider_KDOP::operator delete(
+		void* ptr,
+		size_t size)
+	{
+		if (size != sizeof(Collider_KDOP))
+		{
+			::operator delete(ptr);
+			return;
+		}
 
-	void Collider_KDOP::Update(Collider* c, f32 deltaTime)
+		GetPool().Free(ptr);
+	}
+
+	Collider_KDOP* Collider_KDOP::Create(
+		const Desc& desc,
+		bool isQuiet)
 	{
+		unique_ptr<Collider_KDOP> newCol = make_unique<Collider_KDOP>();
+		Collider_KDOP* colPtr = newCol.get();
+
+		u32 newID = GetRegistry().AddContent(std::move(newCol));
+		if (newID == 0)
+		{
+			Log::Print(
+				"Cannot create a new KDOP collider because the collider registry is full!",
+				"KDOP_COLLIDER",
+				LogType::LOG_ERROR,
+				2);
+
+			return nullptr;
+		}
 
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Creating new KDOP collider with ID '" + to_string(newID) + "'.",
+				"KDOP_COLLIDER",
+				LogType::LOG_DEBUG);
+		}
+
+		colPtr->ID = newID;
+		colPtr->shape = scast<ColliderShape>(scast<u8>(ColliderShape::COLLIDER_KDOP_10_X) + scast<u8>(desc.shape));
+		colPtr->type = ColliderType::COLLIDER_TYPE_BP;
+
+		colPtr->AttachToParent(
+			desc.parentRigidBody,
+			"KDOP",
+			"KDOP_COLLIDER",
+			isQuiet);
+
+		colPtr->kdopShape = desc.shape;
+		colPtr->SetPos(desc.pos);
+		colPtr->SetRot(desc.rot);
+		copy(
+			desc.vertices.begin(),
+			desc.vertices.end(),
+			colPtr->ResizeVertices(scast<u32>(desc.vertices.size())));
+
+		colPtr->isInitialized = true;
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Created new KDOP collider with ID '" + to_string(newID) + "'!",
+				"KDOP_COLLIDER",
+				LogType::LOG_SUCCESS);
+		}
+
+		return colPtr;
 	}
 
 	const vec3& Collider_KDOP::GetPos() const { return pos; }
 	void Collider_KDOP::SetPos(const vec3& newValue)
 	{
 		pos = kclamp(newValue, MIN_KDOP_POS, MAX_KDOP_POS);
+		MarkMoved();
 	}
 
 	const quat& Collider_KDOP::GetRot() const { return rot; }
 	void Collider_KDOP::SetRot(const quat& newValue)
 	{
 		rot = normalize_q(newValue);
+		MarkMoved();
 	}
 
-	const vector<vec3>& Collider_KDOP::GetVertices() const { return vertices; }
-
 	KDOPShape Collider_KDOP::GetKDOPShape() const { return kdopShape; }
 
+	ColliderBounds Collider_KDOP::GetBounds() const
+	{
+		if (vertexCount == 0) return { pos, pos };
+
+		vec3 first = pos + vrotate(rot, vertexData[0]);
+		ColliderBounds b{ first, first };
+
+		for (const auto& v : GetVertices())
+		{
+			vec3 w = pos + vrotate(rot, v);
+			b.min = vmin(b.min, w);
+			b.max = vmax(b.max, w);
+		}
+
+		return b;
+	}
+
+	void Collider_KDOP::Translate(const vec3& delta)
+	{
+		pos += delta;
+		MarkMoved();
+	}
+
+	void Collider_KDOP::GetPose(
+		vec3& outPos,
+		quat& outRot) const
+	{
+		outPos = pos;
+		outRot = rot;
+	}
+	void Collider_KDOP::SetPose(
+		const vec3& newPos,
+		const quat& newRot)
+	{
+		pos = newPos;
+		rot = newRot;
+	}
+
+	f32 Collider_KDOP::GetMassProperties(
+		vec3& outCentroid,
+		vec3& outInertia) const
+	{
+		outCentroid = vec3(0.0f);
+		outInertia = vec3(0.0f);
+		if (vertexCount == 0) return 0.0f;
+
+		//approximated by the box around the local vertices
+		vec3 minV = vertexData[0];
+		vec3 maxV = vertexData[0];
+		for (const auto& v : GetVertices())
+		{
+			minV = vmin(minV, v);
+			maxV = vmax(maxV, v);
+		}
+
+		vec3 h = (maxV - minV) * 0.5f;
+
+		outCentroid = (minV + maxV) * 0.5f;
+		outInertia = vbox_inertia(h);
+
+		return 8.0f * h.x * h.y * h.z;
+	}
+
+	ConvexSupport Collider_KDOP::GetSupport() const
+	{
+		//k-DOP point sets are small, they are always scanned linearly
+		ConvexSupport s{};
+		s.kind = SupportKind::SUPPORT_POINTS;
+		s.pos = pos;
+		s.rot = rot;
+		s.isRotated = true;
+		s.vertices = vertexData;
+		s.vertexCount = vertexCount;
+
+		return s;
+	}
+
 	Collider_KDOP::~Collider_KDOP()
 	{
 
 	}
+}
+
+//never destroyed so colliders released during static teardown can still return their blocks
+BlockPool& GetPool()
+{
+	static BlockPool* pool = new BlockPool(
+		sizeof(Collider_KDOP),
+		alignof(Collider_KDOP));
+
+	return *pool;
 }
\ No newline at end of file
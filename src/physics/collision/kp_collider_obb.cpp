@@ -3,7 +3,20 @@
 //This is free software, and you are welcome to redistribute it under certain conditions.
 //Read LICENSE.md for more information.
 
+#include <memory>
+#include <string>
 #include "physics/collision/kp_collider_obb.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "core/kp_pool.hpp"
+
+using KalaPhysics::Physics::Collision::Collider_OBB;
+using KalaPhysics::Core::BlockPool;
+
+using std::to_string;
+using std::make_unique;
+using std::unique_ptr;
+
+static BlockPool& GetPool();
 
 namespace KalaPhysics::Physics::Collision
 {
@@ -14,34 +27,203 @@ namespace KalaPhysics::Physics::Collision
 		const vec3& halfExtents,
 		ColliderType type)
 	{
-		return nullptr;
+		return Create({ parentRigidbody, pos, rot, halfExtents, type }, false);
 	}
 
-	void Collider_OBB::Update(Collider* c, f32 deltaTime)
+	void Collider_OBB::CreateMany(
+		span<const Desc> descs,
+		vector<Collider_OBB*>& outColliders)
+	{
+		u32 count = scast<u32>(descs.size());
+		if (count == 0) return;
+
+		//grow every storage once so the loop below never reaches the system allocator
+		GetPool().Reserve(count);
+		GetRegistry().Reserve(count);
+		outColliders.reserve(outColliders.size() + count);
+
+		u32 created{};
+		for (const auto& d : descs)
+		{
+			Collider_OBB* colPtr = Create(d, true);
+			if (!colPtr) continue;
+
+			outColliders.push_back(colPtr);
+			++created;
+		}
+
+		Log::Print(
+			"Created '" + to_string(created) + "' new OBB colliders!",
+			"OBB_COLLIDER",
+			LogType::LOG_SUCCESS);
+	}
+
+	void* Collider_OBB::operator new(size_t size)
+	{
+		//classes deriving from this shape don't fit the pool blocks
+		if (size != sizeof(Collider_OBB)) return ::operator new(size);
+
+		return GetPool().Allocate();
+	}
+	void Collider_OBB::operator delete(
+		void* ptr,
+		size_t size)
 	{
+		if (size != sizeof(Collider_OBB))
+		{
+			::operator delete(ptr);
+			return;
+		}
+
+		GetPool().Free(ptr);
+	}
+
+	Collider_OBB* Collider_OBB::Create(
+		const Desc& desc,
+		bool isQuiet)
+	{
+		unique_ptr<Collider_OBB> newCol = make_unique<Collider_OBB>();
+		Collider_OBB* colPtr = newCol.get();
+
+		u32 newID = GetRegistry().AddContent(std::move(newCol));
+		if (newID == 0)
+		{
+			Log::Print(
+				"Cannot create a new OBB collider because the collider registry is full!",
+				"OBB_COLLIDER",
+				LogType::LOG_ERROR,
+				2);
+
+			return nullptr;
+		}
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Creating new OBB collider with ID '" + to_string(newID) + "'.",
+				"OBB_COLLIDER",
+				LogType::LOG_DEBUG);
+		}
+
+		colPtr->ID = newID;
+		colPtr->shape = ColliderShape::COLLIDER_OBB;
+		colPtr->type = desc.type;
+
+		colPtr->AttachToParent(
+			desc.parentRigidBody,
+			"OBB",
+			"OBB_COLLIDER",
+			isQuiet);
+
+		colPtr->SetPos(desc.pos);
+		colPtr->SetRot(desc.rot);
+		colPtr->SetHalfExtents(desc.halfExtents);
+
+		colPtr->isInitialized = true;
+
+		if (!isQuiet)
+		{
+			Log::Print(
+				"Created new OBB collider with ID '" + to_string(newID) + "'!",
+				"OBB_COLLIDER",
+				LogType::LOG_SUCCESS);
+		}
 
+		return colPtr;
 	}
 
 	const vec3& Collider_OBB::GetPos() const { return pos; }
 	void Collider_OBB::SetPos(const vec3& newValue)
 	{
 		pos = kclamp(newValue, MIN_OBB_POS, MAX_OBB_POS);
+		MarkMoved();
 	}
 
 	const quat& Collider_OBB::GetRot() const { return rot; }
 	void Collider_OBB::SetRot(const quat& newValue)
 	{
 		rot = normalize_q(newValue);
+		MarkMoved();
 	}
 
 	const vec3& Collider_OBB::GetHalfExtents() const { return halfExtents; }
 	void Collider_OBB::SetHalfExtents(const vec3& newValue)
 	{
 		halfExtents = kclamp(newValue, MIN_OBB_HALF_EXTENTS, MAX_OBB_HALF_EXTENTS);
+		MarkMoved();
+	}
+
+	ColliderBounds Collider_OBB::GetBounds() const
+	{
+		vec3 ax{};
+		vec3 ay{};
+		vec3 az{};
+		vbasis(rot, ax, ay, az);
+
+		//project the rotated half extents back onto the world axes
+		vec3 extents =
+			vabs(ax) * halfExtents.x
+			+ vabs(ay) * halfExtents.y
+			+ vabs(az) * halfExtents.z;
+
+		return { pos - extents, pos + extents };
+	}
+
+	void Collider_OBB::Translate(const vec3& delta)
+	{
+		pos += delta;
+		MarkMoved();
+	}
+
+	void Collider_OBB::GetPose(
+		vec3& outPos,
+		quat& outRot) const
+	{
+		outPos = pos;
+		outRot = rot;
+	}
+	void Collider_OBB::SetPose(
+		const vec3& newPos,
+		const quat& newRot)
+	{
+		pos = newPos;
+		rot = newRot;
+	}
+
+	f32 Collider_OBB::GetMassProperties(
+		vec3& outCentroid,
+		vec3& outInertia) const
+	{
+		outCentroid = vec3(0.0f);
+		outInertia = vbox_inertia(halfExtents);
+
+		return 8.0f * halfExtents.x * halfExtents.y * halfExtents.z;
+	}
+
+	ConvexSupport Collider_OBB::GetSupport() const
+	{
+		ConvexSupport s{};
+		s.kind = SupportKind::SUPPORT_BOX;
+		s.pos = pos;
+		s.rot = rot;
+		s.isRotated = true;
+		s.halfExtents = halfExtents;
+
+		return s;
 	}
 
 	Collider_OBB::~Collider_OBB()
 	{
 
 	}
+}
+
+//never destroyed so colliders released during static teardown can still return their blocks
+BlockPool& GetPool()
+{
+	static BlockPool* pool = new BlockPool(
+		sizeof(Collider_OBB),
+		alignof(Collider_OBB));
+
+	return *pool;
 }
\ No newline at end of file
@@ -0,0 +1,549 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <algorithm>
+#include <cfloat>
+
+#include "physics/collision/kp_contact.hpp"
+#include "physics/collision/kp_collision_math.hpp"
+
+using std::clamp;
+
+namespace KalaPhysics::Physics::Collision
+{
+	//An edge axis only wins over the best face axis if it separates clearly better,
+	//face contacts give full manifolds and keep stacks from flickering between both cases
+	constexpr f32 SAT_EDGE_REL_TOLERANCE = 0.95f;
+	constexpr f32 SAT_EDGE_ABS_TOLERANCE = 0.005f;
+
+	//Clipping a quad by four planes adds at most one point per plane
+	constexpr u8 MAX_CLIP_POINTS = 8;
+
+	static u8 ClipPolygon(
+		const vec3* in,
+		u8 inCount,
+		const vec3& planeNormal,
+		f32 planeOffset,
+		vec3* out);
+
+	static u8 ReduceContacts(
+		const vec3* points,
+		const f32* depths,
+		u8 count,
+		const vec3& normal,
+		u8* outIndices);
+
+	bool CollideSpheres(
+		const vec3& centerA,
+		f32 radiusA,
+		const vec3& centerB,
+		f32 radiusB,
+		ContactManifold& outManifold)
+	{
+		vec3 delta = centerB - centerA;
+		f32 radii = radiusA + radiusB;
+		f32 dist2 = vlength2(delta);
+
+		if (dist2 > radii * radii) return false;
+
+		f32 dist = sqrt(dist2);
+
+		//concentric spheres have no preferred direction, push along up
+		vec3 normal = dist > 1e-6f
+			? delta * (1.0f / dist)
+			: vec3(0.0f, 1.0f, 0.0f);
+
+		f32 depth = radii - dist;
+
+		outManifold.normal = normal;
+		outManifold.points[0].position = centerA + normal * (radiusA - depth * 0.5f);
+		outManifold.points[0].depth = depth;
+		outManifold.pointCount = 1;
+
+		return true;
+	}
+
+	bool CollideSphereBox(
+		const vec3& center,
+		f32 radius,
+		const vec3& boxMin,
+		const vec3& boxMax,
+		ContactManifold& outManifold)
+	{
+		vec3 closest = vmin(vmax(center, boxMin), boxMax);
+		vec3 delta = closest - center;
+		f32 dist2 = vlength2(delta);
+
+		if (dist2 > radius * radius) return false;
+
+		if (dist2 > 1e-12f)
+		{
+			f32 dist = sqrt(dist2);
+			vec3 normal = delta * (1.0f / dist);
+			f32 depth = radius - dist;
+
+			outManifold.normal = normal;
+			outManifold.points[0].position = closest - normal * (depth * 0.5f);
+			outManifold.points[0].depth = depth;
+			outManifold.pointCount = 1;
+
+			return true;
+		}
+
+		//the center is inside the box, leave through the nearest face
+		vec3 toMin = center - boxMin;
+		vec3 toMax = boxMax - center;
+
+		f32 best = toMin.x;
+		vec3 faceNormal(-1.0f, 0.0f, 0.0f);
+
+		if (toMax.x < best) { best = toMax.x; faceNormal = vec3(1.0f, 0.0f, 0.0f); }
+		if (toMin.y < best) { best = toMin.y; faceNormal = vec3(0.0f, -1.0f, 0.0f); }
+		if (toMax.y < best) { best = toMax.y; faceNormal = vec3(0.0f, 1.0f, 0.0f); }
+		if (toMin.z < best) { best = toMin.z; faceNormal = vec3(0.0f, 0.0f, -1.0f); }
+		if (toMax.z < best) { best = toMax.z; faceNormal = vec3(0.0f, 0.0f, 1.0f); }
+
+		//the box pushes the sphere out through that face, so the normal points back into the box
+		outManifold.normal = -faceNormal;
+		outManifold.points[0].position = center;
+		outManifold.points[0].depth = radius + best;
+		outManifold.pointCount = 1;
+
+		return true;
+	}
+
+	bool CollideBoxes(
+		const vec3& minA,
+		const vec3& maxA,
+		const vec3& minB,
+		const vec3& maxB,
+		ContactManifold& outManifold)
+	{
+		vec3 overlapMin = vmax(minA, minB);
+		vec3 overlapMax = vmin(maxA, maxB);
+		vec3 overlap = overlapMax - overlapMin;
+
+		if (overlap.x < 0.0f
+			|| overlap.y < 0.0f
+			|| overlap.z < 0.0f)
+		{
+			return false;
+		}
+
+		//separate along the axis of least overlap
+		u8 axis = 0;
+		if (overlap.y < vcomp(overlap, axis)) axis = 1;
+		if (overlap.z < vcomp(overlap, axis)) axis = 2;
+
+		f32 centerA = (vcomp(minA, axis) + vcomp(maxA, axis)) * 0.5f;
+		f32 centerB = (vcomp(minB, axis) + vcomp(maxB, axis)) * 0.5f;
+		f32 sign = centerB >= centerA ? 1.0f : -1.0f;
+
+		vec3 normal(0.0f);
+		if (axis == 0) normal.x = sign;
+		else if (axis == 1) normal.y = sign;
+		else normal.z = sign;
+
+		f32 depth = vcomp(overlap, axis);
+
+		//the four corners of the overlap region on its mid plane
+		vec3 mid = (overlapMin + overlapMax) * 0.5f;
+		u8 u = (axis + 1) % 3;
+		u8 v = (axis + 2) % 3;
+
+		for (u8 i = 0; i < 4; i++)
+		{
+			vec3 p = mid;
+			f32 pu = (i & 1) ? vcomp(overlapMax, u) : vcomp(overlapMin, u);
+			f32 pv = (i & 2) ? vcomp(overlapMax, v) : vcomp(overlapMin, v);
+
+			if (u == 0) p.x = pu; else if (u == 1) p.y = pu; else p.z = pu;
+			if (v == 0) p.x = pv; else if (v == 1) p.y = pv; else p.z = pv;
+
+			outManifold.points[i].position = p;
+			outManifold.points[i].depth = depth;
+		}
+
+		outManifold.normal = normal;
+		outManifold.pointCount = 4;
+
+		return true;
+	}
+
+	bool CollideOrientedBoxes(
+		const vec3& centerA,
+		const quat& rotA,
+		const vec3& halfA,
+		const vec3& centerB,
+		const quat& rotB,
+		const vec3& halfB,
+		vec3& inOutAxis,
+		ContactManifold& outManifold)
+	{
+		vec3 axesA[3]{};
+		vec3 axesB[3]{};
+		vbasis(rotA, axesA[0], axesA[1], axesA[2]);
+		vbasis(rotB, axesB[0], axesB[1], axesB[2]);
+
+		const f32 ha[3] = { halfA.x, halfA.y, halfA.z };
+		const f32 hb[3] = { halfB.x, halfB.y, halfB.z };
+
+		vec3 t = centerB - centerA;
+
+		//projected radius of a box onto any axis, the axis doesn't need to be unit length
+		auto _radius = [](const vec3* axes, const f32* h, const vec3& l)
+			{
+				return fabs(vdot(axes[0], l)) * h[0]
+					+ fabs(vdot(axes[1], l)) * h[1]
+					+ fabs(vdot(axes[2], l)) * h[2];
+			};
+
+		//the axis that separated or touched last frame usually still decides this frame
+		if (vlength2(inOutAxis) > 1e-12f
+			&& fabs(vdot(t, inOutAxis)) > _radius(axesA, ha, inOutAxis) + _radius(axesB, hb, inOutAxis))
+		{
+			return false;
+		}
+
+		//
+		// FACE AXES
+		//
+
+		//rotation of b in the frame of a, padded so parallel edges never yield a zero cross product
+		f32 absR[3][3]{};
+		for (u8 i = 0; i < 3; i++)
+		{
+			for (u8 j = 0; j < 3; j++)
+			{
+				absR[i][j] = fabs(vdot(axesA[i], axesB[j])) + 1e-6f;
+			}
+		}
+
+		f32 bestFaceSep = -FLT_MAX;
+		u8 bestFace{};
+
+		for (u8 i = 0; i < 3; i++)
+		{
+			f32 sep = fabs(vdot(t, axesA[i]))
+				- (ha[i] + hb[0] * absR[i][0] + hb[1] * absR[i][1] + hb[2] * absR[i][2]);
+
+			if (sep > 0.0f)
+			{
+				inOutAxis = axesA[i];
+				return false;
+			}
+			if (sep > bestFaceSep)
+			{
+				bestFaceSep = sep;
+				bestFace = i;
+			}
+		}
+
+		for (u8 j = 0; j < 3; j++)
+		{
+			f32 sep = fabs(vdot(t, axesB[j]))
+				- (ha[0] * absR[0][j] + ha[1] * absR[1][j] + ha[2] * absR[2][j] + hb[j]);
+
+			if (sep > 0.0f)
+			{
+				inOutAxis = axesB[j];
+				return false;
+			}
+			if (sep > bestFaceSep)
+			{
+				bestFaceSep = sep;
+				bestFace = 3 + j;
+			}
+		}
+
+		//
+		// EDGE AXES
+		//
+
+		f32 bestEdgeSep = -FLT_MAX;
+		u8 edgeA{};
+		u8 edgeB{};
+		vec3 edgeAxis{};
+
+		for (u8 i = 0; i < 3; i++)
+		{
+			for (u8 j = 0; j < 3; j++)
+			{
+				vec3 l = vcross(axesA[i], axesB[j]);
+				f32 len = vlength(l);
+
+				//parallel edges, the face axes already cover this direction
+				if (len < 1e-5f) continue;
+
+				l = l * (1.0f / len);
+
+				f32 sep = fabs(vdot(t, l)) - (_radius(axesA, ha, l) + _radius(axesB, hb, l));
+
+				if (sep > 0.0f)
+				{
+					inOutAxis = l;
+					return false;
+				}
+				if (sep > bestEdgeSep)
+				{
+					bestEdgeSep = sep;
+					edgeA = i;
+					edgeB = j;
+					edgeAxis = l;
+				}
+			}
+		}
+
+		//
+		// EDGE CONTACT
+		//
+
+		if (bestEdgeSep > SAT_EDGE_REL_TOLERANCE * bestFaceSep + SAT_EDGE_ABS_TOLERANCE)
+		{
+			vec3 normal = vdot(edgeAxis, t) < 0.0f ? -edgeAxis : edgeAxis;
+
+			//midpoints of the edge of a furthest along the normal and the edge of b furthest against it
+			vec3 pa = centerA;
+			vec3 pb = centerB;
+			for (u8 k = 0; k < 3; k++)
+			{
+				if (k != edgeA) pa += axesA[k] * (vdot(axesA[k], normal) > 0.0f ? ha[k] : -ha[k]);
+				if (k != edgeB) pb += axesB[k] * (vdot(axesB[k], normal) > 0.0f ? -hb[k] : hb[k]);
+			}
+
+			//closest points between both edges, both directions are unit length
+			const vec3& da = axesA[edgeA];
+			const vec3& db = axesB[edgeB];
+			vec3 r = pa - pb;
+
+			f32 b = vdot(da, db);
+			f32 c = vdot(da, r);
+			f32 f = vdot(db, r);
+			f32 denom = 1.0f - b * b;
+
+			f32 s = denom > 1e-6f ? clamp((b * f - c) / denom, -ha[edgeA], ha[edgeA]) : 0.0f;
+			f32 u = clamp(b * s + f, -hb[edgeB], hb[edgeB]);
+			s = clamp(b * u - c, -ha[edgeA], ha[edgeA]);
+
+			outManifold.normal = normal;
+			outManifold.points[0].position = (pa + da * s + pb + db * u) * 0.5f;
+			outManifold.points[0].depth = -bestEdgeSep;
+			outManifold.pointCount = 1;
+
+			inOutAxis = -normal;
+			return true;
+		}
+
+		//
+		// FACE CONTACT
+		//
+
+		bool isRefA = bestFace < 3;
+		u8 refAxis = bestFace % 3;
+
+		const vec3* refAxes = isRefA ? axesA : axesB;
+		const f32* refHalf = isRefA ? ha : hb;
+		const vec3& refCenter = isRefA ? centerA : centerB;
+
+		const vec3* incAxes = isRefA ? axesB : axesA;
+		const f32* incHalf = isRefA ? hb : ha;
+		const vec3& incCenter = isRefA ? centerB : centerA;
+
+		//reference face normal, pointing from the reference box towards the incident box
+		vec3 n = refAxes[refAxis];
+		if (vdot(n, incCenter - refCenter) < 0.0f) n = -n;
+
+		//the incident face is the one most opposed to the reference normal
+		u8 incAxis{};
+		f32 incDot = 0.0f;
+		for (u8 k = 0; k < 3; k++)
+		{
+			f32 d = vdot(n, incAxes[k]);
+			if (fabs(d) > fabs(incDot))
+			{
+				incDot = d;
+				incAxis = k;
+			}
+		}
+
+		vec3 incNormal = incDot > 0.0f ? -incAxes[incAxis] : incAxes[incAxis];
+		vec3 incFace = incCenter + incNormal * incHalf[incAxis];
+
+		u8 iu = (incAxis + 1) % 3;
+		u8 iv = (incAxis + 2) % 3;
+		vec3 eu = incAxes[iu] * incHalf[iu];
+		vec3 ev = incAxes[iv] * incHalf[iv];
+
+		vec3 bufferA[MAX_CLIP_POINTS]{};
+		vec3 bufferB[MAX_CLIP_POINTS]{};
+
+		bufferA[0] = incFace + eu + ev;
+		bufferA[1] = incFace - eu + ev;
+		bufferA[2] = incFace - eu - ev;
+		bufferA[3] = incFace + eu - ev;
+		u8 count = 4;
+
+		//clip the incident face against the four side planes of the reference face
+		u8 ru = (refAxis + 1) % 3;
+		u8 rv = (refAxis + 2) % 3;
+
+		const vec3 sideNormals[4] = { refAxes[ru], -refAxes[ru], refAxes[rv], -refAxes[rv] };
+		const f32 sideHalf[4] = { refHalf[ru], refHalf[ru], refHalf[rv], refHalf[rv] };
+
+		vec3* in = bufferA;
+		vec3* out = bufferB;
+		for (u8 k = 0; k < 4 && count > 0; k++)
+		{
+			f32 offset = vdot(sideNormals[k], refCenter) + sideHalf[k];
+			count = ClipPolygon(in, count, sideNormals[k], offset, out);
+
+			vec3* swapBuffer = in;
+			in = out;
+			out = swapBuffer;
+		}
+
+		//keep the clipped points below the reference face
+		f32 faceOffset = vdot(n, refCenter) + refHalf[refAxis];
+
+		vec3 points[MAX_CLIP_POINTS]{};
+		f32 depths[MAX_CLIP_POINTS]{};
+		u8 kept{};
+
+		for (u8 k = 0; k < count; k++)
+		{
+			f32 depth = faceOffset - vdot(n, in[k]);
+			if (depth < 0.0f) continue;
+
+			//halfway between the incident point and the reference face
+			points[kept] = in[k] + n * (depth * 0.5f);
+			depths[kept] = depth;
+			++kept;
+		}
+
+		if (kept == 0) return false;
+
+		u8 indices[MAX_CONTACT_POINTS]{};
+		u8 pointCount = ReduceContacts(points, depths, kept, n, indices);
+
+		for (u8 k = 0; k < pointCount; k++)
+		{
+			outManifold.points[k].position = points[indices[k]];
+			outManifold.points[k].depth = depths[indices[k]];
+		}
+
+		outManifold.normal = isRefA ? n : -n;
+		outManifold.pointCount = pointCount;
+
+		inOutAxis = -outManifold.normal;
+		return true;
+	}
+
+	void FlipManifold(ContactManifold& manifold)
+	{
+		manifold.normal = -manifold.normal;
+	}
+
+	u8 ClipPolygon(
+		const vec3* in,
+		u8 inCount,
+		const vec3& planeNormal,
+		f32 planeOffset,
+		vec3* out)
+	{
+		if (inCount == 0) return 0;
+
+		u8 outCount{};
+
+		vec3 prev = in[inCount - 1];
+		f32 prevDist = vdot(planeNormal, prev) - planeOffset;
+
+		for (u8 i = 0; i < inCount; i++)
+		{
+			vec3 cur = in[i];
+			f32 curDist = vdot(planeNormal, cur) - planeOffset;
+
+			//the edge crosses the plane, keep the crossing point
+			if ((prevDist <= 0.0f) != (curDist <= 0.0f)
+				&& outCount < MAX_CLIP_POINTS)
+			{
+				out[outCount++] = prev + (cur - prev) * (prevDist / (prevDist - curDist));
+			}
+
+			if (curDist <= 0.0f
+				&& outCount < MAX_CLIP_POINTS)
+			{
+				out[outCount++] = cur;
+			}
+
+			prev = cur;
+			prevDist = curDist;
+		}
+
+		return outCount;
+	}
+
+	u8 ReduceContacts(
+		const vec3* points,
+		const f32* depths,
+		u8 count,
+		const vec3& normal,
+		u8* outIndices)
+	{
+		if (count <= MAX_CONTACT_POINTS)
+		{
+			for (u8 i = 0; i < count; i++) outIndices[i] = i;
+			return count;
+		}
+
+		//the deepest point, the point furthest from it, then the points
+		//spanning the largest triangle on either side of the line between both
+		u8 first{};
+		for (u8 i = 1; i < count; i++)
+		{
+			if (depths[i] > depths[first]) first = i;
+		}
+
+		u8 second = first;
+		f32 bestDist2 = -1.0f;
+		for (u8 i = 0; i < count; i++)
+		{
+			f32 d2 = vlength2(points[i] - points[first]);
+			if (d2 > bestDist2)
+			{
+				bestDist2 = d2;
+				second = i;
+			}
+		}
+
+		u8 third = first;
+		u8 fourth = first;
+		f32 maxArea = 0.0f;
+		f32 minArea = 0.0f;
+
+		vec3 edge = points[second] - points[first];
+		for (u8 i = 0; i < count; i++)
+		{
+			f32 area = vdot(vcross(edge, points[i] - points[first]), normal);
+			if (area > maxArea)
+			{
+				maxArea = area;
+				third = i;
+			}
+			if (area < minArea)
+			{
+				minArea = area;
+				fourth = i;
+			}
+		}
+
+		u8 result{};
+		outIndices[result++] = first;
+		if (second != first) outIndices[result++] = second;
+		if (third != first) outIndices[result++] = third;
+		if (fourth != first) outIndices[result++] = fourth;
+
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,322 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <algorithm>
+
+#include "physics/collision/kp_dynamic_tree.hpp"
+
+using std::max;
+using std::abs;
+
+namespace KalaPhysics::Physics::Collision
+{
+	i32 DynamicTree::CreateProxy(
+		const ColliderBounds& fatBounds,
+		Collider* collider,
+		u32 mask)
+	{
+		i32 leaf = AllocateNode();
+
+		DynamicTreeNode& node = nodes[leaf];
+		node.bounds = fatBounds;
+		node.collider = collider;
+		node.mask = mask;
+		node.height = 0;
+
+		InsertLeaf(leaf);
+		++proxyCount;
+
+		return leaf;
+	}
+	void DynamicTree::DestroyProxy(i32 proxyID)
+	{
+		if (!IsValidProxy(proxyID)) return;
+
+		RemoveLeaf(proxyID);
+		FreeNode(proxyID);
+		--proxyCount;
+	}
+
+	bool DynamicTree::MoveProxy(
+		i32 proxyID,
+		const ColliderBounds& tightBounds,
+		f32 margin)
+	{
+		if (!IsValidProxy(proxyID)) return false;
+
+		//still inside the fat bounds, nothing to do
+		if (nodes[proxyID].bounds.Contains(tightBounds)) return false;
+
+		RemoveLeaf(proxyID);
+		nodes[proxyID].bounds = tightBounds.Expanded(margin);
+		InsertLeaf(proxyID);
+
+		return true;
+	}
+
+	void DynamicTree::SetProxyMask(
+		i32 proxyID,
+		u32 mask)
+	{
+		if (!IsValidProxy(proxyID)
+			|| nodes[proxyID].mask == mask)
+		{
+			return;
+		}
+
+		nodes[proxyID].mask = mask;
+
+		for (i32 index = nodes[proxyID].parent; index != NULL_NODE; index = nodes[index].parent)
+		{
+			nodes[index].mask = nodes[nodes[index].child1].mask | nodes[nodes[index].child2].mask;
+		}
+	}
+
+	bool DynamicTree::IsValidProxy(i32 proxyID) const
+	{
+		return proxyID >= 0
+			&& proxyID < scast<i32>(nodes.size())
+			&& nodes[proxyID].height == 0;
+	}
+
+	Collider* DynamicTree::GetCollider(i32 proxyID) const
+	{
+		return IsValidProxy(proxyID)
+			? nodes[proxyID].collider
+			: nullptr;
+	}
+	const ColliderBounds& DynamicTree::GetFatBounds(i32 proxyID) const { return nodes[proxyID].bounds; }
+
+	i32 DynamicTree::GetRoot() const { return root; }
+	const vector<DynamicTreeNode>& DynamicTree::GetNodes() const { return nodes; }
+
+	u32 DynamicTree::GetProxyCount() const { return proxyCount; }
+	i32 DynamicTree::GetHeight() const
+	{
+		return root == NULL_NODE
+			? 0
+			: nodes[root].height;
+	}
+
+	void DynamicTree::Clear()
+	{
+		nodes.clear();
+		root = NULL_NODE;
+		freeList = NULL_NODE;
+		proxyCount = 0;
+	}
+
+	i32 DynamicTree::AllocateNode()
+	{
+		if (freeList == NULL_NODE)
+		{
+			nodes.push_back({});
+			return scast<i32>(nodes.size() - 1);
+		}
+
+		i32 nodeID = freeList;
+		freeList = nodes[nodeID].parent;
+		nodes[nodeID] = DynamicTreeNode{};
+
+		return nodeID;
+	}
+	void DynamicTree::FreeNode(i32 nodeID)
+	{
+		DynamicTreeNode& node = nodes[nodeID];
+		node.collider = nullptr;
+		node.child1 = NULL_NODE;
+		node.child2 = NULL_NODE;
+		node.height = -1;
+		node.parent = freeList;
+
+		freeList = nodeID;
+	}
+
+	void DynamicTree::InsertLeaf(i32 leaf)
+	{
+		if (root == NULL_NODE)
+		{
+			root = leaf;
+			nodes[root].parent = NULL_NODE;
+			return;
+		}
+
+		//find the cheapest sibling by walking down the surface area cost
+		ColliderBounds leafBounds = nodes[leaf].bounds;
+		i32 index = root;
+
+		while (!nodes[index].IsLeaf())
+		{
+			const DynamicTreeNode& node = nodes[index];
+			i32 child1 = node.child1;
+			i32 child2 = node.child2;
+
+			f32 area = node.bounds.GetPerimeter();
+			f32 combinedArea = node.bounds.Merged(leafBounds).GetPerimeter();
+
+			//cost of creating a new parent for this node and the new leaf
+			f32 cost = 2.0f * combinedArea;
+			//minimum cost of pushing the leaf further down the tree
+			f32 inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto _descend_cost = [&](i32 child)
+				{
+					const DynamicTreeNode& c = nodes[child];
+					f32 merged = c.bounds.Merged(leafBounds).GetPerimeter();
+
+					return c.IsLeaf()
+						? merged + inheritanceCost
+						: merged - c.bounds.GetPerimeter() + inheritanceCost;
+				};
+
+			f32 cost1 = _descend_cost(child1);
+			f32 cost2 = _descend_cost(child2);
+
+			if (cost < cost1 && cost < cost2) break;
+
+			index = cost1 < cost2 ? child1 : child2;
+		}
+
+		i32 sibling = index;
+
+		//create a new parent for the sibling and the leaf
+		i32 oldParent = nodes[sibling].parent;
+		i32 newParent = AllocateNode();
+
+		nodes[newParent].parent = oldParent;
+		nodes[newParent].bounds = leafBounds.Merged(nodes[sibling].bounds);
+		nodes[newParent].mask = nodes[leaf].mask | nodes[sibling].mask;
+		nodes[newParent].height = nodes[sibling].height + 1;
+		nodes[newParent].child1 = sibling;
+		nodes[newParent].child2 = leaf;
+
+		nodes[sibling].parent = newParent;
+		nodes[leaf].parent = newParent;
+
+		if (oldParent != NULL_NODE)
+		{
+			if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+			else nodes[oldParent].child2 = newParent;
+		}
+		else root = newParent;
+
+		//walk back up, refitting bounds and rebalancing
+		index = nodes[leaf].parent;
+		while (index != NULL_NODE)
+		{
+			index = Balance(index);
+
+			i32 child1 = nodes[index].child1;
+			i32 child2 = nodes[index].child2;
+
+			nodes[index].height = 1 + max(nodes[child1].height, nodes[child2].height);
+			nodes[index].bounds = nodes[child1].bounds.Merged(nodes[child2].bounds);
+			nodes[index].mask = nodes[child1].mask | nodes[child2].mask;
+
+			index = nodes[index].parent;
+		}
+	}
+	void DynamicTree::RemoveLeaf(i32 leaf)
+	{
+		if (leaf == root)
+		{
+			root = NULL_NODE;
+			return;
+		}
+
+		i32 parent = nodes[leaf].parent;
+		i32 grandParent = nodes[parent].parent;
+		i32 sibling = nodes[parent].child1 == leaf
+			? nodes[parent].child2
+			: nodes[parent].child1;
+
+		if (grandParent == NULL_NODE)
+		{
+			root = sibling;
+			nodes[sibling].parent = NULL_NODE;
+			FreeNode(parent);
+
+			return;
+		}
+
+		//connect the sibling to the grandparent and drop the parent
+		if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+		else nodes[grandParent].child2 = sibling;
+
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		i32 index = grandParent;
+		while (index != NULL_NODE)
+		{
+			index = Balance(index);
+
+			i32 child1 = nodes[index].child1;
+			i32 child2 = nodes[index].child2;
+
+			nodes[index].bounds = nodes[child1].bounds.Merged(nodes[child2].bounds);
+			nodes[index].height = 1 + max(nodes[child1].height, nodes[child2].height);
+			nodes[index].mask = nodes[child1].mask | nodes[child2].mask;
+
+			index = nodes[index].parent;
+		}
+	}
+
+	i32 DynamicTree::Balance(i32 iA)
+	{
+		DynamicTreeNode* A = &nodes[iA];
+		if (A->IsLeaf() || A->height < 2) return iA;
+
+		i32 iB = A->child1;
+		i32 iC = A->child2;
+
+		i32 balance = nodes[iC].height - nodes[iB].height;
+
+		//rotate the taller child up
+		auto _rotate = [&](i32 iUp, i32 iOther, bool upIsChild2)
+			{
+				DynamicTreeNode& up = nodes[iUp];
+				i32 iF = up.child1;
+				i32 iG = up.child2;
+
+				//swap A and the taller child
+				up.child1 = iA;
+				up.parent = A->parent;
+				A->parent = iUp;
+
+				if (up.parent != NULL_NODE)
+				{
+					if (nodes[up.parent].child1 == iA) nodes[up.parent].child1 = iUp;
+					else nodes[up.parent].child2 = iUp;
+				}
+				else root = iUp;
+
+				//keep the taller grandchild under the rotated node
+				i32 iKeep = nodes[iF].height > nodes[iG].height ? iF : iG;
+				i32 iMove = iKeep == iF ? iG : iF;
+
+				up.child2 = iKeep;
+				if (upIsChild2) A->child2 = iMove;
+				else A->child1 = iMove;
+				nodes[iMove].parent = iA;
+
+				A->bounds = nodes[iOther].bounds.Merged(nodes[iMove].bounds);
+				up.bounds = A->bounds.Merged(nodes[iKeep].bounds);
+
+				A->mask = nodes[iOther].mask | nodes[iMove].mask;
+				up.mask = A->mask | nodes[iKeep].mask;
+
+				A->height = 1 + max(nodes[iOther].height, nodes[iMove].height);
+				up.height = 1 + max(A->height, nodes[iKeep].height);
+
+				return iUp;
+			};
+
+		if (balance > 1) return _rotate(iC, iB, true);
+		if (balance < -1) return _rotate(iB, iC, false);
+
+		return iA;
+	}
+}
\ No newline at end of file
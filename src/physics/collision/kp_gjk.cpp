@@ -0,0 +1,1020 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <array>
+#include <span>
+#include <algorithm>
+#include <cfloat>
+
+#include "physics/collision/kp_gjk.hpp"
+#include "physics/collision/kp_collider_bsp.hpp"
+#include "physics/collision/kp_collider_aabb.hpp"
+#include "physics/collision/kp_collider_obb.hpp"
+#include "physics/collision/kp_collider_bcp.hpp"
+#include "physics/collision/kp_collider_kdop.hpp"
+#include "physics/collision/kp_collider_bch.hpp"
+#include "core/kp_profiler.hpp"
+
+using std::vector;
+using std::array;
+using std::span;
+using std::sort;
+using std::unique;
+using std::swap;
+using std::min;
+
+namespace KalaPhysics::Physics::Collision
+{
+	struct SimplexVertex
+	{
+		vec3 w{}; //a - b
+		vec3 a{}; //support point on a
+		vec3 b{}; //support point on b
+	};
+
+	struct Simplex
+	{
+		array<SimplexVertex, 4> v{};
+		array<f32, 4> bc{}; //barycentric weights of the closest point
+		u32 count{};
+	};
+
+	struct EpaFace
+	{
+		u32 i0{};
+		u32 i1{};
+		u32 i2{};
+
+		vec3 normal{};
+		f32 dist{};
+	};
+
+	struct EpaEdge
+	{
+		u32 from{};
+		u32 to{};
+	};
+
+	static SimplexVertex SupportPoint(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		const vec3& dir);
+
+	static bool SolveSimplex(Simplex& s);
+	static void SolveSegment(Simplex& s);
+	static void SolveTriangle(Simplex& s);
+	static bool SolveTetrahedron(Simplex& s);
+
+	static bool FillTetrahedron(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		Simplex& s);
+
+	static bool RunEPA(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		Simplex& s,
+		ConvexResult& outResult);
+
+	vec3 ConvexSupport::Support(const vec3& dir) const
+	{
+		switch (kind)
+		{
+		case SupportKind::SUPPORT_POINT:
+			return pos;
+		case SupportKind::SUPPORT_BOX:
+		{
+			vec3 d = isRotated ? vrotate_inv(rot, dir) : dir;
+			vec3 p(
+				d.x >= 0.0f ? halfExtents.x : -halfExtents.x,
+				d.y >= 0.0f ? halfExtents.y : -halfExtents.y,
+				d.z >= 0.0f ? halfExtents.z : -halfExtents.z);
+
+			return pos + (isRotated ? vrotate(rot, p) : p);
+		}
+		case SupportKind::SUPPORT_SEGMENT:
+		{
+			vec3 d = isRotated ? vrotate_inv(rot, dir) : dir;
+			vec3 p(0.0f, d.y >= 0.0f ? halfHeight : -halfHeight, 0.0f);
+
+			return pos + (isRotated ? vrotate(rot, p) : p);
+		}
+		case SupportKind::SUPPORT_POINTS:
+		{
+			if (vertexCount == 0) return pos;
+
+			vec3 d = isRotated ? vrotate_inv(rot, dir) : dir;
+
+			u32 best{};
+
+			if (adjacency
+				&& vertexCount >= HULL_HILL_CLIMB_MIN_VERTICES)
+			{
+				//walk the hull edges uphill, a convex hull has no local maximum
+				//so the first vertex without a better neighbour is the support point
+				best = hint;
+				f32 bestDot = vdot(vertices[best], d);
+
+				bool improved = true;
+				while (improved)
+				{
+					improved = false;
+
+					for (u32 e = adjacencyStart[best]; e < adjacencyStart[best + 1]; e++)
+					{
+						u32 n = adjacency[e];
+						f32 nd = vdot(vertices[n], d);
+						if (nd > bestDot)
+						{
+							best = n;
+							bestDot = nd;
+							improved = true;
+							break;
+						}
+					}
+				}
+
+				hint = best;
+			}
+			else
+			{
+				f32 bestDot = vdot(vertices[0], d);
+				for (u32 i = 1; i < vertexCount; i++)
+				{
+					f32 nd = vdot(vertices[i], d);
+					if (nd > bestDot)
+					{
+						best = i;
+						bestDot = nd;
+					}
+				}
+			}
+
+			return pos + (isRotated ? vrotate(rot, vertices[best]) : vertices[best]);
+		}
+		}
+
+		return pos;
+	}
+
+	ConvexSupport GetColliderSupport(const Collider* c)
+	{
+		switch (c->GetColliderShape())
+		{
+		case ColliderShape::COLLIDER_BSP:
+			return scast<const Collider_BSP*>(c)->GetSupport();
+		case ColliderShape::COLLIDER_AABB:
+			return scast<const Collider_AABB*>(c)->GetSupport();
+		case ColliderShape::COLLIDER_OBB:
+			return scast<const Collider_OBB*>(c)->GetSupport();
+		case ColliderShape::COLLIDER_BCP:
+			return scast<const Collider_BCP*>(c)->GetSupport();
+		case ColliderShape::COLLIDER_KDOP_10_X:
+		case ColliderShape::COLLIDER_KDOP_10_Y:
+		case ColliderShape::COLLIDER_KDOP_10_Z:
+		case ColliderShape::COLLIDER_KDOP_18:
+		case ColliderShape::COLLIDER_KDOP_26:
+			return scast<const Collider_KDOP*>(c)->GetSupport();
+		case ColliderShape::COLLIDER_BCH:
+			return scast<const Collider_BCH*>(c)->GetSupport();
+		}
+
+		return {};
+	}
+
+	bool ConvexQuery(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		vec3& inOutAxis,
+		ConvexResult& outResult)
+	{
+		f32 margin = a.radius + b.radius;
+
+		//the cached axis points from b to a, start with the vertex it predicts to be closest
+		vec3 axis = inOutAxis;
+		if (vlength2(axis) < 1e-12f) axis = a.pos - b.pos;
+		if (vlength2(axis) < 1e-12f) axis = vec3(1.0f, 0.0f, 0.0f);
+
+		Simplex s{};
+		s.v[0] = SupportPoint(a, b, vec3(0.0f) - axis);
+		s.bc[0] = 1.0f;
+		s.count = 1;
+
+		vec3 v = s.v[0].w;
+		f32 dist2 = FLT_MAX;
+		bool isOverlapping = false;
+
+		u32 iterations{};
+		for (; iterations < GJK_MAX_ITERATIONS; iterations++)
+		{
+			f32 vv = vlength2(v);
+
+			//the origin lies on the simplex, the cores touch or overlap
+			if (vv < 1e-12f)
+			{
+				isOverlapping = true;
+				break;
+			}
+
+			SimplexVertex sv = SupportPoint(a, b, vec3(0.0f) - v);
+			f32 vw = vdot(v, sv.w);
+
+			//the support plane already separates the cores by more than both radii
+			if (vw > 0.0f
+				&& vw * vw > margin * margin * vv)
+			{
+				KP_PROFILE_COUNT(COUNTER_GJK_ITERATIONS, iterations + 1);
+
+				inOutAxis = v;
+				return false;
+			}
+
+			//no support point gets meaningfully closer, v is the closest point
+			if (vv - vw <= GJK_TOLERANCE * vv) break;
+
+			bool isDuplicate = false;
+			for (u32 i = 0; i < s.count; i++)
+			{
+				if (vlength2(s.v[i].w - sv.w) < 1e-12f) isDuplicate = true;
+			}
+			if (isDuplicate) break;
+
+			Simplex previous = s;
+			s.v[s.count++] = sv;
+
+			if (!SolveSimplex(s))
+			{
+				isOverlapping = true;
+				break;
+			}
+
+			vec3 next(0.0f);
+			for (u32 i = 0; i < s.count; i++) next += s.v[i].w * s.bc[i];
+
+			//rounding can stall the descent, stop once it no longer shrinks
+			//and keep the last simplex that still got closer
+			f32 newDist2 = vlength2(next);
+			if (newDist2 >= dist2)
+			{
+				s = previous;
+				break;
+			}
+			v = next;
+			dist2 = newDist2;
+		}
+
+		//breaking out leaves iterations one short of the iterations that ran
+		KP_PROFILE_COUNT(COUNTER_GJK_ITERATIONS, min(iterations + 1, GJK_MAX_ITERATIONS));
+
+		if (!isOverlapping)
+		{
+			f32 dist = vlength(v);
+
+			if (dist > margin)
+			{
+				inOutAxis = v;
+				return false;
+			}
+
+			//cores this close have no usable direction between them, let EPA find one
+			if (dist >= 1e-6f)
+			{
+				vec3 pa(0.0f);
+				vec3 pb(0.0f);
+				for (u32 i = 0; i < s.count; i++)
+				{
+					pa += s.v[i].a * s.bc[i];
+					pb += s.v[i].b * s.bc[i];
+				}
+
+				vec3 normal = v * (-1.0f / dist);
+
+				outResult.isTouching = true;
+				outResult.normal = normal;
+				outResult.pointA = pa + normal * a.radius;
+				outResult.pointB = pb - normal * b.radius;
+				outResult.distance = dist - margin;
+
+				inOutAxis = v;
+				return true;
+			}
+		}
+
+		//
+		// CORES OVERLAP, FIND THE PENETRATION
+		//
+
+		if (!FillTetrahedron(a, b, s)
+			|| !RunEPA(a, b, s, outResult))
+		{
+			//flat cores crossing each other, such as two capsule segments,
+			//only overlap by their radii along the line between the shapes
+			vec3 pa(0.0f);
+			vec3 pb(0.0f);
+			for (u32 i = 0; i < s.count; i++)
+			{
+				pa += s.v[i].a * s.bc[i];
+				pb += s.v[i].b * s.bc[i];
+			}
+
+			vec3 normal = vnormalize(b.pos - a.pos);
+			if (vlength2(normal) < 0.5f) normal = vec3(0.0f, 1.0f, 0.0f);
+
+			outResult.normal = normal;
+			outResult.pointA = pa;
+			outResult.pointB = pb;
+			outResult.distance = 0.0f;
+		}
+
+		//grow the core penetration by both radii
+		outResult.isTouching = true;
+		outResult.pointA += outResult.normal * a.radius;
+		outResult.pointB -= outResult.normal * b.radius;
+		outResult.distance -= margin;
+
+		inOutAxis = vec3(0.0f) - outResult.normal;
+		return true;
+	}
+
+	ConvexCastResult ConvexCast(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		const vec3& motion,
+		f32 separation,
+		f32 tolerance,
+		f32& outTime,
+		vec3& outNormal)
+	{
+		f32 reach = vlength(motion);
+
+		ConvexSupport moving = a;
+		vec3 axis(0.0f);
+		f32 time{};
+
+		for (u32 iter = 0; iter < CONVEX_CAST_MAX_ITERATIONS; iter++)
+		{
+			moving.pos = a.pos + motion * time;
+
+			//inflating the moving core by what is left of the motion keeps GJK
+			//from exiting early while a hit is still possible
+			f32 inflate = reach * (1.0f - time) + separation + tolerance;
+			moving.radius = a.radius + inflate;
+
+			ConvexResult result{};
+			if (!ConvexQuery(moving, b, axis, result)) return ConvexCastResult::CAST_MISS;
+
+			f32 gap = result.distance + inflate;
+
+			if (iter == 0
+				&& gap < 0.0f)
+			{
+				outTime = 0.0f;
+				outNormal = result.normal;
+				return ConvexCastResult::CAST_OVERLAPPING;
+			}
+
+			//linear motion against a convex shape, the gap can only shrink while approaching
+			f32 approach = vdot(motion, result.normal);
+			if (approach <= 0.0f) return ConvexCastResult::CAST_MISS;
+
+			outNormal = result.normal;
+
+			if (gap < separation + tolerance)
+			{
+				outTime = time;
+				return ConvexCastResult::CAST_HIT;
+			}
+
+			time += (gap - separation) / approach;
+			if (time > 1.0f) return ConvexCastResult::CAST_MISS;
+		}
+
+		//out of iterations, stopping short is the conservative answer
+		outTime = time;
+		return ConvexCastResult::CAST_HIT;
+	}
+
+	bool CollideConvex(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		vec3& inOutAxis,
+		ContactManifold& outManifold)
+	{
+		ConvexResult result{};
+		if (!ConvexQuery(a, b, inOutAxis, result)) return false;
+
+		outManifold.normal = result.normal;
+		outManifold.points[0].position = (result.pointA + result.pointB) * 0.5f;
+		outManifold.points[0].depth = -result.distance;
+		outManifold.pointCount = 1;
+
+		return true;
+	}
+
+	u32 BuildHullAdjacency(
+		span<const vec3> points,
+		vector<u32>& outStart,
+		vector<u32>& outAdjacency)
+	{
+		u32 count = scast<u32>(points.size());
+
+		outStart.assign(count + 1, 0);
+		outAdjacency.clear();
+
+		if (count < 4) return count;
+
+		//
+		// INITIAL TETRAHEDRON
+		//
+
+		vec3 lo = points[0];
+		vec3 hi = points[0];
+		for (const auto& p : points)
+		{
+			lo = vmin(lo, p);
+			hi = vmax(hi, p);
+		}
+
+		f32 eps = vlength(hi - lo) * 1e-5f;
+		if (eps <= 0.0f) return count;
+
+		u32 i0 = 0;
+		u32 i1 = 0;
+		u32 i2 = 0;
+		u32 i3 = 0;
+
+		f32 best = 0.0f;
+		for (u32 i = 1; i < count; i++)
+		{
+			f32 d = vlength2(points[i] - points[i0]);
+			if (d > best) { best = d; i1 = i; }
+		}
+
+		best = 0.0f;
+		vec3 edge = points[i1] - points[i0];
+		for (u32 i = 0; i < count; i++)
+		{
+			f32 d = vlength2(vcross(edge, points[i] - points[i0]));
+			if (d > best) { best = d; i2 = i; }
+		}
+
+		best = 0.0f;
+		vec3 planeNormal = vnormalize(vcross(edge, points[i2] - points[i0]));
+		for (u32 i = 0; i < count; i++)
+		{
+			f32 d = fabs(vdot(planeNormal, points[i] - points[i0]));
+			if (d > best) { best = d; i3 = i; }
+		}
+
+		//flat or degenerate clouds have no volume to climb over
+		if (best <= eps) return count;
+
+		vector<EpaFace> faces{};
+
+		auto _add_face = [&points, &faces](u32 a, u32 b, u32 c)
+			{
+				EpaFace f{ a, b, c };
+				f.normal = vnormalize(vcross(points[b] - points[a], points[c] - points[a]));
+				f.dist = vdot(f.normal, points[a]);
+				faces.push_back(f);
+			};
+
+		vec3 centroid = (points[i0] + points[i1] + points[i2] + points[i3]) * 0.25f;
+
+		array<array<u32, 3>, 4> tetra =
+		{ {
+			{ i0, i1, i2 },
+			{ i0, i3, i1 },
+			{ i1, i3, i2 },
+			{ i2, i3, i0 }
+		} };
+
+		for (auto& t : tetra)
+		{
+			vec3 n = vcross(points[t[1]] - points[t[0]], points[t[2]] - points[t[0]]);
+			if (vdot(n, centroid - points[t[0]]) > 0.0f) swap(t[1], t[2]);
+
+			_add_face(t[0], t[1], t[2]);
+		}
+
+		//
+		// ADD EVERY OUTSIDE POINT
+		//
+
+		vector<EpaEdge> edges{};
+		vector<EpaFace> kept{};
+
+		for (u32 p = 0; p < count; p++)
+		{
+			if (p == i0 || p == i1 || p == i2 || p == i3) continue;
+
+			edges.clear();
+			kept.clear();
+
+			for (const auto& f : faces)
+			{
+				if (vdot(f.normal, points[p]) - f.dist <= eps)
+				{
+					kept.push_back(f);
+					continue;
+				}
+
+				//edges shared by two visible faces cancel out, the rest form the horizon
+				array<EpaEdge, 3> fe = { { { f.i0, f.i1 }, { f.i1, f.i2 }, { f.i2, f.i0 } } };
+				for (const auto& e : fe)
+				{
+					auto it = find_if(
+						edges.begin(),
+						edges.end(),
+						[&e](const EpaEdge& o) { return o.from == e.to && o.to == e.from; });
+
+					if (it != edges.end())
+					{
+						*it = edges.back();
+						edges.pop_back();
+					}
+					else edges.push_back(e);
+				}
+			}
+
+			if (edges.empty()) continue;
+
+			faces.swap(kept);
+			for (const auto& e : edges) _add_face(e.from, e.to, p);
+		}
+
+		//
+		// EDGE GRAPH IN COMPRESSED ROWS
+		//
+
+		vector<EpaEdge> links{};
+		links.reserve(faces.size() * 3);
+		for (const auto& f : faces)
+		{
+			links.push_back({ f.i0, f.i1 });
+			links.push_back({ f.i1, f.i2 });
+			links.push_back({ f.i2, f.i0 });
+		}
+
+		//every hull edge appears once per direction, one per adjacent face
+		sort(
+			links.begin(),
+			links.end(),
+			[](const EpaEdge& x, const EpaEdge& y)
+			{
+				return x.from != y.from ? x.from < y.from : x.to < y.to;
+			});
+		links.erase(unique(
+			links.begin(),
+			links.end(),
+			[](const EpaEdge& x, const EpaEdge& y)
+			{
+				return x.from == y.from && x.to == y.to;
+			}), links.end());
+
+		outAdjacency.reserve(links.size());
+		for (const auto& l : links)
+		{
+			++outStart[l.from + 1];
+			outAdjacency.push_back(l.to);
+		}
+		for (u32 i = 0; i < count; i++) outStart[i + 1] += outStart[i];
+
+		//the point furthest from any other point is always on the hull
+		return i1;
+	}
+
+	SimplexVertex SupportPoint(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		const vec3& dir)
+	{
+		SimplexVertex sv{};
+		sv.a = a.Support(dir);
+		sv.b = b.Support(vec3(0.0f) - dir);
+		sv.w = sv.a - sv.b;
+
+		return sv;
+	}
+
+	//
+	// CLOSEST POINT OF THE SIMPLEX TO THE ORIGIN
+	//
+	// Every solver reduces the simplex to the smallest feature holding
+	// the closest point and writes its barycentric weights.
+	//
+
+	bool SolveSimplex(Simplex& s)
+	{
+		switch (s.count)
+		{
+		case 2: SolveSegment(s); return true;
+		case 3: SolveTriangle(s); return true;
+		case 4: return SolveTetrahedron(s);
+		}
+
+		s.bc[0] = 1.0f;
+		return true;
+	}
+
+	void SolveSegment(Simplex& s)
+	{
+		vec3 a = s.v[0].w;
+		vec3 ab = s.v[1].w - a;
+
+		f32 denom = vlength2(ab);
+		f32 t = denom > 1e-20f ? -vdot(a, ab) / denom : 0.0f;
+
+		if (t <= 0.0f)
+		{
+			s.count = 1;
+			s.bc[0] = 1.0f;
+		}
+		else if (t >= 1.0f)
+		{
+			s.v[0] = s.v[1];
+			s.count = 1;
+			s.bc[0] = 1.0f;
+		}
+		else
+		{
+			s.bc[0] = 1.0f - t;
+			s.bc[1] = t;
+		}
+	}
+
+	void SolveTriangle(Simplex& s)
+	{
+		vec3 a = s.v[0].w;
+		vec3 b = s.v[1].w;
+		vec3 c = s.v[2].w;
+
+		vec3 ab = b - a;
+		vec3 ac = c - a;
+
+		auto _keep_vertex = [&s](u32 i)
+			{
+				s.v[0] = s.v[i];
+				s.bc[0] = 1.0f;
+				s.count = 1;
+			};
+		auto _keep_edge = [&s](u32 i, u32 j, f32 t)
+			{
+				SimplexVertex vi = s.v[i];
+				SimplexVertex vj = s.v[j];
+				s.v[0] = vi;
+				s.v[1] = vj;
+				s.bc[0] = 1.0f - t;
+				s.bc[1] = t;
+				s.count = 2;
+			};
+
+		f32 d1 = -vdot(ab, a);
+		f32 d2 = -vdot(ac, a);
+		if (d1 <= 0.0f && d2 <= 0.0f) { _keep_vertex(0); return; }
+
+		f32 d3 = -vdot(ab, b);
+		f32 d4 = -vdot(ac, b);
+		if (d3 >= 0.0f && d4 <= d3) { _keep_vertex(1); return; }
+
+		f32 vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+		{
+			_keep_edge(0, 1, d1 / (d1 - d3));
+			return;
+		}
+
+		f32 d5 = -vdot(ab, c);
+		f32 d6 = -vdot(ac, c);
+		if (d6 >= 0.0f && d5 <= d6) { _keep_vertex(2); return; }
+
+		f32 vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+		{
+			_keep_edge(0, 2, d2 / (d2 - d6));
+			return;
+		}
+
+		f32 va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+		{
+			_keep_edge(1, 2, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+			return;
+		}
+
+		f32 sum = va + vb + vc;
+
+		//zero-area triangle, its longest edge holds the closest point
+		if (sum <= 1e-20f)
+		{
+			Simplex best{};
+			f32 bestDist2 = FLT_MAX;
+
+			const u32 pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+			for (const auto& p : pairs)
+			{
+				Simplex e{};
+				e.v[0] = s.v[p[0]];
+				e.v[1] = s.v[p[1]];
+				e.count = 2;
+				SolveSegment(e);
+
+				vec3 v(0.0f);
+				for (u32 i = 0; i < e.count; i++) v += e.v[i].w * e.bc[i];
+
+				f32 d2e = vlength2(v);
+				if (d2e < bestDist2)
+				{
+					bestDist2 = d2e;
+					best = e;
+				}
+			}
+
+			s = best;
+			return;
+		}
+
+		f32 inv = 1.0f / sum;
+		s.bc[1] = vb * inv;
+		s.bc[2] = vc * inv;
+		s.bc[0] = 1.0f - s.bc[1] - s.bc[2];
+	}
+
+	bool SolveTetrahedron(Simplex& s)
+	{
+		//faces with the index of the vertex opposite to them
+		const u32 faces[4][4] =
+		{
+			{ 0, 1, 2, 3 },
+			{ 0, 2, 3, 1 },
+			{ 0, 3, 1, 2 },
+			{ 1, 3, 2, 0 }
+		};
+
+		Simplex best{};
+		f32 bestDist2 = FLT_MAX;
+		bool isOutside = false;
+
+		for (const auto& f : faces)
+		{
+			vec3 a = s.v[f[0]].w;
+			vec3 n = vcross(s.v[f[1]].w - a, s.v[f[2]].w - a);
+
+			f32 signOrigin = -vdot(n, a);
+			f32 signOpposite = vdot(n, s.v[f[3]].w - a);
+
+			//the origin is on the same side as the opposite vertex, this face can't be closest,
+			//flat tetrahedra have no inside so every face is a candidate
+			if (signOrigin * signOpposite > 0.0f
+				&& fabs(signOpposite) > 1e-12f)
+			{
+				continue;
+			}
+
+			isOutside = true;
+
+			Simplex t{};
+			t.v[0] = s.v[f[0]];
+			t.v[1] = s.v[f[1]];
+			t.v[2] = s.v[f[2]];
+			t.count = 3;
+			SolveTriangle(t);
+
+			vec3 v(0.0f);
+			for (u32 i = 0; i < t.count; i++) v += t.v[i].w * t.bc[i];
+
+			f32 d2 = vlength2(v);
+			if (d2 < bestDist2)
+			{
+				bestDist2 = d2;
+				best = t;
+			}
+		}
+
+		if (!isOutside) return false;
+
+		s = best;
+		return true;
+	}
+
+	//
+	// EPA
+	//
+
+	bool FillTetrahedron(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		Simplex& s)
+	{
+		const vec3 axes[6] =
+		{
+			vec3(1.0f, 0.0f, 0.0f), vec3(-1.0f, 0.0f, 0.0f),
+			vec3(0.0f, 1.0f, 0.0f), vec3(0.0f, -1.0f, 0.0f),
+			vec3(0.0f, 0.0f, 1.0f), vec3(0.0f, 0.0f, -1.0f)
+		};
+
+		if (s.count == 1)
+		{
+			for (const auto& dir : axes)
+			{
+				SimplexVertex sv = SupportPoint(a, b, dir);
+				if (vlength2(sv.w - s.v[0].w) > 1e-10f)
+				{
+					s.v[s.count++] = sv;
+					break;
+				}
+			}
+		}
+
+		if (s.count == 2)
+		{
+			vec3 d = s.v[1].w - s.v[0].w;
+
+			//any axis that isn't parallel to the segment gives a perpendicular
+			vec3 axis = fabs(d.x) < fabs(d.y)
+				? (fabs(d.x) < fabs(d.z) ? axes[0] : axes[4])
+				: (fabs(d.y) < fabs(d.z) ? axes[2] : axes[4]);
+
+			vec3 p1 = vcross(d, axis);
+			vec3 p2 = vcross(d, p1);
+			const vec3 dirs[4] = { p1, vec3(0.0f) - p1, p2, vec3(0.0f) - p2 };
+
+			for (const auto& dir : dirs)
+			{
+				SimplexVertex sv = SupportPoint(a, b, dir);
+				if (vlength2(vcross(sv.w - s.v[0].w, d)) > 1e-10f * vlength2(d))
+				{
+					s.v[s.count++] = sv;
+					break;
+				}
+			}
+		}
+
+		if (s.count == 3)
+		{
+			vec3 n = vcross(s.v[1].w - s.v[0].w, s.v[2].w - s.v[0].w);
+			const vec3 dirs[2] = { n, vec3(0.0f) - n };
+
+			for (const auto& dir : dirs)
+			{
+				SimplexVertex sv = SupportPoint(a, b, dir);
+				if (fabs(vdot(n, sv.w - s.v[0].w)) > 1e-10f * vlength(n))
+				{
+					s.v[s.count++] = sv;
+					break;
+				}
+			}
+		}
+
+		return s.count == 4;
+	}
+
+	bool RunEPA(
+		const ConvexSupport& a,
+		const ConvexSupport& b,
+		Simplex& s,
+		ConvexResult& outResult)
+	{
+		array<SimplexVertex, EPA_MAX_VERTICES> verts{};
+		array<EpaFace, EPA_MAX_FACES> faces{};
+		array<EpaEdge, EPA_MAX_FACES * 3> edges{};
+
+		u32 vertCount = 4;
+		u32 faceCount{};
+
+		for (u32 i = 0; i < 4; i++) verts[i] = s.v[i];
+
+		auto _add_face = [&verts, &faces, &faceCount](u32 i0, u32 i1, u32 i2)
+			{
+				vec3 n = vcross(verts[i1].w - verts[i0].w, verts[i2].w - verts[i0].w);
+				f32 len = vlength(n);
+
+				//slivers have no reliable normal, leaving them out only makes the polytope coarser
+				if (len < 1e-12f
+					|| faceCount == EPA_MAX_FACES)
+				{
+					return;
+				}
+
+				EpaFace& f = faces[faceCount++];
+				f.i0 = i0;
+				f.i1 = i1;
+				f.i2 = i2;
+				f.normal = n * (1.0f / len);
+				f.dist = vdot(f.normal, verts[i0].w);
+			};
+
+		vec3 centroid = (verts[0].w + verts[1].w + verts[2].w + verts[3].w) * 0.25f;
+
+		const u32 tetra[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 1, 3, 2 }, { 2, 3, 0 } };
+		for (const auto& t : tetra)
+		{
+			vec3 n = vcross(verts[t[1]].w - verts[t[0]].w, verts[t[2]].w - verts[t[0]].w);
+
+			if (vdot(n, centroid - verts[t[0]].w) > 0.0f) _add_face(t[0], t[2], t[1]);
+			else _add_face(t[0], t[1], t[2]);
+		}
+
+		if (faceCount < 4) return false;
+
+		auto _find_closest = [&faces, &faceCount]()
+			{
+				u32 closest{};
+				for (u32 i = 1; i < faceCount; i++)
+				{
+					if (faces[i].dist < faces[closest].dist) closest = i;
+				}
+
+				return closest;
+			};
+
+		for (u32 iter = 0; iter < EPA_MAX_ITERATIONS; iter++)
+		{
+			u32 closest = _find_closest();
+
+			const EpaFace& c = faces[closest];
+			SimplexVertex sv = SupportPoint(a, b, c.normal);
+
+			//the polytope already touches the boundary along this face
+			if (vdot(sv.w, c.normal) - c.dist < EPA_TOLERANCE
+				|| vertCount == EPA_MAX_VERTICES)
+			{
+				break;
+			}
+
+			u32 newIndex = vertCount;
+			verts[vertCount++] = sv;
+
+			//remove every face the new point can see and keep their boundary
+			u32 edgeCount{};
+			u32 kept{};
+
+			for (u32 i = 0; i < faceCount; i++)
+			{
+				const EpaFace& f = faces[i];
+				if (vdot(f.normal, sv.w - verts[f.i0].w) <= 0.0f)
+				{
+					faces[kept++] = f;
+					continue;
+				}
+
+				const EpaEdge fe[3] = { { f.i0, f.i1 }, { f.i1, f.i2 }, { f.i2, f.i0 } };
+				for (const auto& e : fe)
+				{
+					bool isShared = false;
+					for (u32 k = 0; k < edgeCount; k++)
+					{
+						if (edges[k].from == e.to
+							&& edges[k].to == e.from)
+						{
+							edges[k] = edges[--edgeCount];
+							isShared = true;
+							break;
+						}
+					}
+
+					if (!isShared) edges[edgeCount++] = e;
+				}
+			}
+
+			faceCount = kept;
+			for (u32 k = 0; k < edgeCount; k++) _add_face(edges[k].from, edges[k].to, newIndex);
+
+			if (faceCount == 0) return false;
+		}
+
+		const EpaFace& c = faces[_find_closest()];
+
+		//barycentric weights of the origin projected onto the closest face
+		vec3 p = c.normal * c.dist;
+		vec3 v0 = verts[c.i1].w - verts[c.i0].w;
+		vec3 v1 = verts[c.i2].w - verts[c.i0].w;
+		vec3 v2 = p - verts[c.i0].w;
+
+		f32 d00 = vdot(v0, v0);
+		f32 d01 = vdot(v0, v1);
+		f32 d11 = vdot(v1, v1);
+		f32 d20 = vdot(v2, v0);
+		f32 d21 = vdot(v2, v1);
+		f32 denom = d00 * d11 - d01 * d01;
+
+		f32 bv = 0.0f;
+		f32 bw = 0.0f;
+		if (fabs(denom) > 1e-20f)
+		{
+			bv = (d11 * d20 - d01 * d21) / denom;
+			bw = (d00 * d21 - d01 * d20) / denom;
+		}
+		f32 bu = 1.0f - bv - bw;
+
+		outResult.normal = c.normal;
+		outResult.pointA = verts[c.i0].a * bu + verts[c.i1].a * bv + verts[c.i2].a * bw;
+		outResult.pointB = verts[c.i0].b * bu + verts[c.i1].b * bv + verts[c.i2].b * bw;
+		outResult.distance = c.dist > 0.0f ? -c.dist : 0.0f;
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,453 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <array>
+#include <utility>
+#include <type_traits>
+
+#include "physics/collision/kp_narrowphase.hpp"
+#include "physics/collision/kp_collider.hpp"
+#include "physics/collision/kp_collider_bsp.hpp"
+#include "physics/collision/kp_collider_aabb.hpp"
+#include "physics/collision/kp_collider_obb.hpp"
+#include "physics/collision/kp_collider_bcp.hpp"
+#include "physics/collision/kp_collider_kdop.hpp"
+#include "physics/collision/kp_collider_bch.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "physics/collision/kp_pair_table.hpp"
+#include "physics/collision/kp_overlap_kernels.hpp"
+#include "core/kp_job_system.hpp"
+
+using KalaPhysics::Core::JobSystem;
+
+using std::vector;
+using std::array;
+using std::swap;
+using std::index_sequence;
+using std::make_index_sequence;
+using std::is_same_v;
+
+namespace KalaPhysics::Physics::Collision
+{
+	constexpr u32 BUCKET_COUNT = COLLIDER_SHAPE_COUNT * COLLIDER_SHAPE_COUNT;
+
+	//Maps every shape tag to the class implementing it
+	template<ColliderShape S> struct ShapeClass;
+
+	template<> struct ShapeClass<ColliderShape::COLLIDER_BSP> { using Type = Collider_BSP; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_AABB> { using Type = Collider_AABB; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_OBB> { using Type = Collider_OBB; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_BCP> { using Type = Collider_BCP; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_KDOP_10_X> { using Type = Collider_KDOP; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_KDOP_10_Y> { using Type = Collider_KDOP; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_KDOP_10_Z> { using Type = Collider_KDOP; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_KDOP_18> { using Type = Collider_KDOP; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_KDOP_26> { using Type = Collider_KDOP; };
+	template<> struct ShapeClass<ColliderShape::COLLIDER_BCH> { using Type = Collider_BCH; };
+
+	//Analytic routines don't need the separating axis of the previous frame.
+	//Pairs are always ordered so the first shape has the lower ColliderShape value
+	template<typename A, typename B> constexpr bool usesCachedAxis = true;
+
+	template<> constexpr bool usesCachedAxis<Collider_BSP, Collider_BSP> = false;
+	template<> constexpr bool usesCachedAxis<Collider_BSP, Collider_AABB> = false;
+	template<> constexpr bool usesCachedAxis<Collider_AABB, Collider_AABB> = false;
+
+	//Sphere pairs are prefiltered in batches by the overlap kernels
+	template<typename A, typename B> constexpr bool usesSphereBatch = false;
+
+	template<> constexpr bool usesSphereBatch<Collider_BSP, Collider_BSP> = true;
+	template<> constexpr bool usesSphereBatch<Collider_BSP, Collider_AABB> = true;
+
+	struct BucketChunk
+	{
+		u32 bucket{};
+		u32 begin{};
+		u32 end{};
+	};
+
+	struct NarrowphaseChunkOutput
+	{
+		vector<ContactManifold> contacts{};
+
+		//separating axes of every GJK pair this chunk tested
+		vector<u64> axisKeys{};
+		vector<vec3> axes{};
+
+		//kernel scratch of the sphere buckets
+		PackedSpheres sphereBatch{};
+		PackedBounds boxBatch{};
+		vector<u32> batchHits{};
+	};
+
+	//merged contacts of the last update
+	static vector<ContactManifold> contacts{};
+	//one buffer set per chunk, kept alive across frames so their capacity is reused
+	static vector<NarrowphaseChunkOutput> chunkOutputs{};
+
+	//separating axes of the last update by pair key, read by every job
+	//and only rebuilt once all jobs are done
+	static vector<u64> axisKeys{};
+	static vector<vec3> axes{};
+	static PairTable axisTable{};
+
+	//pairs grouped by shape pair, the lower shape always comes first
+	static vector<ColliderPair> sortedPairs{};
+	static array<u32, BUCKET_COUNT + 1> bucketStart{};
+	//jobs of the last update, none of them crosses a bucket boundary
+	static vector<BucketChunk> chunks{};
+
+	const vector<ContactManifold>& Narrowphase::GetContacts() { return contacts; }
+
+	//
+	// PAIR ROUTINES
+	//
+
+	template<typename A, typename B>
+	bool Narrowphase::CollidePair(
+		const A& a,
+		const B& b,
+		vec3& inOutAxis,
+		ContactManifold& outManifold)
+	{
+		return CollideConvex(
+			a.GetSupport(),
+			b.GetSupport(),
+			inOutAxis,
+			outManifold);
+	}
+
+	template<>
+	bool Narrowphase::CollidePair(
+		const Collider_BSP& a,
+		const Collider_BSP& b,
+		vec3& inOutAxis,
+		ContactManifold& outManifold)
+	{
+		return CollideSpheres(
+			a.center,
+			a.radius,
+			b.center,
+			b.radius,
+			outManifold);
+	}
+
+	template<>
+	bool Narrowphase::CollidePair(
+		const Collider_BSP& a,
+		const Collider_AABB& b,
+		vec3& inOutAxis,
+		ContactManifold& outManifold)
+	{
+		return CollideSphereBox(
+			a.center,
+			a.radius,
+			b.minCorner,
+			b.maxCorner,
+			outManifold);
+	}
+
+	template<>
+	bool Narrowphase::CollidePair(
+		const Collider_AABB& a,
+		const Collider_AABB& b,
+		vec3& inOutAxis,
+		ContactManifold& outManifold)
+	{
+		return CollideBoxes(
+			a.minCorner,
+			a.maxCorner,
+			b.minCorner,
+			b.maxCorner,
+			outManifold);
+	}
+
+	//boxes resting on boxes need the clipped face manifold, a single GJK point lets them rock forever
+	template<>
+	bool Narrowphase::CollidePair(
+		const Collider_AABB& a,
+		const Collider_OBB& b,
+		vec3& inOutAxis,
+		ContactManifold& outManifold)
+	{
+		quat identity{};
+		identity.w = 1.0f;
+
+		return CollideOrientedBoxes(
+			(a.minCorner + a.maxCorner) * 0.5f,
+			identity,
+			(a.maxCorner - a.minCorner) * 0.5f,
+			b.pos,
+			b.rot,
+			b.halfExtents,
+			inOutAxis,
+			outManifold);
+	}
+
+	template<>
+	bool Narrowphase::CollidePair(
+		const Collider_OBB& a,
+		const Collider_OBB& b,
+		vec3& inOutAxis,
+		ContactManifold& outManifold)
+	{
+		return CollideOrientedBoxes(
+			a.pos,
+			a.rot,
+			a.halfExtents,
+			b.pos,
+			b.rot,
+			b.halfExtents,
+			inOutAxis,
+			outManifold);
+	}
+
+	//
+	// DISPATCH
+	//
+
+	template<ColliderShape SA, ColliderShape SB>
+	void Narrowphase::CollideBucket(
+		const ColliderPair* pairs,
+		u32 count,
+		NarrowphaseChunkOutput& out)
+	{
+		using A = typename ShapeClass<SA>::Type;
+		using B = typename ShapeClass<SB>::Type;
+
+		ContactManifold manifold{};
+
+		//broadphase pairs come in runs that share their first collider,
+		//each run is tested in one kernel batch and only the overlapping pairs reach the contact routine
+		if constexpr (usesSphereBatch<A, B>)
+		{
+			for (u32 runBegin = 0; runBegin < count;)
+			{
+				const Collider* first = pairs[runBegin].a;
+				const A& a = *scast<const A*>(first);
+
+				u32 runEnd = runBegin + 1;
+				while (runEnd < count && pairs[runEnd].a == first) runEnd++;
+
+				out.batchHits.clear();
+				if constexpr (is_same_v<B, Collider_BSP>)
+				{
+					out.sphereBatch.Clear();
+					for (u32 i = runBegin; i < runEnd; i++)
+					{
+						const B& b = *scast<const B*>(pairs[i].b);
+						out.sphereBatch.Push(b.center, b.radius);
+					}
+
+					OverlapKernels::OverlapSphere(
+						a.center,
+						a.radius,
+						out.sphereBatch,
+						0,
+						runEnd - runBegin,
+						out.batchHits);
+				}
+				else
+				{
+					out.boxBatch.Clear();
+					for (u32 i = runBegin; i < runEnd; i++)
+					{
+						const B& b = *scast<const B*>(pairs[i].b);
+						out.boxBatch.Push({ b.minCorner, b.maxCorner });
+					}
+
+					OverlapKernels::OverlapSphereAABB(
+						a.center,
+						a.radius,
+						out.boxBatch,
+						0,
+						runEnd - runBegin,
+						out.batchHits);
+				}
+
+				for (u32 hit : out.batchHits)
+				{
+					const ColliderPair& pair = pairs[runBegin + hit];
+
+					manifold.pointCount = 0;
+
+					vec3 axis{};
+					if (CollidePair(a, *scast<const B*>(pair.b), axis, manifold))
+					{
+						manifold.a = pair.a;
+						manifold.b = pair.b;
+						out.contacts.push_back(manifold);
+					}
+				}
+
+				runBegin = runEnd;
+			}
+
+			return;
+		}
+
+		for (u32 i = 0; i < count; i++)
+		{
+			const A& a = *scast<const A*>(pairs[i].a);
+			const B& b = *scast<const B*>(pairs[i].b);
+
+			manifold.pointCount = 0;
+
+			bool isTouching{};
+			if constexpr (usesCachedAxis<A, B>)
+			{
+				u64 key = MakePairKey(pairs[i].a->GetID(), pairs[i].b->GetID());
+
+				i32 cached = axisTable.Find(key);
+				vec3 axis = cached == -1 ? vec3(0.0f) : axes[cached];
+
+				isTouching = CollidePair(a, b, axis, manifold);
+
+				out.axisKeys.push_back(key);
+				out.axes.push_back(axis);
+			}
+			else
+			{
+				vec3 axis{};
+				isTouching = CollidePair(a, b, axis, manifold);
+			}
+
+			if (isTouching)
+			{
+				manifold.a = pairs[i].a;
+				manifold.b = pairs[i].b;
+				out.contacts.push_back(manifold);
+			}
+		}
+	}
+
+	template<size_t I>
+	constexpr Narrowphase::BucketFunc Narrowphase::MakeBucketEntry()
+	{
+		constexpr ColliderShape SA = scast<ColliderShape>(I / COLLIDER_SHAPE_COUNT);
+		constexpr ColliderShape SB = scast<ColliderShape>(I % COLLIDER_SHAPE_COUNT);
+
+		return &CollideBucket<SA, SB>;
+	}
+
+	void Narrowphase::Update(const vector<ColliderPair>& pairs)
+	{
+		static constexpr array<BucketFunc, BUCKET_COUNT> table =
+			[]<size_t... I>(index_sequence<I...>)
+			{
+				return array<BucketFunc, BUCKET_COUNT>{ MakeBucketEntry<I>()... };
+			}(make_index_sequence<BUCKET_COUNT>{});
+
+		contacts.clear();
+		chunks.clear();
+
+		//pairs that left the broadphase lose their cached axis
+		auto _clear_axes = []()
+			{
+				axisKeys.clear();
+				axes.clear();
+				axisTable.Clear();
+			};
+
+		if (pairs.empty())
+		{
+			_clear_axes();
+			return;
+		}
+
+		//
+		// GROUP PAIRS BY SHAPE PAIR
+		//
+
+		//counting sort, stable so every bucket keeps broadphase order
+		array<u32, BUCKET_COUNT> counts{};
+		for (const auto& p : pairs)
+		{
+			u32 sa = scast<u32>(p.a->shape);
+			u32 sb = scast<u32>(p.b->shape);
+			if (sa > sb) swap(sa, sb);
+
+			++counts[sa * COLLIDER_SHAPE_COUNT + sb];
+		}
+
+		u32 sum{};
+		for (u32 k = 0; k < BUCKET_COUNT; k++)
+		{
+			bucketStart[k] = sum;
+			sum += counts[k];
+		}
+		bucketStart[BUCKET_COUNT] = sum;
+
+		sortedPairs.resize(sum);
+
+		array<u32, BUCKET_COUNT> cursor{};
+		for (u32 k = 0; k < BUCKET_COUNT; k++) cursor[k] = bucketStart[k];
+
+		for (const auto& p : pairs)
+		{
+			ColliderPair ordered = p;
+			if (ordered.a->shape > ordered.b->shape) swap(ordered.a, ordered.b);
+
+			u32 k = scast<u32>(ordered.a->shape) * COLLIDER_SHAPE_COUNT + scast<u32>(ordered.b->shape);
+			sortedPairs[cursor[k]++] = ordered;
+		}
+
+		for (u32 k = 0; k < BUCKET_COUNT; k++)
+		{
+			for (u32 begin = bucketStart[k]; begin < bucketStart[k + 1]; begin += NARROWPHASE_CHUNK_SIZE)
+			{
+				u32 end = begin + NARROWPHASE_CHUNK_SIZE;
+				if (end > bucketStart[k + 1]) end = bucketStart[k + 1];
+
+				chunks.push_back({ k, begin, end });
+			}
+		}
+
+		//
+		// TEST EVERY GROUP
+		//
+
+		u32 chunkCount = scast<u32>(chunks.size());
+		if (chunkOutputs.size() < chunkCount) chunkOutputs.resize(chunkCount);
+
+		JobSystem::ParallelFor(
+			chunkCount,
+			1,
+			[](u32 begin, u32 end, u32)
+			{
+				for (u32 c = begin; c < end; c++)
+				{
+					const BucketChunk& chunk = chunks[c];
+
+					NarrowphaseChunkOutput& out = chunkOutputs[c];
+					out.contacts.clear();
+					out.axisKeys.clear();
+					out.axes.clear();
+
+					table[chunk.bucket](
+						sortedPairs.data() + chunk.begin,
+						chunk.end - chunk.begin,
+						out);
+				}
+			});
+
+		//chunk order is fixed by the grouping, so the merged result
+		//is identical no matter which thread ran which chunk
+		axisKeys.clear();
+		axes.clear();
+
+		for (u32 c = 0; c < chunkCount; c++)
+		{
+			const NarrowphaseChunkOutput& out = chunkOutputs[c];
+
+			contacts.insert(contacts.end(), out.contacts.begin(), out.contacts.end());
+			axisKeys.insert(axisKeys.end(), out.axisKeys.begin(), out.axisKeys.end());
+			axes.insert(axes.end(), out.axes.begin(), out.axes.end());
+		}
+
+		axisTable.Build(axisKeys);
+	}
+}
\ No newline at end of file
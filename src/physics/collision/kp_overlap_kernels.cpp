@@ -0,0 +1,696 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <algorithm>
+#include <bit>
+
+#include "physics/collision/kp_overlap_kernels.hpp"
+
+//every level has to round exactly like the scalar path,
+//a fused multiply-add would skip one rounding step and change results.
+//gcc ignores the standard pragma and contracts across statements by default
+#if defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+	#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+	#pragma fp_contract(off)
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define KP_SIMD_X86 1
+
+	#include <immintrin.h>
+
+	#ifdef _MSC_VER
+		#include <intrin.h>
+
+		#define KP_TARGET_SSE2
+		#define KP_TARGET_AVX2
+	#else
+		#define KP_TARGET_SSE2 __attribute__((target("sse2")))
+		#define KP_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+using std::min;
+using std::max;
+using std::countr_zero;
+
+namespace KalaPhysics::Physics::Collision
+{
+	static SimdLevel DetectLevel();
+
+	static SimdLevel supportedLevel = DetectLevel();
+	static SimdLevel activeLevel = supportedLevel;
+
+	//
+	// SCALAR
+	//
+
+	static void OverlapAABB_Scalar(
+		const ColliderBounds& q,
+		const PackedBounds& b,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		for (u32 i = begin; i < end; i++)
+		{
+			if (q.min.x <= b.maxX[i] && q.max.x >= b.minX[i]
+				&& q.min.y <= b.maxY[i] && q.max.y >= b.minY[i]
+				&& q.min.z <= b.maxZ[i] && q.max.z >= b.minZ[i])
+			{
+				out.push_back(i);
+			}
+		}
+	}
+
+	static void OverlapSphere_Scalar(
+		const vec3& c,
+		f32 r,
+		const PackedSpheres& s,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		for (u32 i = begin; i < end; i++)
+		{
+			f32 dx = s.x[i] - c.x;
+			f32 dy = s.y[i] - c.y;
+			f32 dz = s.z[i] - c.z;
+
+			f32 xx = dx * dx;
+			f32 yy = dy * dy;
+			f32 zz = dz * dz;
+			f32 d2 = xx + yy;
+			d2 = d2 + zz;
+
+			f32 rs = r + s.radius[i];
+			f32 rr = rs * rs;
+
+			if (d2 <= rr) out.push_back(i);
+		}
+	}
+
+	static void OverlapSphereAABB_Scalar(
+		const vec3& c,
+		f32 r,
+		const PackedBounds& b,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		f32 rr = r * r;
+
+		for (u32 i = begin; i < end; i++)
+		{
+			//closest point of the box to the sphere center
+			f32 px = max(b.minX[i], min(c.x, b.maxX[i]));
+			f32 py = max(b.minY[i], min(c.y, b.maxY[i]));
+			f32 pz = max(b.minZ[i], min(c.z, b.maxZ[i]));
+
+			f32 dx = c.x - px;
+			f32 dy = c.y - py;
+			f32 dz = c.z - pz;
+
+			f32 xx = dx * dx;
+			f32 yy = dy * dy;
+			f32 zz = dz * dz;
+			f32 d2 = xx + yy;
+			d2 = d2 + zz;
+
+			if (d2 <= rr) out.push_back(i);
+		}
+	}
+
+	static u32 OverlapAABBBlock_Scalar(
+		const ColliderBounds& q,
+		const PackedBounds& b,
+		u32 begin)
+	{
+		u32 mask = 0;
+
+		for (u32 i = 0; i < OVERLAP_BLOCK_SIZE; i++)
+		{
+			u32 j = begin + i;
+			if (q.min.x <= b.maxX[j] && q.max.x >= b.minX[j]
+				&& q.min.y <= b.maxY[j] && q.max.y >= b.minY[j]
+				&& q.min.z <= b.maxZ[j] && q.max.z >= b.minZ[j])
+			{
+				mask |= 1u << i;
+			}
+		}
+
+		return mask;
+	}
+
+	//vminf and vmaxf return the second operand if either one is NaN, like the sse instructions do,
+	//so a ray starting on a slab plane with a parallel direction gives the same lanes on every level
+	static u32 IntersectRayPacket_Scalar(
+		const ColliderBounds& b,
+		const RayPacket& p,
+		f32* outNear)
+	{
+		u32 mask = 0;
+
+		for (u32 i = 0; i < RAY_PACKET_SIZE; i++)
+		{
+			f32 tx1 = (b.min.x - p.originX[i]) * p.invDirectionX[i];
+			f32 tx2 = (b.max.x - p.originX[i]) * p.invDirectionX[i];
+			f32 ty1 = (b.min.y - p.originY[i]) * p.invDirectionY[i];
+			f32 ty2 = (b.max.y - p.originY[i]) * p.invDirectionY[i];
+			f32 tz1 = (b.min.z - p.originZ[i]) * p.invDirectionZ[i];
+			f32 tz2 = (b.max.z - p.originZ[i]) * p.invDirectionZ[i];
+
+			f32 tNear = vmaxf(vmaxf(vminf(tx1, tx2), vminf(ty1, ty2)), vmaxf(vminf(tz1, tz2), 0.0f));
+			f32 tFar = vminf(vminf(vmaxf(tx1, tx2), vmaxf(ty1, ty2)), vminf(vmaxf(tz1, tz2), p.maxDistance[i]));
+
+			outNear[i] = tNear;
+			if (tNear <= tFar) mask |= 1u << i;
+		}
+
+		return mask;
+	}
+
+#ifdef KP_SIMD_X86
+	static inline void EmitMask(
+		u32 mask,
+		u32 base,
+		vector<u32>& out)
+	{
+		while (mask != 0)
+		{
+			out.push_back(base + scast<u32>(countr_zero(mask)));
+			mask &= mask - 1;
+		}
+	}
+
+	//
+	// SSE2, 4 COLLIDERS PER STEP
+	//
+
+	KP_TARGET_SSE2 static void OverlapAABB_SSE2(
+		const ColliderBounds& q,
+		const PackedBounds& b,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		__m128 qMinX = _mm_set1_ps(q.min.x);
+		__m128 qMinY = _mm_set1_ps(q.min.y);
+		__m128 qMinZ = _mm_set1_ps(q.min.z);
+		__m128 qMaxX = _mm_set1_ps(q.max.x);
+		__m128 qMaxY = _mm_set1_ps(q.max.y);
+		__m128 qMaxZ = _mm_set1_ps(q.max.z);
+
+		u32 i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 x = _mm_and_ps(
+				_mm_cmple_ps(qMinX, _mm_loadu_ps(&b.maxX[i])),
+				_mm_cmpge_ps(qMaxX, _mm_loadu_ps(&b.minX[i])));
+			__m128 y = _mm_and_ps(
+				_mm_cmple_ps(qMinY, _mm_loadu_ps(&b.maxY[i])),
+				_mm_cmpge_ps(qMaxY, _mm_loadu_ps(&b.minY[i])));
+			__m128 z = _mm_and_ps(
+				_mm_cmple_ps(qMinZ, _mm_loadu_ps(&b.maxZ[i])),
+				_mm_cmpge_ps(qMaxZ, _mm_loadu_ps(&b.minZ[i])));
+
+			u32 mask = scast<u32>(_mm_movemask_ps(_mm_and_ps(_mm_and_ps(x, y), z)));
+			EmitMask(mask, i, out);
+		}
+
+		OverlapAABB_Scalar(q, b, i, end, out);
+	}
+
+	KP_TARGET_SSE2 static u32 OverlapAABBBlock_SSE2(
+		const ColliderBounds& q,
+		const PackedBounds& b,
+		u32 begin)
+	{
+		__m128 qMinX = _mm_set1_ps(q.min.x);
+		__m128 qMinY = _mm_set1_ps(q.min.y);
+		__m128 qMinZ = _mm_set1_ps(q.min.z);
+		__m128 qMaxX = _mm_set1_ps(q.max.x);
+		__m128 qMaxY = _mm_set1_ps(q.max.y);
+		__m128 qMaxZ = _mm_set1_ps(q.max.z);
+
+		u32 mask = 0;
+
+		for (u32 i = 0; i < OVERLAP_BLOCK_SIZE; i += 4)
+		{
+			u32 j = begin + i;
+
+			__m128 x = _mm_and_ps(
+				_mm_cmple_ps(qMinX, _mm_loadu_ps(&b.maxX[j])),
+				_mm_cmpge_ps(qMaxX, _mm_loadu_ps(&b.minX[j])));
+			__m128 y = _mm_and_ps(
+				_mm_cmple_ps(qMinY, _mm_loadu_ps(&b.maxY[j])),
+				_mm_cmpge_ps(qMaxY, _mm_loadu_ps(&b.minY[j])));
+			__m128 z = _mm_and_ps(
+				_mm_cmple_ps(qMinZ, _mm_loadu_ps(&b.maxZ[j])),
+				_mm_cmpge_ps(qMaxZ, _mm_loadu_ps(&b.minZ[j])));
+
+			mask |= scast<u32>(_mm_movemask_ps(_mm_and_ps(_mm_and_ps(x, y), z))) << i;
+		}
+
+		return mask;
+	}
+
+	KP_TARGET_SSE2 static void OverlapSphere_SSE2(
+		const vec3& c,
+		f32 r,
+		const PackedSpheres& s,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		__m128 cx = _mm_set1_ps(c.x);
+		__m128 cy = _mm_set1_ps(c.y);
+		__m128 cz = _mm_set1_ps(c.z);
+		__m128 cr = _mm_set1_ps(r);
+
+		u32 i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(&s.x[i]), cx);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(&s.y[i]), cy);
+			__m128 dz = _mm_sub_ps(_mm_loadu_ps(&s.z[i]), cz);
+
+			__m128 d2 = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+				_mm_mul_ps(dz, dz));
+
+			__m128 rs = _mm_add_ps(cr, _mm_loadu_ps(&s.radius[i]));
+
+			u32 mask = scast<u32>(_mm_movemask_ps(_mm_cmple_ps(d2, _mm_mul_ps(rs, rs))));
+			EmitMask(mask, i, out);
+		}
+
+		OverlapSphere_Scalar(c, r, s, i, end, out);
+	}
+
+	KP_TARGET_SSE2 static void OverlapSphereAABB_SSE2(
+		const vec3& c,
+		f32 r,
+		const PackedBounds& b,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		__m128 cx = _mm_set1_ps(c.x);
+		__m128 cy = _mm_set1_ps(c.y);
+		__m128 cz = _mm_set1_ps(c.z);
+		__m128 rr = _mm_set1_ps(r * r);
+
+		u32 i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 px = _mm_max_ps(_mm_loadu_ps(&b.minX[i]), _mm_min_ps(cx, _mm_loadu_ps(&b.maxX[i])));
+			__m128 py = _mm_max_ps(_mm_loadu_ps(&b.minY[i]), _mm_min_ps(cy, _mm_loadu_ps(&b.maxY[i])));
+			__m128 pz = _mm_max_ps(_mm_loadu_ps(&b.minZ[i]), _mm_min_ps(cz, _mm_loadu_ps(&b.maxZ[i])));
+
+			__m128 dx = _mm_sub_ps(cx, px);
+			__m128 dy = _mm_sub_ps(cy, py);
+			__m128 dz = _mm_sub_ps(cz, pz);
+
+			__m128 d2 = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+				_mm_mul_ps(dz, dz));
+
+			u32 mask = scast<u32>(_mm_movemask_ps(_mm_cmple_ps(d2, rr)));
+			EmitMask(mask, i, out);
+		}
+
+		OverlapSphereAABB_Scalar(c, r, b, i, end, out);
+	}
+
+	KP_TARGET_SSE2 static u32 IntersectRayPacket_SSE2(
+		const ColliderBounds& b,
+		const RayPacket& p,
+		f32* outNear)
+	{
+		__m128 minX = _mm_set1_ps(b.min.x);
+		__m128 minY = _mm_set1_ps(b.min.y);
+		__m128 minZ = _mm_set1_ps(b.min.z);
+		__m128 maxX = _mm_set1_ps(b.max.x);
+		__m128 maxY = _mm_set1_ps(b.max.y);
+		__m128 maxZ = _mm_set1_ps(b.max.z);
+		__m128 zero = _mm_setzero_ps();
+
+		u32 mask = 0;
+
+		for (u32 i = 0; i < RAY_PACKET_SIZE; i += 4)
+		{
+			__m128 ox = _mm_load_ps(&p.originX[i]);
+			__m128 oy = _mm_load_ps(&p.originY[i]);
+			__m128 oz = _mm_load_ps(&p.originZ[i]);
+			__m128 ix = _mm_load_ps(&p.invDirectionX[i]);
+			__m128 iy = _mm_load_ps(&p.invDirectionY[i]);
+			__m128 iz = _mm_load_ps(&p.invDirectionZ[i]);
+
+			__m128 tx1 = _mm_mul_ps(_mm_sub_ps(minX, ox), ix);
+			__m128 tx2 = _mm_mul_ps(_mm_sub_ps(maxX, ox), ix);
+			__m128 ty1 = _mm_mul_ps(_mm_sub_ps(minY, oy), iy);
+			__m128 ty2 = _mm_mul_ps(_mm_sub_ps(maxY, oy), iy);
+			__m128 tz1 = _mm_mul_ps(_mm_sub_ps(minZ, oz), iz);
+			__m128 tz2 = _mm_mul_ps(_mm_sub_ps(maxZ, oz), iz);
+
+			__m128 tNear = _mm_max_ps(
+				_mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)),
+				_mm_max_ps(_mm_min_ps(tz1, tz2), zero));
+			__m128 tFar = _mm_min_ps(
+				_mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)),
+				_mm_min_ps(_mm_max_ps(tz1, tz2), _mm_load_ps(&p.maxDistance[i])));
+
+			_mm_storeu_ps(&outNear[i], tNear);
+			mask |= scast<u32>(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar))) << i;
+		}
+
+		return mask;
+	}
+
+	//
+	// AVX2, 8 COLLIDERS PER STEP
+	//
+
+	KP_TARGET_AVX2 static void OverlapAABB_AVX2(
+		const ColliderBounds& q,
+		const PackedBounds& b,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		__m256 qMinX = _mm256_set1_ps(q.min.x);
+		__m256 qMinY = _mm256_set1_ps(q.min.y);
+		__m256 qMinZ = _mm256_set1_ps(q.min.z);
+		__m256 qMaxX = _mm256_set1_ps(q.max.x);
+		__m256 qMaxY = _mm256_set1_ps(q.max.y);
+		__m256 qMaxZ = _mm256_set1_ps(q.max.z);
+
+		u32 i = begin;
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 x = _mm256_and_ps(
+				_mm256_cmp_ps(qMinX, _mm256_loadu_ps(&b.maxX[i]), _CMP_LE_OQ),
+				_mm256_cmp_ps(qMaxX, _mm256_loadu_ps(&b.minX[i]), _CMP_GE_OQ));
+			__m256 y = _mm256_and_ps(
+				_mm256_cmp_ps(qMinY, _mm256_loadu_ps(&b.maxY[i]), _CMP_LE_OQ),
+				_mm256_cmp_ps(qMaxY, _mm256_loadu_ps(&b.minY[i]), _CMP_GE_OQ));
+			__m256 z = _mm256_and_ps(
+				_mm256_cmp_ps(qMinZ, _mm256_loadu_ps(&b.maxZ[i]), _CMP_LE_OQ),
+				_mm256_cmp_ps(qMaxZ, _mm256_loadu_ps(&b.minZ[i]), _CMP_GE_OQ));
+
+			u32 mask = scast<u32>(_mm256_movemask_ps(_mm256_and_ps(_mm256_and_ps(x, y), z)));
+			EmitMask(mask, i, out);
+		}
+
+		OverlapAABB_Scalar(q, b, i, end, out);
+	}
+
+	KP_TARGET_AVX2 static void OverlapSphere_AVX2(
+		const vec3& c,
+		f32 r,
+		const PackedSpheres& s,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		__m256 cx = _mm256_set1_ps(c.x);
+		__m256 cy = _mm256_set1_ps(c.y);
+		__m256 cz = _mm256_set1_ps(c.z);
+		__m256 cr = _mm256_set1_ps(r);
+
+		u32 i = begin;
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&s.x[i]), cx);
+			__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&s.y[i]), cy);
+			__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&s.z[i]), cz);
+
+			__m256 d2 = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+				_mm256_mul_ps(dz, dz));
+
+			__m256 rs = _mm256_add_ps(cr, _mm256_loadu_ps(&s.radius[i]));
+
+			u32 mask = scast<u32>(_mm256_movemask_ps(_mm256_cmp_ps(d2, _mm256_mul_ps(rs, rs), _CMP_LE_OQ)));
+			EmitMask(mask, i, out);
+		}
+
+		OverlapSphere_Scalar(c, r, s, i, end, out);
+	}
+
+	KP_TARGET_AVX2 static void OverlapSphereAABB_AVX2(
+		const vec3& c,
+		f32 r,
+		const PackedBounds& b,
+		u32 begin,
+		u32 end,
+		vector<u32>& out)
+	{
+		__m256 cx = _mm256_set1_ps(c.x);
+		__m256 cy = _mm256_set1_ps(c.y);
+		__m256 cz = _mm256_set1_ps(c.z);
+		__m256 rr = _mm256_set1_ps(r * r);
+
+		u32 i = begin;
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 px = _mm256_max_ps(_mm256_loadu_ps(&b.minX[i]), _mm256_min_ps(cx, _mm256_loadu_ps(&b.maxX[i])));
+			__m256 py = _mm256_max_ps(_mm256_loadu_ps(&b.minY[i]), _mm256_min_ps(cy, _mm256_loadu_ps(&b.maxY[i])));
+			__m256 pz = _mm256_max_ps(_mm256_loadu_ps(&b.minZ[i]), _mm256_min_ps(cz, _mm256_loadu_ps(&b.maxZ[i])));
+
+			__m256 dx = _mm256_sub_ps(cx, px);
+			__m256 dy = _mm256_sub_ps(cy, py);
+			__m256 dz = _mm256_sub_ps(cz, pz);
+
+			__m256 d2 = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+				_mm256_mul_ps(dz, dz));
+
+			u32 mask = scast<u32>(_mm256_movemask_ps(_mm256_cmp_ps(d2, rr, _CMP_LE_OQ)));
+			EmitMask(mask, i, out);
+		}
+
+		OverlapSphereAABB_Scalar(c, r, b, i, end, out);
+	}
+
+	KP_TARGET_AVX2 static u32 OverlapAABBBlock_AVX2(
+		const ColliderBounds& q,
+		const PackedBounds& b,
+		u32 begin)
+	{
+		__m256 x = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_set1_ps(q.min.x), _mm256_loadu_ps(&b.maxX[begin]), _CMP_LE_OQ),
+			_mm256_cmp_ps(_mm256_set1_ps(q.max.x), _mm256_loadu_ps(&b.minX[begin]), _CMP_GE_OQ));
+		__m256 y = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_set1_ps(q.min.y), _mm256_loadu_ps(&b.maxY[begin]), _CMP_LE_OQ),
+			_mm256_cmp_ps(_mm256_set1_ps(q.max.y), _mm256_loadu_ps(&b.minY[begin]), _CMP_GE_OQ));
+		__m256 z = _mm256_and_ps(
+			_mm256_cmp_ps(_mm256_set1_ps(q.min.z), _mm256_loadu_ps(&b.maxZ[begin]), _CMP_LE_OQ),
+			_mm256_cmp_ps(_mm256_set1_ps(q.max.z), _mm256_loadu_ps(&b.minZ[begin]), _CMP_GE_OQ));
+
+		return scast<u32>(_mm256_movemask_ps(_mm256_and_ps(_mm256_and_ps(x, y), z)));
+	}
+
+	KP_TARGET_AVX2 static u32 IntersectRayPacket_AVX2(
+		const ColliderBounds& b,
+		const RayPacket& p,
+		f32* outNear)
+	{
+		__m256 ox = _mm256_load_ps(p.originX);
+		__m256 oy = _mm256_load_ps(p.originY);
+		__m256 oz = _mm256_load_ps(p.originZ);
+		__m256 ix = _mm256_load_ps(p.invDirectionX);
+		__m256 iy = _mm256_load_ps(p.invDirectionY);
+		__m256 iz = _mm256_load_ps(p.invDirectionZ);
+
+		__m256 tx1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(b.min.x), ox), ix);
+		__m256 tx2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(b.max.x), ox), ix);
+		__m256 ty1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(b.min.y), oy), iy);
+		__m256 ty2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(b.max.y), oy), iy);
+		__m256 tz1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(b.min.z), oz), iz);
+		__m256 tz2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(b.max.z), oz), iz);
+
+		__m256 tNear = _mm256_max_ps(
+			_mm256_max_ps(_mm256_min_ps(tx1, tx2), _mm256_min_ps(ty1, ty2)),
+			_mm256_max_ps(_mm256_min_ps(tz1, tz2), _mm256_setzero_ps()));
+		__m256 tFar = _mm256_min_ps(
+			_mm256_min_ps(_mm256_max_ps(tx1, tx2), _mm256_max_ps(ty1, ty2)),
+			_mm256_min_ps(_mm256_max_ps(tz1, tz2), _mm256_load_ps(p.maxDistance)));
+
+		_mm256_storeu_ps(outNear, tNear);
+		return scast<u32>(_mm256_movemask_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ)));
+	}
+#endif
+
+	SimdLevel DetectLevel()
+	{
+#ifdef KP_SIMD_X86
+		bool hasSSE2{};
+		bool hasAVX2{};
+
+	#ifdef _MSC_VER
+		int info[4]{};
+
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		hasSSE2 = (info[3] & (1 << 26)) != 0;
+
+		//avx registers are only usable if the os saves them on context switches
+		bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+		bool hasAVX = (info[2] & (1 << 28)) != 0;
+
+		if (maxLeaf >= 7
+			&& hasOSXSave
+			&& hasAVX
+			&& (_xgetbv(0) & 0x6) == 0x6)
+		{
+			__cpuidex(info, 7, 0);
+			hasAVX2 = (info[1] & (1 << 5)) != 0;
+		}
+	#else
+		__builtin_cpu_init();
+
+		hasSSE2 = __builtin_cpu_supports("sse2");
+		hasAVX2 = __builtin_cpu_supports("avx2");
+	#endif
+
+		if (hasAVX2) return SimdLevel::SIMD_AVX2;
+		if (hasSSE2) return SimdLevel::SIMD_SSE2;
+#endif
+		return SimdLevel::SIMD_SCALAR;
+	}
+
+	SimdLevel OverlapKernels::GetSupportedLevel() { return supportedLevel; }
+
+	SimdLevel OverlapKernels::GetLevel() { return activeLevel; }
+	void OverlapKernels::SetLevel(SimdLevel newValue)
+	{
+		activeLevel = scast<u8>(newValue) > scast<u8>(supportedLevel)
+			? supportedLevel
+			: newValue;
+	}
+
+	void OverlapKernels::OverlapAABB(
+		const ColliderBounds& query,
+		const PackedBounds& batch,
+		u32 begin,
+		u32 end,
+		vector<u32>& outIndices)
+	{
+		end = min(end, batch.GetCount());
+		if (begin >= end) return;
+
+		switch (activeLevel)
+		{
+#ifdef KP_SIMD_X86
+		case SimdLevel::SIMD_AVX2:
+			OverlapAABB_AVX2(query, batch, begin, end, outIndices);
+			break;
+		case SimdLevel::SIMD_SSE2:
+			OverlapAABB_SSE2(query, batch, begin, end, outIndices);
+			break;
+#endif
+		default:
+			OverlapAABB_Scalar(query, batch, begin, end, outIndices);
+			break;
+		}
+	}
+
+	void OverlapKernels::OverlapSphere(
+		const vec3& center,
+		f32 radius,
+		const PackedSpheres& batch,
+		u32 begin,
+		u32 end,
+		vector<u32>& outIndices)
+	{
+		end = min(end, batch.GetCount());
+		if (begin >= end) return;
+
+		switch (activeLevel)
+		{
+#ifdef KP_SIMD_X86
+		case SimdLevel::SIMD_AVX2:
+			OverlapSphere_AVX2(center, radius, batch, begin, end, outIndices);
+			break;
+		case SimdLevel::SIMD_SSE2:
+			OverlapSphere_SSE2(center, radius, batch, begin, end, outIndices);
+			break;
+#endif
+		default:
+			OverlapSphere_Scalar(center, radius, batch, begin, end, outIndices);
+			break;
+		}
+	}
+
+	void OverlapKernels::OverlapSphereAABB(
+		const vec3& center,
+		f32 radius,
+		const PackedBounds& batch,
+		u32 begin,
+		u32 end,
+		vector<u32>& outIndices)
+	{
+		end = min(end, batch.GetCount());
+		if (begin >= end) return;
+
+		switch (activeLevel)
+		{
+#ifdef KP_SIMD_X86
+		case SimdLevel::SIMD_AVX2:
+			OverlapSphereAABB_AVX2(center, radius, batch, begin, end, outIndices);
+			break;
+		case SimdLevel::SIMD_SSE2:
+			OverlapSphereAABB_SSE2(center, radius, batch, begin, end, outIndices);
+			break;
+#endif
+		default:
+			OverlapSphereAABB_Scalar(center, radius, batch, begin, end, outIndices);
+			break;
+		}
+	}
+
+	u32 OverlapKernels::OverlapAABBBlock(
+		const ColliderBounds& query,
+		const PackedBounds& batch,
+		u32 begin)
+	{
+		switch (activeLevel)
+		{
+#ifdef KP_SIMD_X86
+		case SimdLevel::SIMD_AVX2:
+			return OverlapAABBBlock_AVX2(query, batch, begin);
+		case SimdLevel::SIMD_SSE2:
+			return OverlapAABBBlock_SSE2(query, batch, begin);
+#endif
+		default:
+			return OverlapAABBBlock_Scalar(query, batch, begin);
+		}
+	}
+
+	u32 OverlapKernels::IntersectRayPacket(
+		const ColliderBounds& box,
+		const RayPacket& packet,
+		f32* outNear)
+	{
+		switch (activeLevel)
+		{
+#ifdef KP_SIMD_X86
+		case SimdLevel::SIMD_AVX2:
+			return IntersectRayPacket_AVX2(box, packet, outNear);
+		case SimdLevel::SIMD_SSE2:
+			return IntersectRayPacket_SSE2(box, packet, outNear);
+#endif
+		default:
+			return IntersectRayPacket_Scalar(box, packet, outNear);
+		}
+	}
+}
\ No newline at end of file
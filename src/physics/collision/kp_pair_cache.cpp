@@ -0,0 +1,136 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <utility>
+
+#include "physics/collision/kp_pair_cache.hpp"
+#include "physics/collision/kp_pair_table.hpp"
+#include "physics/collision/kp_collider.hpp"
+#include "physics/collision/kp_collision_math.hpp"
+
+using std::vector;
+using std::swap;
+
+namespace KalaPhysics::Physics::Collision
+{
+	//manifolds and keys of the current and previous update, swapped every update
+	static vector<ContactManifold> manifolds{};
+	static vector<u64> keys{};
+	static vector<ContactManifold> previousManifolds{};
+	static vector<u64> previousKeys{};
+
+	//index of every key in the current manifolds, rebuilt every update
+	static PairTable table{};
+
+	static u32 persistentCount{};
+
+	//Copies the impulses of the closest old point onto every new point,
+	//points without an old point in range start from zero
+	static void MatchPoints(
+		const ContactManifold& previous,
+		ContactManifold& current)
+	{
+		//the pair came back in the other order, the normal impulse is symmetric
+		//but the tangent basis is derived from the flipped normal so it can't be reused
+		bool flipped = previous.a != current.a;
+
+		bool used[MAX_CONTACT_POINTS]{};
+		constexpr f32 maxDist2 = PAIR_CACHE_MATCH_DISTANCE * PAIR_CACHE_MATCH_DISTANCE;
+
+		for (u8 i = 0; i < current.pointCount; i++)
+		{
+			ContactPoint& p = current.points[i];
+
+			i32 best = -1;
+			f32 bestDist2 = maxDist2;
+
+			for (u8 j = 0; j < previous.pointCount; j++)
+			{
+				if (used[j]) continue;
+
+				f32 d2 = vlength2(previous.points[j].position - p.position);
+				if (d2 <= bestDist2)
+				{
+					best = j;
+					bestDist2 = d2;
+				}
+			}
+
+			p.normalImpulse = 0.0f;
+			p.tangentImpulse = {};
+
+			if (best == -1) continue;
+
+			used[best] = true;
+
+			const ContactPoint& old = previous.points[best];
+			p.normalImpulse = old.normalImpulse;
+			if (!flipped) p.tangentImpulse = old.tangentImpulse;
+		}
+	}
+
+	const vector<ContactManifold>& PairCache::GetManifolds() { return manifolds; }
+	vector<ContactManifold>& PairCache::GetMutableManifolds() { return manifolds; }
+
+	const ContactManifold* PairCache::Find(
+		u32 colliderA,
+		u32 colliderB)
+	{
+		i32 index = table.Find(MakePairKey(colliderA, colliderB));
+
+		return index == -1 ? nullptr : &manifolds[index];
+	}
+
+	u32 PairCache::GetPairCount() { return scast<u32>(manifolds.size()); }
+	u32 PairCache::GetPersistentCount() { return persistentCount; }
+
+	void PairCache::Clear()
+	{
+		manifolds.clear();
+		keys.clear();
+		previousManifolds.clear();
+		previousKeys.clear();
+		table.Clear();
+
+		persistentCount = 0;
+	}
+
+	void PairCache::Update(const vector<ContactManifold>& contacts)
+	{
+		//the table still points into the current manifolds,
+		//which become the previous frame after this swap
+		swap(manifolds, previousManifolds);
+		swap(keys, previousKeys);
+
+		manifolds.assign(contacts.begin(), contacts.end());
+		keys.resize(manifolds.size());
+
+		persistentCount = 0;
+
+		for (u32 i = 0; i < manifolds.size(); i++)
+		{
+			ContactManifold& m = manifolds[i];
+			keys[i] = MakePairKey(m.a->GetID(), m.b->GetID());
+
+			i32 previous = table.Find(keys[i]);
+			if (previous == -1)
+			{
+				for (u8 p = 0; p < m.pointCount; p++)
+				{
+					m.points[p].normalImpulse = 0.0f;
+					m.points[p].tangentImpulse = {};
+				}
+
+				continue;
+			}
+
+			MatchPoints(previousManifolds[previous], m);
+			++persistentCount;
+		}
+
+		table.Build(keys);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+
+#include "physics/collision/kp_pair_table.hpp"
+
+namespace KalaPhysics::Physics::Collision
+{
+	constexpr u64 EMPTY_KEY = 0;
+
+	static u32 HashKey(u64 key)
+	{
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdull;
+		key ^= key >> 33;
+
+		return scast<u32>(key);
+	}
+
+	void PairTable::Build(span<const u64> keys)
+	{
+		//at most half full so probe chains stay short
+		size_t capacity = 16;
+		while (capacity < keys.size() * 2) capacity <<= 1;
+
+		slotKeys.assign(capacity, EMPTY_KEY);
+		slotIndices.resize(capacity);
+
+		u32 mask = scast<u32>(capacity - 1);
+
+		for (u32 i = 0; i < keys.size(); i++)
+		{
+			u32 slot = HashKey(keys[i]) & mask;
+			while (slotKeys[slot] != EMPTY_KEY) slot = (slot + 1) & mask;
+
+			slotKeys[slot] = keys[i];
+			slotIndices[slot] = i;
+		}
+	}
+
+	i32 PairTable::Find(u64 key) const
+	{
+		if (slotKeys.empty()) return -1;
+
+		u32 mask = scast<u32>(slotKeys.size() - 1);
+		u32 slot = HashKey(key) & mask;
+
+		while (slotKeys[slot] != EMPTY_KEY)
+		{
+			if (slotKeys[slot] == key) return scast<i32>(slotIndices[slot]);
+			slot = (slot + 1) & mask;
+		}
+
+		return -1;
+	}
+
+	void PairTable::Clear()
+	{
+		slotKeys.clear();
+		slotIndices.clear();
+	}
+}
\ No newline at end of file
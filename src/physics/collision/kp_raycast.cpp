@@ -0,0 +1,364 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <cmath>
+#include <cfloat>
+
+#include "physics/collision/kp_raycast.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "physics/collision/kp_collider_bsp.hpp"
+#include "physics/collision/kp_collider_aabb.hpp"
+#include "physics/collision/kp_collider_obb.hpp"
+#include "physics/collision/kp_collider_bcp.hpp"
+
+using std::sqrt;
+using std::fabs;
+using std::fmin;
+using std::fmax;
+
+namespace KalaPhysics::Physics::Collision
+{
+	bool RaycastSphere(
+		const vec3& center,
+		f32 radius,
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal)
+	{
+		vec3 m = origin - center;
+		f32 b = vdot(m, direction);
+		f32 c = vdot(m, m) - radius * radius;
+
+		if (c <= 0.0f)
+		{
+			outDistance = 0.0f;
+			outNormal = vec3(0.0f) - direction;
+			return true;
+		}
+
+		//outside and pointing away
+		if (b > 0.0f) return false;
+
+		f32 disc = b * b - c;
+		if (disc < 0.0f) return false;
+
+		f32 t = -b - sqrt(disc);
+		if (t > maxDistance) return false;
+
+		outDistance = t;
+		outNormal = (m + direction * t) * (1.0f / radius);
+		return true;
+	}
+
+	bool RaycastBox(
+		const vec3& boxMin,
+		const vec3& boxMax,
+		const vec3& origin,
+		const vec3& invDirection,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal)
+	{
+		f32 tNear = -FLT_MAX;
+		f32 tFar = FLT_MAX;
+		u32 axis{};
+		f32 side{};
+
+		for (u32 i = 0; i < 3; i++)
+		{
+			f32 o = i == 0 ? origin.x : (i == 1 ? origin.y : origin.z);
+			f32 inv = i == 0 ? invDirection.x : (i == 1 ? invDirection.y : invDirection.z);
+			f32 lo = i == 0 ? boxMin.x : (i == 1 ? boxMin.y : boxMin.z);
+			f32 hi = i == 0 ? boxMax.x : (i == 1 ? boxMax.y : boxMax.z);
+
+			f32 t1 = (lo - o) * inv;
+			f32 t2 = (hi - o) * inv;
+
+			//parallel to this slab, either always inside it or never
+			if (std::isnan(t1)
+				|| std::isnan(t2))
+			{
+				if (o < lo || o > hi) return false;
+				continue;
+			}
+
+			//entering through the min face means the surface faces down the axis
+			f32 entrySide = -1.0f;
+			if (t1 > t2)
+			{
+				f32 t = t1;
+				t1 = t2;
+				t2 = t;
+				entrySide = 1.0f;
+			}
+
+			if (t1 > tNear)
+			{
+				tNear = t1;
+				axis = i;
+				side = entrySide;
+			}
+			if (t2 < tFar) tFar = t2;
+
+			if (tNear > tFar
+				|| tFar < 0.0f)
+			{
+				return false;
+			}
+		}
+
+		if (tNear > maxDistance) return false;
+
+		if (tNear <= 0.0f)
+		{
+			//the inverse direction is never 0, its reciprocal is the direction again
+			outDistance = 0.0f;
+			outNormal = vec3(-1.0f / invDirection.x, -1.0f / invDirection.y, -1.0f / invDirection.z);
+			return true;
+		}
+
+		outDistance = tNear;
+		outNormal = vec3(
+			axis == 0 ? side : 0.0f,
+			axis == 1 ? side : 0.0f,
+			axis == 2 ? side : 0.0f);
+		return true;
+	}
+
+	bool RaycastOrientedBox(
+		const vec3& center,
+		const quat& rot,
+		const vec3& halfExtents,
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal)
+	{
+		vec3 localOrigin = vrotate_inv(rot, origin - center);
+		vec3 localDirection = vrotate_inv(rot, direction);
+		vec3 invDirection(
+			1.0f / localDirection.x,
+			1.0f / localDirection.y,
+			1.0f / localDirection.z);
+
+		vec3 normal{};
+		if (!RaycastBox(
+			vec3(0.0f) - halfExtents,
+			halfExtents,
+			localOrigin,
+			invDirection,
+			maxDistance,
+			outDistance,
+			normal))
+		{
+			return false;
+		}
+
+		outNormal = vrotate(rot, normal);
+		return true;
+	}
+
+	bool RaycastCapsule(
+		const vec3& center,
+		f32 halfHeight,
+		f32 radius,
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal)
+	{
+		vec3 m = origin - center;
+
+		//the capsule is the union of its cylinder and both cap spheres,
+		//the first entry of a union of convex shapes is the nearest entry of any of them
+		bool hasHit = false;
+		f32 best = maxDistance;
+		vec3 bestNormal{};
+
+		f32 a = direction.x * direction.x + direction.z * direction.z;
+		if (a > 1e-12f)
+		{
+			f32 b = m.x * direction.x + m.z * direction.z;
+			f32 c = m.x * m.x + m.z * m.z - radius * radius;
+			f32 disc = b * b - a * c;
+
+			if (disc >= 0.0f)
+			{
+				f32 t = (-b - sqrt(disc)) / a;
+				f32 y = m.y + direction.y * t;
+
+				//only the finite side wall, the caps are covered by the spheres
+				if (t >= 0.0f
+					&& t <= best
+					&& fabs(y) <= halfHeight)
+				{
+					hasHit = true;
+					best = t;
+					bestNormal = vec3(m.x + direction.x * t, 0.0f, m.z + direction.z * t) * (1.0f / radius);
+				}
+			}
+		}
+
+		for (f32 cap : { halfHeight, -halfHeight })
+		{
+			f32 t{};
+			vec3 n{};
+			if (RaycastSphere(
+				center + vec3(0.0f, cap, 0.0f),
+				radius,
+				origin,
+				direction,
+				best,
+				t,
+				n)
+				&& (!hasHit || t < best))
+			{
+				hasHit = true;
+				best = t;
+				bestNormal = n;
+			}
+		}
+
+		//a cap sphere already reports origins inside it, the rest of the inside is the cylinder
+		if (fabs(m.y) <= halfHeight
+			&& m.x * m.x + m.z * m.z <= radius * radius)
+		{
+			outDistance = 0.0f;
+			outNormal = vec3(0.0f) - direction;
+			return true;
+		}
+
+		if (!hasHit) return false;
+
+		outDistance = best;
+		outNormal = bestNormal;
+		return true;
+	}
+
+	bool RaycastConvex(
+		const ConvexSupport& shape,
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal)
+	{
+		ConvexSupport point{};
+		point.kind = SupportKind::SUPPORT_POINT;
+		point.pos = origin;
+
+		f32 time{};
+		vec3 normal{};
+		ConvexCastResult result = ConvexCast(
+			point,
+			shape,
+			direction * maxDistance,
+			RAYCAST_TOLERANCE,
+			RAYCAST_TOLERANCE,
+			time,
+			normal);
+
+		if (result == ConvexCastResult::CAST_MISS) return false;
+
+		if (result == ConvexCastResult::CAST_OVERLAPPING)
+		{
+			outDistance = 0.0f;
+			outNormal = vec3(0.0f) - direction;
+			return true;
+		}
+
+		outDistance = time * maxDistance;
+
+		//the advancement runs with the rest of the ray as radius, which lets GJK stop on a coarse
+		//closest feature. It stops just outside the shape so a second query at the stop point
+		//sees separated cores and returns the exact face, stepping over the leftover gap
+		//along that face then removes the grazing angle error of the tolerance
+		point.pos = origin + direction * outDistance;
+		point.radius = RAYCAST_TOLERANCE * 4.0f;
+
+		vec3 axis = normal;
+		ConvexResult refined{};
+		if (ConvexQuery(point, shape, axis, refined))
+		{
+			normal = refined.normal;
+
+			f32 gap = refined.distance + point.radius;
+			f32 approach = vdot(direction, normal);
+			if (gap > 0.0f
+				&& approach > RAYCAST_MIN_APPROACH)
+			{
+				outDistance = fmin(outDistance + gap / approach, maxDistance);
+			}
+		}
+
+		//the cast normal points from the ray towards the shape
+		outNormal = vec3(0.0f) - normal;
+		return true;
+	}
+
+	bool RaycastCollider(
+		const Collider* c,
+		const vec3& origin,
+		const vec3& direction,
+		const vec3& invDirection,
+		f32 maxDistance,
+		f32& outDistance,
+		vec3& outNormal)
+	{
+		switch (c->GetColliderShape())
+		{
+		case ColliderShape::COLLIDER_BSP:
+		{
+			const Collider_BSP* s = scast<const Collider_BSP*>(c);
+			return RaycastSphere(s->GetCenter(), s->GetRadius(), origin, direction, maxDistance, outDistance, outNormal);
+		}
+		case ColliderShape::COLLIDER_AABB:
+		{
+			const Collider_AABB* s = scast<const Collider_AABB*>(c);
+			return RaycastBox(s->GetMinCorner(), s->GetMaxCorner(), origin, invDirection, maxDistance, outDistance, outNormal);
+		}
+		case ColliderShape::COLLIDER_OBB:
+		{
+			const Collider_OBB* s = scast<const Collider_OBB*>(c);
+			return RaycastOrientedBox(s->GetPos(), s->GetRot(), s->GetHalfExtents(), origin, direction, maxDistance, outDistance, outNormal);
+		}
+		case ColliderShape::COLLIDER_BCP:
+		{
+			const Collider_BCP* s = scast<const Collider_BCP*>(c);
+			f32 halfHeight = fmax(s->GetHeight() * 0.5f - s->GetRadius(), 0.0f);
+			return RaycastCapsule(s->GetPos(), halfHeight, s->GetRadius(), origin, direction, maxDistance, outDistance, outNormal);
+		}
+		default:
+			break;
+		}
+
+		//k-DOPs and hulls are point clouds, march only the part of the ray inside their bounds
+		//so the advancement works on short distances
+		ColliderBounds bounds = c->GetBounds();
+
+		f32 near{};
+		if (!bounds.IntersectsRay(origin, invDirection, maxDistance, near)) return false;
+
+		f32 length = fmin(maxDistance - near, vlength(bounds.max - bounds.min));
+
+		if (!RaycastConvex(
+			GetColliderSupport(c),
+			origin + direction * near,
+			direction,
+			length,
+			outDistance,
+			outNormal))
+		{
+			return false;
+		}
+
+		outDistance += near;
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,260 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <algorithm>
+#include <bit>
+
+#include "physics/collision/kp_spatial_hash.hpp"
+#include "physics/collision/kp_collider.hpp"
+
+using std::clamp;
+using std::max;
+using std::bit_ceil;
+
+namespace KalaPhysics::Physics::Collision
+{
+	void SpatialHash::SetCellSize(f32 newValue)
+	{
+		cellSize = clamp(newValue, MIN_HASH_CELL_SIZE, MAX_HASH_CELL_SIZE);
+		inverseCellSize = 1.0f / cellSize;
+	}
+	f32 SpatialHash::GetCellSize() const { return cellSize; }
+
+	i32 SpatialHash::CreateProxy(
+		const ColliderBounds& bounds,
+		Collider* collider)
+	{
+		i32 id{};
+
+		if (freeList != -1)
+		{
+			id = freeList;
+			freeList = proxies[id].nextFree;
+		}
+		else
+		{
+			proxies.push_back({});
+			id = scast<i32>(proxies.size() - 1);
+		}
+
+		HashProxy& p = proxies[id];
+		p.bounds = bounds;
+		p.collider = collider;
+		p.nextFree = -1;
+		p.isAlive = true;
+		p.isOversized = false;
+		p.isSphere = collider != nullptr
+			&& (collider->GetColliderShape() == ColliderShape::COLLIDER_BSP
+			|| collider->GetColliderShape() == ColliderShape::COLLIDER_BCP);
+
+		++proxyCount;
+
+		return id;
+	}
+	void SpatialHash::DestroyProxy(i32 proxyID)
+	{
+		if (!IsValidProxy(proxyID)) return;
+
+		HashProxy& p = proxies[proxyID];
+		p.collider = nullptr;
+		p.isAlive = false;
+		p.isOversized = false;
+		p.isSphere = false;
+		p.nextFree = freeList;
+
+		freeList = proxyID;
+		--proxyCount;
+	}
+	void SpatialHash::MoveProxy(
+		i32 proxyID,
+		const ColliderBounds& bounds)
+	{
+		if (!IsValidProxy(proxyID)) return;
+
+		proxies[proxyID].bounds = bounds;
+	}
+
+	bool SpatialHash::IsValidProxy(i32 proxyID) const
+	{
+		return proxyID >= 0
+			&& proxyID < scast<i32>(proxies.size())
+			&& proxies[proxyID].isAlive;
+	}
+	Collider* SpatialHash::GetCollider(i32 proxyID) const
+	{
+		return IsValidProxy(proxyID)
+			? proxies[proxyID].collider
+			: nullptr;
+	}
+
+	u32 SpatialHash::GetProxyCount() const { return proxyCount; }
+
+	const SpatialHashStats& SpatialHash::GetStats() const { return stats; }
+
+	void SpatialHash::Build()
+	{
+		entries.clear();
+		occupiedSlots.clear();
+		oversized.clear();
+		probeCount = 0;
+
+		//count entries first so the table can be sized before anything is inserted
+		u64 entryEstimate{};
+		for (auto& p : proxies)
+		{
+			if (!p.isAlive) continue;
+
+			u64 cells =
+				scast<u64>(CellCoord(p.bounds.max.x) - CellCoord(p.bounds.min.x) + 1)
+				* scast<u64>(CellCoord(p.bounds.max.y) - CellCoord(p.bounds.min.y) + 1)
+				* scast<u64>(CellCoord(p.bounds.max.z) - CellCoord(p.bounds.min.z) + 1);
+
+			p.isOversized = cells > MAX_CELLS_PER_PROXY;
+			if (!p.isOversized) entryEstimate += cells;
+		}
+
+		//keep the load factor at or below one half
+		size_t wantedCapacity = bit_ceil(max<size_t>(64, scast<size_t>(entryEstimate) * 2));
+		if (table.size() < wantedCapacity)
+		{
+			table.assign(wantedCapacity, HashCell{});
+			stamp = 0;
+		}
+
+		//wrapping back to zero would make every cell look freshly written
+		if (++stamp == 0)
+		{
+			for (auto& c : table) c.stamp = 0;
+			stamp = 1;
+		}
+
+		for (i32 id = 0; id < scast<i32>(proxies.size()); id++)
+		{
+			const HashProxy& p = proxies[id];
+			if (!p.isAlive) continue;
+
+			if (p.isOversized)
+			{
+				oversized.push_back(id);
+				continue;
+			}
+
+			i32 minX = CellCoord(p.bounds.min.x);
+			i32 minY = CellCoord(p.bounds.min.y);
+			i32 minZ = CellCoord(p.bounds.min.z);
+			i32 maxX = CellCoord(p.bounds.max.x);
+			i32 maxY = CellCoord(p.bounds.max.y);
+			i32 maxZ = CellCoord(p.bounds.max.z);
+
+			for (i32 x = minX; x <= maxX; x++)
+			{
+				for (i32 y = minY; y <= maxY; y++)
+				{
+					for (i32 z = minZ; z <= maxZ; z++)
+					{
+						HashCell& cell = table[FindOrInsertCell(x, y, z)];
+
+						entries.push_back({ id, cell.head });
+						cell.head = scast<u32>(entries.size() - 1);
+						++cell.count;
+						if (p.isSphere) ++cell.sphereCount;
+					}
+				}
+			}
+		}
+
+		//oversized proxies are tested against everything in batches,
+		//packed slots line up with proxy IDs so hits map straight back to proxies
+		packed.Clear();
+		if (!oversized.empty())
+		{
+			for (const auto& p : proxies)
+			{
+				if (p.isAlive) packed.Push(p.bounds);
+				else packed.PushEmpty();
+			}
+		}
+
+		//
+		// OCCUPANCY STATISTICS
+		//
+
+		stats = {};
+		stats.tableCapacity = scast<u32>(table.size());
+		stats.occupiedCells = scast<u32>(occupiedSlots.size());
+		stats.entryCount = scast<u32>(entries.size());
+		stats.oversizedProxies = scast<u32>(oversized.size());
+
+		for (u32 slot : occupiedSlots)
+		{
+			stats.maxCellOccupancy = max(stats.maxCellOccupancy, table[slot].count);
+		}
+
+		if (stats.occupiedCells > 0)
+		{
+			stats.averageCellOccupancy = scast<f32>(stats.entryCount) / scast<f32>(stats.occupiedCells);
+		}
+		if (stats.entryCount > 0)
+		{
+			stats.averageProbeLength = scast<f32>(probeCount) / scast<f32>(stats.entryCount);
+		}
+	}
+
+	u32 SpatialHash::FindOrInsertCell(
+		i32 x,
+		i32 y,
+		i32 z)
+	{
+		u32 mask = scast<u32>(table.size() - 1);
+		u32 hash =
+			(scast<u32>(x) * 73856093u)
+			^ (scast<u32>(y) * 19349663u)
+			^ (scast<u32>(z) * 83492791u);
+
+		//linear probing, the table is never more than half full
+		for (u32 slot = hash & mask;; slot = (slot + 1) & mask)
+		{
+			++probeCount;
+
+			HashCell& cell = table[slot];
+
+			if (cell.stamp != stamp)
+			{
+				cell.x = x;
+				cell.y = y;
+				cell.z = z;
+				cell.stamp = stamp;
+				cell.head = NULL_ENTRY;
+				cell.count = 0;
+				cell.sphereCount = 0;
+
+				occupiedSlots.push_back(slot);
+
+				return slot;
+			}
+
+			if (cell.x == x
+				&& cell.y == y
+				&& cell.z == z)
+			{
+				return slot;
+			}
+		}
+	}
+
+	void SpatialHash::Clear()
+	{
+		proxies.clear();
+		entries.clear();
+		occupiedSlots.clear();
+		oversized.clear();
+		packed.Clear();
+
+		freeList = -1;
+		proxyCount = 0;
+
+		stats = {};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <algorithm>
+#include <bit>
+
+#include "physics/collision/kp_sweep_and_prune.hpp"
+
+using std::sort;
+using std::remove_if;
+using std::bit_width;
+
+namespace KalaPhysics::Physics::Collision
+{
+	//Orders endpoints by value, min endpoints go first on ties so touching bounds still overlap
+	static inline bool EndpointLess(
+		const SAPEndpoint& a,
+		const SAPEndpoint& b)
+	{
+		if (a.value != b.value) return a.value < b.value;
+		return (a.data & 1u) < (b.data & 1u);
+	}
+
+	i32 SweepAndPrune::CreateProxy(
+		const ColliderBounds& bounds,
+		Collider* collider)
+	{
+		i32 id{};
+
+		if (freeList != -1)
+		{
+			id = freeList;
+			freeList = proxies[id].nextFree;
+		}
+		else
+		{
+			proxies.push_back({});
+			id = scast<i32>(proxies.size() - 1);
+		}
+
+		SAPProxy& p = proxies[id];
+		p.bounds = bounds;
+		p.collider = collider;
+		p.activeSlot = -1;
+		p.nextFree = -1;
+		p.isAlive = true;
+
+		u32 data = scast<u32>(id) << 1;
+		for (u8 axis = 0; axis < 3; axis++)
+		{
+			endpoints[axis].push_back({ vcomp(bounds.min, axis), data });
+			endpoints[axis].push_back({ vcomp(bounds.max, axis), data | 1u });
+		}
+
+		++proxyCount;
+		++pendingInserts;
+
+		return id;
+	}
+	void SweepAndPrune::DestroyProxy(i32 proxyID)
+	{
+		if (!IsValidProxy(proxyID)) return;
+
+		SAPProxy& p = proxies[proxyID];
+		p.collider = nullptr;
+		p.isAlive = false;
+		p.nextFree = freeList;
+
+		freeList = proxyID;
+		--proxyCount;
+
+		hasRemovals = true;
+	}
+	void SweepAndPrune::MoveProxy(
+		i32 proxyID,
+		const ColliderBounds& bounds)
+	{
+		if (!IsValidProxy(proxyID)) return;
+
+		proxies[proxyID].bounds = bounds;
+	}
+
+	bool SweepAndPrune::IsValidProxy(i32 proxyID) const
+	{
+		return proxyID >= 0
+			&& proxyID < scast<i32>(proxies.size())
+			&& proxies[proxyID].isAlive;
+	}
+	Collider* SweepAndPrune::GetCollider(i32 proxyID) const
+	{
+		return IsValidProxy(proxyID)
+			? proxies[proxyID].collider
+			: nullptr;
+	}
+
+	u32 SweepAndPrune::GetProxyCount() const { return proxyCount; }
+	u64 SweepAndPrune::GetSwapCount() const { return swapCount; }
+	u8 SweepAndPrune::GetSweepAxis() const { return sweepAxis; }
+
+	void SweepAndPrune::SortEndpoints()
+	{
+		swapCount = 0;
+
+		//a slot freed and reused in the same frame still has its old endpoints,
+		//so removals are compacted by ownership rather than by the alive flag alone
+		if (hasRemovals)
+		{
+			for (auto& axisEndpoints : endpoints)
+			{
+				//keep exactly one min and one max endpoint per live proxy
+				for (auto& p : proxies) p.activeSlot = 0;
+
+				axisEndpoints.erase(remove_if(
+					axisEndpoints.begin(),
+					axisEndpoints.end(),
+					[this](const SAPEndpoint& e)
+					{
+						SAPProxy& p = proxies[e.GetProxy()];
+						if (!p.isAlive) return true;
+
+						i32 bit = e.IsMax() ? 2 : 1;
+						if (p.activeSlot & bit) return true;
+
+						p.activeSlot |= bit;
+						return false;
+					}),
+					axisEndpoints.end());
+			}
+
+			hasRemovals = false;
+		}
+
+		for (u8 axis = 0; axis < 3; axis++)
+		{
+			vector<SAPEndpoint>& axisEndpoints = endpoints[axis];
+
+			for (auto& e : axisEndpoints)
+			{
+				const ColliderBounds& b = proxies[e.GetProxy()].bounds;
+				e.value = e.IsMax()
+					? vcomp(b.max, axis)
+					: vcomp(b.min, axis);
+			}
+
+			//new endpoints start at the back of the array and each one costs a full pass to sink,
+			//so a large batch of them is cheaper to place with a regular sort
+			if (pendingInserts > 2 * bit_width(axisEndpoints.size()))
+			{
+				sort(axisEndpoints.begin(), axisEndpoints.end(), EndpointLess);
+				continue;
+			}
+
+			for (size_t i = 1; i < axisEndpoints.size(); i++)
+			{
+				SAPEndpoint key = axisEndpoints[i];
+				size_t j = i;
+
+				while (j > 0 && EndpointLess(key, axisEndpoints[j - 1]))
+				{
+					axisEndpoints[j] = axisEndpoints[j - 1];
+					--j;
+					++swapCount;
+				}
+
+				axisEndpoints[j] = key;
+			}
+		}
+
+		pendingInserts = 0;
+	}
+
+	u8 SweepAndPrune::PickSweepAxis() const
+	{
+		if (proxyCount == 0) return 0;
+
+		//sweep along the axis where the bounds centers are spread the most
+		vec3 sum{};
+		vec3 sumSq{};
+
+		for (const auto& p : proxies)
+		{
+			if (!p.isAlive) continue;
+
+			vec3 c = p.bounds.GetCenter();
+			sum += c;
+			sumSq += vmul(c, c);
+		}
+
+		f32 inv = 1.0f / scast<f32>(proxyCount);
+		vec3 mean = sum * inv;
+		vec3 variance = sumSq * inv - vmul(mean, mean);
+
+		if (variance.x >= variance.y
+			&& variance.x >= variance.z)
+		{
+			return 0;
+		}
+
+		return variance.y >= variance.z ? 1 : 2;
+	}
+
+	void SweepAndPrune::Clear()
+	{
+		proxies.clear();
+		for (auto& axisEndpoints : endpoints) axisEndpoints.clear();
+		active.clear();
+
+		freeList = -1;
+		proxyCount = 0;
+		hasRemovals = false;
+		pendingInserts = 0;
+		swapCount = 0;
+	}
+}
\ No newline at end of file
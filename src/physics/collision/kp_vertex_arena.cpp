@@ -0,0 +1,252 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <algorithm>
+#include <functional>
+
+#include "physics/collision/kp_vertex_arena.hpp"
+
+using std::vector;
+using std::array;
+using std::unique_ptr;
+using std::make_unique;
+using std::max;
+using std::less;
+using std::lower_bound;
+using std::sort;
+
+namespace KalaPhysics::Physics::Collision
+{
+	struct VertexRange
+	{
+		vec3* data{};
+		u32 count{};
+	};
+
+	static vector<unique_ptr<vec3[]>> chunks{};
+
+	//unused tail of the newest chunk
+	static vec3* head{};
+	static u32 headRemaining{};
+
+	//freed ranges, short ones binned by exact length
+	static array<vector<vec3*>, VERTEX_ARENA_MAX_BINNED + 1> bins{};
+	//sorted by address so neighbouring ranges merge as soon as both are free
+	static vector<VertexRange> largeRanges{};
+
+	static u32 liveCount{};
+	static u32 capacity{};
+
+	//scratch of MergeFreeRanges
+	static vector<VertexRange> mergeRanges{};
+
+	static void AddChunk(u32 count);
+	static void RetireHead();
+	//Carves count vertices from a freed range, nullptr if none fits
+	static vec3* TakeFreeRange(u32 count);
+	//Merges every pair of neighbouring free ranges, binned ones included
+	static void MergeFreeRanges();
+	//Returns a free range to the bins or merges it into the sorted large ranges
+	static void AddFreeRange(
+		vec3* data,
+		u32 count);
+
+	vec3* VertexArena::Allocate(u32 count)
+	{
+		if (count == 0) return nullptr;
+
+		liveCount += count;
+
+		//recycle a freed range first
+		vec3* data = TakeFreeRange(count);
+		if (data) return data;
+
+		if (headRemaining < count)
+		{
+			//binned ranges only merge here, once before the arena would grow
+			RetireHead();
+			MergeFreeRanges();
+
+			data = TakeFreeRange(count);
+			if (data) return data;
+
+			AddChunk(max(count, VERTEX_ARENA_CHUNK_SIZE));
+		}
+
+		data = head;
+		head += count;
+		headRemaining -= count;
+
+		return data;
+	}
+	void VertexArena::Free(
+		vec3* data,
+		u32 count)
+	{
+		if (!data
+			|| count == 0)
+		{
+			return;
+		}
+
+		liveCount -= count;
+
+		AddFreeRange(data, count);
+	}
+
+	void VertexArena::Reserve(u32 count)
+	{
+		if (headRemaining >= count) return;
+
+		RetireHead();
+		AddChunk(max(count, VERTEX_ARENA_CHUNK_SIZE));
+	}
+
+	u32 VertexArena::GetLiveCount() { return liveCount; }
+	u32 VertexArena::GetCapacity() { return capacity; }
+
+	void AddChunk(u32 count)
+	{
+		chunks.push_back(make_unique<vec3[]>(count));
+
+		head = chunks.back().get();
+		headRemaining = count;
+
+		capacity += count;
+	}
+
+	void RetireHead()
+	{
+		//the unused tail stays usable as a freed range
+		if (headRemaining == 0) return;
+
+		AddFreeRange(head, headRemaining);
+
+		head = nullptr;
+		headRemaining = 0;
+	}
+
+	vec3* TakeFreeRange(u32 count)
+	{
+		if (count <= VERTEX_ARENA_MAX_BINNED)
+		{
+			auto& bin = bins[count];
+			if (!bin.empty())
+			{
+				vec3* data = bin.back();
+				bin.pop_back();
+
+				return data;
+			}
+		}
+
+		//first fit in address order keeps the low ends of the chunks packed
+		for (size_t i = 0; i < largeRanges.size(); i++)
+		{
+			VertexRange& r = largeRanges[i];
+			if (r.count < count) continue;
+
+			vec3* data = r.data;
+			r.data += count;
+			r.count -= count;
+
+			//short remainders are only reachable through their bin
+			if (r.count <= VERTEX_ARENA_MAX_BINNED)
+			{
+				if (r.count > 0) bins[r.count].push_back(r.data);
+				largeRanges.erase(largeRanges.begin() + i);
+			}
+
+			return data;
+		}
+
+		return nullptr;
+	}
+
+	void MergeFreeRanges()
+	{
+		mergeRanges.clear();
+
+		for (u32 count = 1; count <= VERTEX_ARENA_MAX_BINNED; count++)
+		{
+			for (vec3* data : bins[count]) mergeRanges.push_back({ data, count });
+			bins[count].clear();
+		}
+		mergeRanges.insert(mergeRanges.end(), largeRanges.begin(), largeRanges.end());
+		largeRanges.clear();
+
+		sort(mergeRanges.begin(), mergeRanges.end(),
+			[](const VertexRange& a, const VertexRange& b) { return less<vec3*>{}(a.data, b.data); });
+
+		//ranges come out in address order, so the large list stays sorted
+		VertexRange run{};
+		auto _flush = [&run]()
+			{
+				if (run.count == 0) return;
+
+				if (run.count <= VERTEX_ARENA_MAX_BINNED) bins[run.count].push_back(run.data);
+				else largeRanges.push_back(run);
+			};
+
+		for (const VertexRange& r : mergeRanges)
+		{
+			if (run.count > 0
+				&& run.data + run.count == r.data)
+			{
+				run.count += r.count;
+				continue;
+			}
+
+			_flush();
+			run = r;
+		}
+		_flush();
+	}
+
+	void AddFreeRange(
+		vec3* data,
+		u32 count)
+	{
+		auto next = lower_bound(
+			largeRanges.begin(),
+			largeRanges.end(),
+			data,
+			[](const VertexRange& r, vec3* d) { return less<vec3*>{}(r.data, d); });
+
+		bool joinsPrevious = next != largeRanges.begin()
+			&& (next - 1)->data + (next - 1)->count == data;
+		bool joinsNext = next != largeRanges.end()
+			&& data + count == next->data;
+
+		if (joinsPrevious)
+		{
+			auto previous = next - 1;
+			previous->count += count;
+
+			if (joinsNext)
+			{
+				previous->count += next->count;
+				largeRanges.erase(next);
+			}
+
+			return;
+		}
+		if (joinsNext)
+		{
+			next->data = data;
+			next->count += count;
+
+			return;
+		}
+
+		//short ranges without a free neighbour wait in their bin,
+		//binned ranges only merge in MergeFreeRanges so a bin hit stays O(1)
+		if (count <= VERTEX_ARENA_MAX_BINNED) bins[count].push_back(data);
+		else largeRanges.insert(next, { data, count });
+	}
+}
\ No newline at end of file
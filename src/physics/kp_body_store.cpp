@@ -0,0 +1,386 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <cmath>
+#include <algorithm>
+
+#include "physics/kp_body_store.hpp"
+#include "physics/kp_rigidbody.hpp"
+#include "physics/collision/kp_collider.hpp"
+
+using KalaPhysics::Physics::Collision::Collider;
+using KalaPhysics::Physics::Collision::vrotate;
+using KalaPhysics::Physics::Collision::vrotate_inv;
+using KalaPhysics::Physics::Collision::qmul_inv;
+using KalaPhysics::Physics::Collision::vbasis;
+using KalaPhysics::Physics::Collision::vmul;
+using KalaPhysics::Physics::Collision::vdot;
+
+using std::sqrt;
+using std::sort;
+using std::unique;
+using std::binary_search;
+
+namespace KalaPhysics::Physics
+{
+	//0 is reserved for awake bodies
+	static u32 nextSleepGroup = 1;
+
+	//reused by WakeBodies
+	static vector<u32> wakeGroups{};
+
+	static void SetRotationLock(
+		u32 index,
+		bool isLocked);
+	static void IntegrateRotation(
+		quat& q,
+		const vec3& w,
+		f32 deltaTime);
+
+	u32 BodyStore::AddBody(RigidBody* owner)
+	{
+		quat identity{};
+		identity.w = 1.0f;
+
+		positions.push_back(vec3(0.0f));
+		rotations.push_back(identity);
+		velocities.push_back(vec3(0.0f));
+		angularVelocities.push_back(vec3(0.0f));
+		inverseMasses.push_back(0.0f);
+		inverseInertias.push_back(vec3(0.0f));
+		flags.push_back(0);
+		sleepTimes.push_back(0.0f);
+
+		vars.push_back(RigidBodyVars{});
+		owners.push_back(owner);
+		sleepGroups.push_back(0);
+		previousPositions.push_back(vec3(0.0f));
+		previousRotations.push_back(identity);
+
+		return scast<u32>(owners.size() - 1);
+	}
+
+	void BodyStore::RemoveBody(u32 index)
+	{
+		if (index >= owners.size()) return;
+
+		u32 last = scast<u32>(owners.size() - 1);
+
+		if (index != last)
+		{
+			positions[index] = positions[last];
+			rotations[index] = rotations[last];
+			velocities[index] = velocities[last];
+			angularVelocities[index] = angularVelocities[last];
+			inverseMasses[index] = inverseMasses[last];
+			inverseInertias[index] = inverseInertias[last];
+			flags[index] = flags[last];
+			sleepTimes[index] = sleepTimes[last];
+
+			vars[index] = vars[last];
+			owners[index] = owners[last];
+			sleepGroups[index] = sleepGroups[last];
+			previousPositions[index] = previousPositions[last];
+			previousRotations[index] = previousRotations[last];
+
+			owners[index]->bodyIndex = index;
+		}
+
+		positions.pop_back();
+		rotations.pop_back();
+		velocities.pop_back();
+		angularVelocities.pop_back();
+		inverseMasses.pop_back();
+		inverseInertias.pop_back();
+		flags.pop_back();
+		sleepTimes.pop_back();
+
+		vars.pop_back();
+		owners.pop_back();
+		sleepGroups.pop_back();
+		previousPositions.pop_back();
+		previousRotations.pop_back();
+	}
+
+	u32 BodyStore::GetBodyCount() { return scast<u32>(owners.size()); }
+
+	void BodyStore::SleepBodies(span<const u32> indices)
+	{
+		if (indices.empty()) return;
+
+		u32 group = nextSleepGroup++;
+		//skip the awake marker once the counter wraps
+		if (nextSleepGroup == 0) nextSleepGroup = 1;
+
+		for (u32 i : indices)
+		{
+			if (i >= owners.size()) continue;
+
+			flags[i] |= BODY_FLAG_SLEEPING;
+			velocities[i] = vec3(0.0f);
+			angularVelocities[i] = vec3(0.0f);
+			sleepTimes[i] = 0.0f;
+			sleepGroups[i] = group;
+		}
+	}
+
+	void BodyStore::WakeBodies(span<const u32> indices)
+	{
+		wakeGroups.clear();
+
+		for (u32 i : indices)
+		{
+			if (i >= owners.size()) continue;
+
+			sleepTimes[i] = 0.0f;
+			if (flags[i] & BODY_FLAG_SLEEPING) wakeGroups.push_back(sleepGroups[i]);
+		}
+
+		if (wakeGroups.empty()) return;
+
+		sort(wakeGroups.begin(), wakeGroups.end());
+		wakeGroups.erase(unique(wakeGroups.begin(), wakeGroups.end()), wakeGroups.end());
+
+		//groups are not indexed, one pass over every body wakes all of them at once
+		u32 count = GetBodyCount();
+		for (u32 i = 0; i < count; i++)
+		{
+			if (!(flags[i] & BODY_FLAG_SLEEPING)
+				|| !binary_search(wakeGroups.begin(), wakeGroups.end(), sleepGroups[i]))
+			{
+				continue;
+			}
+
+			flags[i] &= scast<u8>(~BODY_FLAG_SLEEPING);
+			sleepTimes[i] = 0.0f;
+			sleepGroups[i] = 0;
+		}
+	}
+	void BodyStore::WakeBody(u32 index) { WakeBodies(span<const u32>(&index, 1)); }
+
+	void BodyStore::UpdateColliderPoses(u32 index)
+	{
+		if (index >= owners.size()) return;
+
+		RigidBody* owner = owners[index];
+		const auto& colliderIDs = owner->GetAllColliders();
+
+		//removed colliders stay listed until their ID is removed, so the lock is refreshed on the way
+		bool isLocked = false;
+
+		for (u8 c = 0; c < owner->GetColliderCount(); c++)
+		{
+			Collider* col = Collider::GetRegistry().GetContent(colliderIDs[c]);
+			if (col
+				&& !col->IsStatic())
+			{
+				col->FollowParent(positions[index], rotations[index]);
+				if (!col->FollowsRotation()) isLocked = true;
+			}
+		}
+
+		SetRotationLock(index, isLocked);
+	}
+
+	void BodyStore::RefreshRotationLock(u32 index)
+	{
+		if (index >= owners.size()) return;
+
+		RigidBody* owner = owners[index];
+		const auto& colliderIDs = owner->GetAllColliders();
+
+		bool isLocked = false;
+
+		for (u8 c = 0; c < owner->GetColliderCount(); c++)
+		{
+			Collider* col = Collider::GetRegistry().GetContent(colliderIDs[c]);
+			if (col
+				&& !col->IsStatic()
+				&& !col->FollowsRotation())
+			{
+				isLocked = true;
+				break;
+			}
+		}
+
+		SetRotationLock(index, isLocked);
+	}
+
+	void BodyStore::RefreshInertia(u32 index)
+	{
+		if (index >= owners.size()) return;
+
+		RigidBodyVars& v = vars[index];
+
+		if (!v.isInertiaCustom)
+		{
+			RigidBody* owner = owners[index];
+			const auto& colliderIDs = owner->GetAllColliders();
+
+			const vec3& bodyPos = positions[index];
+			const quat& bodyRot = rotations[index];
+
+			//the mass is spread over the carried shapes by volume,
+			//each shape adds its inertia rotated into body space and shifted to the body origin
+			f32 totalVolume = 0.0f;
+			vec3 inertia(0.0f);
+
+			for (u8 c = 0; c < owner->GetColliderCount(); c++)
+			{
+				Collider* col = Collider::GetRegistry().GetContent(colliderIDs[c]);
+				if (!col
+					|| col->IsStatic())
+				{
+					continue;
+				}
+
+				vec3 centroid{};
+				vec3 shapeInertia{};
+				f32 volume = col->GetMassProperties(centroid, shapeInertia);
+				if (!(volume > 0.0f)) continue;
+
+				vec3 pos{};
+				quat rot{};
+				col->GetPose(pos, rot);
+
+				vec3 axisX{};
+				vec3 axisY{};
+				vec3 axisZ{};
+				vbasis(qmul_inv(bodyRot, rot), axisX, axisY, axisZ);
+
+				//diagonal of the rotated shape tensor, the off-diagonal terms are dropped
+				vec3 rotated = vmul(axisX, axisX) * shapeInertia.x
+					+ vmul(axisY, axisY) * shapeInertia.y
+					+ vmul(axisZ, axisZ) * shapeInertia.z;
+
+				vec3 offset = vrotate_inv(bodyRot, pos + vrotate(rot, centroid) - bodyPos);
+				vec3 shifted = vec3(vdot(offset, offset)) - vmul(offset, offset);
+
+				inertia += (rotated + shifted) * volume;
+				totalVolume += volume;
+			}
+
+			v.principalInertia = totalVolume > 0.0f
+				? kclamp(inertia * (v.mass / totalVolume), vec3(0.0f), MAX_PRINCIPAL_INERTIA)
+				: vec3(0.0f);
+		}
+
+		const vec3& inertia = v.principalInertia;
+		inverseInertias[index] = vec3(
+			inertia.x > 0.0f ? 1.0f / inertia.x : 0.0f,
+			inertia.y > 0.0f ? 1.0f / inertia.y : 0.0f,
+			inertia.z > 0.0f ? 1.0f / inertia.z : 0.0f);
+	}
+
+	void BodyStore::StorePreviousState()
+	{
+		//same sizes every step, so these are plain copies without reallocating
+		previousPositions.assign(positions.begin(), positions.end());
+		previousRotations.assign(rotations.begin(), rotations.end());
+	}
+
+	void BodyStore::IntegrateVelocities(
+		f32 deltaTime,
+		const vec3& gravity)
+	{
+		u32 count = GetBodyCount();
+
+		vec3* vel = velocities.data();
+		vec3* angVel = angularVelocities.data();
+		const f32* invMass = inverseMasses.data();
+		const u8* flag = flags.data();
+		const RigidBodyVars* v = vars.data();
+
+		for (u32 i = 0; i < count; i++)
+		{
+			//sleeping bodies and bodies with infinite mass never move on their own
+			if ((flag[i] & BODY_FLAG_SLEEPING)
+				|| invMass[i] == 0.0f)
+			{
+				continue;
+			}
+
+			vec3 g = gravity;
+			g.x *= v[i].gravityScale.x;
+			g.y *= v[i].gravityScale.y;
+			g.z *= v[i].gravityScale.z;
+
+			vel[i] += g * deltaTime;
+			vel[i] *= 1.0f / (1.0f + deltaTime * v[i].linearDamp);
+			angVel[i] *= 1.0f / (1.0f + deltaTime * v[i].angularDamp);
+		}
+	}
+
+	void BodyStore::IntegratePositions(f32 deltaTime)
+	{
+		u32 count = GetBodyCount();
+
+		vec3* pos = positions.data();
+		quat* rot = rotations.data();
+		const vec3* vel = velocities.data();
+		const vec3* angVel = angularVelocities.data();
+		const f32* invMass = inverseMasses.data();
+		const u8* flag = flags.data();
+
+		for (u32 i = 0; i < count; i++)
+		{
+			if ((flag[i] & BODY_FLAG_SLEEPING)
+				|| invMass[i] == 0.0f)
+			{
+				continue;
+			}
+
+			//semi-implicit euler, the solved velocity moves the body
+			pos[i] += vel[i] * deltaTime;
+
+			//bodies locked by their shapes keep their rotation
+			if (!(flag[i] & BODY_FLAG_FIXED_ROTATION)) IntegrateRotation(rot[i], angVel[i], deltaTime);
+
+			//colliders store world-space shapes, they are rebuilt from the body pose
+			//every step so slow motion and rotation never leave them behind
+			UpdateColliderPoses(i);
+		}
+	}
+
+	void SetRotationLock(
+		u32 index,
+		bool isLocked)
+	{
+		u8& flag = BodyStore::flags[index];
+
+		if (!isLocked)
+		{
+			flag &= scast<u8>(~BODY_FLAG_FIXED_ROTATION);
+			return;
+		}
+
+		flag |= BODY_FLAG_FIXED_ROTATION;
+		BodyStore::angularVelocities[index] = vec3(0.0f);
+	}
+
+	void IntegrateRotation(
+		quat& q,
+		const vec3& w,
+		f32 deltaTime)
+	{
+		//q' = q + 0.5 * (w, 0) * q * dt
+		f32 h = 0.5f * deltaTime;
+
+		f32 qx = q.x + h * (w.x * q.w + w.y * q.z - w.z * q.y);
+		f32 qy = q.y + h * (w.y * q.w + w.z * q.x - w.x * q.z);
+		f32 qz = q.z + h * (w.z * q.w + w.x * q.y - w.y * q.x);
+		f32 qw = q.w - h * (w.x * q.x + w.y * q.y + w.z * q.z);
+
+		f32 len = sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+		if (len > 0.0f)
+		{
+			f32 inv = 1.0f / len;
+			q.x = qx * inv;
+			q.y = qy * inv;
+			q.z = qz * inv;
+			q.w = qw * inv;
+		}
+	}
+}
\ No newline at end of file
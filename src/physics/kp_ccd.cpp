@@ -0,0 +1,233 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#include "physics/kp_ccd.hpp"
+#include "physics/kp_body_store.hpp"
+#include "physics/kp_rigidbody.hpp"
+#include "physics/collision/kp_collider.hpp"
+#include "physics/collision/kp_broadphase.hpp"
+#include "physics/collision/kp_gjk.hpp"
+
+using KalaPhysics::Physics::Collision::Collider;
+using KalaPhysics::Physics::Collision::ColliderBounds;
+using KalaPhysics::Physics::Collision::Broadphase;
+using KalaPhysics::Physics::Collision::ConvexSupport;
+using KalaPhysics::Physics::Collision::ConvexCastResult;
+using KalaPhysics::Physics::Collision::ConvexCast;
+using KalaPhysics::Physics::Collision::GetColliderSupport;
+using KalaPhysics::Physics::Collision::vdot;
+
+using std::vector;
+using std::fmin;
+using std::sort;
+
+namespace KalaPhysics::Physics
+{
+	struct ImpactEvent
+	{
+		u32 body{};
+		f32 time{}; //fraction of the swept motion
+		vec3 normal{};
+	};
+
+	static CCDStats stats{};
+
+	static vector<ImpactEvent> events{};
+	//reused by every broadphase query
+	static vector<Collider*> candidates{};
+
+	static bool SweepBody(
+		u32 body,
+		const vec3& start,
+		const vec3& motion,
+		f32& outTime,
+		vec3& outNormal);
+	static f32 GetSmallestHalfExtent(u32 body);
+
+	const CCDStats& ContinuousCollision::GetStats() { return stats; }
+
+	void ContinuousCollision::Resolve(f32 deltaTime)
+	{
+		stats = {};
+		events.clear();
+
+		u32 count = BodyStore::GetBodyCount();
+
+		//
+		// FIND FIRST IMPACTS
+		//
+
+		for (u32 i = 0; i < count; i++)
+		{
+			u8 flag = BodyStore::flags[i];
+			if (!(flag & BODY_FLAG_CCD)
+				|| (flag & BODY_FLAG_SLEEPING)
+				|| BodyStore::inverseMasses[i] == 0.0f)
+			{
+				continue;
+			}
+
+			vec3 motion = BodyStore::positions[i] - BodyStore::previousPositions[i];
+
+			f32 threshold = GetSmallestHalfExtent(i) * CCD_MOTION_THRESHOLD;
+			if (vdot(motion, motion) <= threshold * threshold) continue;
+
+			++stats.sweptBodies;
+
+			//colliders already sit at the end of the step, the sweep starts one motion behind them
+			ImpactEvent e{};
+			e.body = i;
+			if (SweepBody(i, vec3(0.0f) - motion, motion, e.time, e.normal)) events.push_back(e);
+		}
+
+		if (events.empty()) return;
+
+		//earliest impacts first, body index keeps ties deterministic
+		sort(events.begin(), events.end(),
+			[](const ImpactEvent& a, const ImpactEvent& b)
+			{
+				return a.time != b.time ? a.time < b.time : a.body < b.body;
+			});
+
+		//
+		// RESOLVE IMPACTS LOCALLY
+		//
+
+		for (const auto& e : events)
+		{
+			u32 i = e.body;
+
+			const vec3 end = BodyStore::positions[i];
+			vec3 position = BodyStore::previousPositions[i];
+			vec3 motion = end - position;
+			vec3& velocity = BodyStore::velocities[i];
+			f32 bounce = 1.0f + BodyStore::vars[i].restitution;
+			f32 remaining = deltaTime;
+
+			f32 time = e.time;
+			vec3 normal = e.normal;
+
+			for (u32 impact = 0; impact < CCD_MAX_IMPACTS; impact++)
+			{
+				++stats.impacts;
+
+				//move to the impact and spend the time it took
+				position += motion * time;
+				remaining *= 1.0f - time;
+
+				//normal points from the body towards what it hit
+				f32 approach = vdot(velocity, normal);
+				if (approach > 0.0f) velocity -= normal * (approach * bounce);
+
+				motion = velocity * remaining;
+
+				if (impact + 1 == CCD_MAX_IMPACTS) break;
+
+				if (!SweepBody(i, position - end, motion, time, normal))
+				{
+					position += motion;
+					break;
+				}
+			}
+
+			BodyStore::positions[i] = position;
+			BodyStore::UpdateColliderPoses(i);
+		}
+	}
+
+	bool SweepBody(
+		u32 body,
+		const vec3& start,
+		const vec3& motion,
+		f32& outTime,
+		vec3& outNormal)
+	{
+		bool hasHit = false;
+		outTime = FLT_MAX;
+
+		RigidBody* owner = BodyStore::owners[body];
+		const auto& colliderIDs = owner->GetAllColliders();
+
+		for (u8 c = 0; c < owner->GetColliderCount(); c++)
+		{
+			Collider* col = Collider::GetRegistry().GetContent(colliderIDs[c]);
+			if (!col
+				|| col->IsTrigger()
+				|| col->IsStatic())
+			{
+				continue;
+			}
+
+			ColliderBounds bounds = col->GetBounds();
+			ColliderBounds from = { bounds.min + start, bounds.max + start };
+			ColliderBounds to = { from.min + motion, from.max + motion };
+
+			Broadphase::Query(from.Merged(to), candidates);
+			if (candidates.empty()) continue;
+
+			ConvexSupport moving = GetColliderSupport(col);
+			moving.pos += start;
+
+			for (Collider* other : candidates)
+			{
+				if (other == col
+					|| other->IsTrigger()
+					|| !Broadphase::CanPair(col, other))
+				{
+					continue;
+				}
+
+				++stats.candidateTests;
+
+				f32 time{};
+				vec3 normal{};
+
+				//pairs already overlapping at the start belong to the discrete contacts
+				ConvexCastResult result = ConvexCast(
+					moving,
+					GetColliderSupport(other),
+					motion,
+					CCD_TARGET_SEPARATION,
+					CCD_TOLERANCE,
+					time,
+					normal);
+
+				if (result == ConvexCastResult::CAST_HIT
+					&& time < outTime)
+				{
+					outTime = time;
+					outNormal = normal;
+					hasHit = true;
+				}
+			}
+		}
+
+		return hasHit;
+	}
+
+	f32 GetSmallestHalfExtent(u32 body)
+	{
+		f32 smallest = FLT_MAX;
+
+		RigidBody* owner = BodyStore::owners[body];
+		const auto& colliderIDs = owner->GetAllColliders();
+
+		for (u8 c = 0; c < owner->GetColliderCount(); c++)
+		{
+			Collider* col = Collider::GetRegistry().GetContent(colliderIDs[c]);
+			if (!col) continue;
+
+			vec3 e = col->GetBounds().GetExtents();
+			smallest = fmin(smallest, fmin(e.x, fmin(e.y, e.z)));
+		}
+
+		return smallest;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,569 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+#include "physics/kp_contact_solver.hpp"
+#include "physics/kp_body_store.hpp"
+#include "physics/kp_rigidbody.hpp"
+#include "physics/collision/kp_collider.hpp"
+#include "physics/collision/kp_collision_math.hpp"
+#include "physics/collision/kp_pair_cache.hpp"
+#include "core/kp_job_system.hpp"
+
+using KalaPhysics::Physics::Collision::Collider;
+using KalaPhysics::Physics::Collision::ContactManifold;
+using KalaPhysics::Physics::Collision::PairCache;
+using KalaPhysics::Physics::Collision::MAX_CONTACT_POINTS;
+using KalaPhysics::Physics::Collision::vdot;
+using KalaPhysics::Physics::Collision::vcross;
+using KalaPhysics::Physics::Collision::vlength2;
+using KalaPhysics::Physics::Collision::vmul;
+using KalaPhysics::Physics::Collision::vrotate;
+using KalaPhysics::Physics::Collision::vrotate_inv;
+using KalaPhysics::Physics::Collision::vtangents;
+using KalaPhysics::Core::JobSystem;
+
+using std::vector;
+using std::array;
+using std::sqrt;
+using std::fmax;
+using std::fmin;
+using std::clamp;
+
+namespace KalaPhysics::Physics
+{
+	//Body slot of the immovable side of a contact
+	constexpr u32 STATIC_BODY = UINT_MAX;
+
+	struct SolverPoint
+	{
+		vec3 ra{};
+		vec3 rb{};
+
+		//world inverse inertia times (r x axis) for the normal and both tangents
+		array<vec3, 3> angularA{};
+		array<vec3, 3> angularB{};
+		array<f32, 3> effectiveMass{};
+
+		f32 bias{};
+
+		f32 normalImpulse{};
+		array<f32, 2> tangentImpulse{};
+	};
+
+	struct SolverContact
+	{
+		u32 bodyA = STATIC_BODY;
+		u32 bodyB = STATIC_BODY;
+		u32 manifold{};
+
+		//normal first, then both tangents
+		array<vec3, 3> axes{};
+
+		f32 invMassA{};
+		f32 invMassB{};
+		f32 friction{};
+
+		u8 pointCount{};
+		array<SolverPoint, MAX_CONTACT_POINTS> points{};
+	};
+
+	static vector<SolverContact> contacts{};
+
+	//union-find parents over dense body indices
+	static vector<u32> parents{};
+
+	static vector<u32> bodyIslands{};
+	static vector<u32> islandBodyStart{};
+	static vector<u32> islandBodies{};
+	static vector<u32> islandContactStart{};
+	static vector<u32> islandContacts{};
+
+	//islands with at least one contact, the only ones with work to do
+	static vector<u32> activeIslands{};
+
+	//sleeping bodies touched by an awake body during the last solve
+	static vector<u32> wakeBodies{};
+
+	//write positions of the island counting sorts
+	static vector<u32> cursors{};
+
+	static u32 FindRoot(u32 i);
+	static void Unite(
+		u32 a,
+		u32 b);
+
+	static u32 FindBody(const Collider* c);
+	static bool IsSleeping(u32 body);
+	static vec3 MulInverseInertia(
+		u32 body,
+		const vec3& v);
+
+	static void PrepareContact(
+		SolverContact& c,
+		const ContactManifold& m,
+		f32 deltaTime);
+	static void SolveIsland(u32 island);
+
+	u32 ContactSolver::GetIslandCount()
+	{
+		return islandBodyStart.empty() ? 0 : scast<u32>(islandBodyStart.size() - 1);
+	}
+	span<const u32> ContactSolver::GetIslandBodies(u32 island)
+	{
+		if (island >= GetIslandCount()) return {};
+
+		return span<const u32>(
+			islandBodies.data() + islandBodyStart[island],
+			islandBodyStart[island + 1] - islandBodyStart[island]);
+	}
+	u32 ContactSolver::GetBodyIsland(u32 bodyIndex)
+	{
+		return bodyIndex < bodyIslands.size() ? bodyIslands[bodyIndex] : INVALID_ISLAND;
+	}
+
+	void ContactSolver::Solve(f32 deltaTime)
+	{
+		u32 bodyCount = BodyStore::GetBodyCount();
+		const vector<ContactManifold>& manifolds = PairCache::GetMutableManifolds();
+
+		contacts.clear();
+		activeIslands.clear();
+		wakeBodies.clear();
+
+		//
+		// COLLECT SOLVABLE CONTACTS
+		//
+
+		parents.resize(bodyCount);
+		for (u32 i = 0; i < bodyCount; i++) parents[i] = i;
+
+		for (u32 m = 0; m < manifolds.size(); m++)
+		{
+			const ContactManifold& manifold = manifolds[m];
+
+			//triggers only report overlaps
+			if (manifold.pointCount == 0
+				|| manifold.a->IsTrigger()
+				|| manifold.b->IsTrigger())
+			{
+				continue;
+			}
+
+			u32 a = FindBody(manifold.a);
+			u32 b = FindBody(manifold.b);
+
+			bool sleepingA = IsSleeping(a);
+			bool sleepingB = IsSleeping(b);
+
+			//sleeping bodies stay put this step, their other contacts were never generated
+			if (sleepingA
+				&& b != STATIC_BODY
+				&& !sleepingB)
+			{
+				wakeBodies.push_back(a);
+			}
+			if (sleepingB
+				&& a != STATIC_BODY
+				&& !sleepingA)
+			{
+				wakeBodies.push_back(b);
+			}
+
+			if (sleepingA) a = STATIC_BODY;
+			if (sleepingB) b = STATIC_BODY;
+
+			//two immovable sides, or two colliders of the same body
+			if (a == b) continue;
+
+			SolverContact c{};
+			c.bodyA = a;
+			c.bodyB = b;
+			c.manifold = m;
+			contacts.push_back(c);
+
+			//immovable bodies don't link islands, otherwise the ground would merge every island
+			if (a != STATIC_BODY
+				&& b != STATIC_BODY)
+			{
+				Unite(a, b);
+			}
+		}
+
+		//
+		// BUILD ISLANDS
+		//
+
+		//every awake dynamic body is an island root or joined to one,
+		//roots are always the lowest body index so island order is stable
+		bodyIslands.assign(bodyCount, INVALID_ISLAND);
+		u32 islandCount{};
+
+		for (u32 i = 0; i < bodyCount; i++)
+		{
+			if ((BodyStore::flags[i] & BODY_FLAG_SLEEPING)
+				|| BodyStore::inverseMasses[i] == 0.0f)
+			{
+				continue;
+			}
+
+			u32 root = FindRoot(i);
+			if (root == i) bodyIslands[i] = islandCount++;
+		}
+
+		islandBodyStart.assign(islandCount + 1, 0);
+		for (u32 i = 0; i < bodyCount; i++)
+		{
+			if (bodyIslands[i] != INVALID_ISLAND
+				|| (BodyStore::flags[i] & BODY_FLAG_SLEEPING)
+				|| BodyStore::inverseMasses[i] == 0.0f)
+			{
+				continue;
+			}
+
+			bodyIslands[i] = bodyIslands[FindRoot(i)];
+		}
+		for (u32 i = 0; i < bodyCount; i++)
+		{
+			if (bodyIslands[i] != INVALID_ISLAND) ++islandBodyStart[bodyIslands[i] + 1];
+		}
+		for (u32 i = 0; i < islandCount; i++) islandBodyStart[i + 1] += islandBodyStart[i];
+
+		islandBodies.resize(islandBodyStart[islandCount]);
+
+		cursors.assign(islandBodyStart.begin(), islandBodyStart.end() - 1);
+		for (u32 i = 0; i < bodyCount; i++)
+		{
+			if (bodyIslands[i] != INVALID_ISLAND) islandBodies[cursors[bodyIslands[i]]++] = i;
+		}
+
+		//contacts follow the island of their dynamic side, in manifold order
+		islandContactStart.assign(islandCount + 1, 0);
+		for (const auto& c : contacts)
+		{
+			u32 body = c.bodyA != STATIC_BODY ? c.bodyA : c.bodyB;
+			++islandContactStart[bodyIslands[body] + 1];
+		}
+		for (u32 i = 0; i < islandCount; i++)
+		{
+			if (islandContactStart[i + 1] > 0) activeIslands.push_back(i);
+			islandContactStart[i + 1] += islandContactStart[i];
+		}
+
+		islandContacts.resize(contacts.size());
+
+		cursors.assign(islandContactStart.begin(), islandContactStart.end() - 1);
+		for (u32 i = 0; i < contacts.size(); i++)
+		{
+			const SolverContact& c = contacts[i];
+			u32 body = c.bodyA != STATIC_BODY ? c.bodyA : c.bodyB;
+			islandContacts[cursors[bodyIslands[body]]++] = i;
+		}
+
+		//woken after the islands are built so the groups join the solve together next step
+		BodyStore::WakeBodies(wakeBodies);
+
+		if (contacts.empty()) return;
+
+		//
+		// SOLVE
+		//
+
+		for (auto& c : contacts) PrepareContact(c, manifolds[c.manifold], deltaTime);
+
+		JobSystem::ParallelFor(
+			scast<u32>(activeIslands.size()),
+			1,
+			[](u32 begin, u32 end, u32)
+			{
+				for (u32 i = begin; i < end; i++) SolveIsland(activeIslands[i]);
+			});
+
+		//accumulated impulses warm start the same points next step
+		vector<ContactManifold>& writable = PairCache::GetMutableManifolds();
+		for (const auto& c : contacts)
+		{
+			ContactManifold& m = writable[c.manifold];
+			for (u8 p = 0; p < c.pointCount; p++)
+			{
+				m.points[p].normalImpulse = c.points[p].normalImpulse;
+				m.points[p].tangentImpulse = c.points[p].tangentImpulse;
+			}
+		}
+	}
+
+	void ContactSolver::UpdateSleeping(f32 deltaTime)
+	{
+		constexpr f32 linear2 = SLEEP_LINEAR_VELOCITY * SLEEP_LINEAR_VELOCITY;
+		constexpr f32 angular2 = SLEEP_ANGULAR_VELOCITY * SLEEP_ANGULAR_VELOCITY;
+
+		u32 islandCount = GetIslandCount();
+
+		for (u32 island = 0; island < islandCount; island++)
+		{
+			span<const u32> bodies = GetIslandBodies(island);
+
+			//an island is only as rested as its busiest body
+			f32 restTime = SLEEP_TIME;
+			for (u32 b : bodies)
+			{
+				f32& t = BodyStore::sleepTimes[b];
+
+				if (vlength2(BodyStore::velocities[b]) > linear2
+					|| vlength2(BodyStore::angularVelocities[b]) > angular2)
+				{
+					t = 0.0f;
+				}
+				else t += deltaTime;
+
+				restTime = fmin(restTime, t);
+			}
+
+			if (restTime >= SLEEP_TIME) BodyStore::SleepBodies(bodies);
+		}
+	}
+
+	u32 FindRoot(u32 i)
+	{
+		while (parents[i] != i)
+		{
+			parents[i] = parents[parents[i]];
+			i = parents[i];
+		}
+
+		return i;
+	}
+
+	void Unite(
+		u32 a,
+		u32 b)
+	{
+		a = FindRoot(a);
+		b = FindRoot(b);
+
+		if (a == b) return;
+
+		if (a < b) parents[b] = a;
+		else parents[a] = b;
+	}
+
+	u32 FindBody(const Collider* c)
+	{
+		if (c->IsStatic()
+			|| c->GetParentRigidBody() == 0)
+		{
+			return STATIC_BODY;
+		}
+
+		RigidBody* rb = RigidBody::GetRegistry().GetContent(c->GetParentRigidBody());
+		if (!rb) return STATIC_BODY;
+
+		u32 index = rb->GetBodyIndex();
+		if (BodyStore::inverseMasses[index] == 0.0f) return STATIC_BODY;
+
+		return index;
+	}
+
+	bool IsSleeping(u32 body)
+	{
+		return body != STATIC_BODY
+			&& (BodyStore::flags[body] & BODY_FLAG_SLEEPING);
+	}
+
+	vec3 MulInverseInertia(
+		u32 body,
+		const vec3& v)
+	{
+		//bodies carrying shapes that can't rotate take no angular impulse
+		if (BodyStore::flags[body] & BODY_FLAG_FIXED_ROTATION) return vec3(0.0f);
+
+		const quat& q = BodyStore::rotations[body];
+
+		return vrotate(q, vmul(BodyStore::inverseInertias[body], vrotate_inv(q, v)));
+	}
+
+	void PrepareContact(
+		SolverContact& c,
+		const ContactManifold& m,
+		f32 deltaTime)
+	{
+		bool hasA = c.bodyA != STATIC_BODY;
+		bool hasB = c.bodyB != STATIC_BODY;
+
+		c.axes[0] = m.normal;
+		vtangents(m.normal, c.axes[1], c.axes[2]);
+
+		c.invMassA = hasA ? BodyStore::inverseMasses[c.bodyA] : 0.0f;
+		c.invMassB = hasB ? BodyStore::inverseMasses[c.bodyB] : 0.0f;
+
+		//immovable sides still bring their material, colliders without a body use the defaults
+		RigidBodyVars defaults{};
+		const RigidBodyVars& varsA = hasA ? BodyStore::vars[c.bodyA] : defaults;
+		const RigidBodyVars& varsB = hasB ? BodyStore::vars[c.bodyB] : defaults;
+
+		c.friction = sqrt(varsA.friction * varsB.friction);
+		f32 restitution = fmax(varsA.restitution, varsB.restitution);
+
+		vec3 posA = hasA ? BodyStore::positions[c.bodyA] : vec3(0.0f);
+		vec3 posB = hasB ? BodyStore::positions[c.bodyB] : vec3(0.0f);
+		vec3 velA = hasA ? BodyStore::velocities[c.bodyA] : vec3(0.0f);
+		vec3 velB = hasB ? BodyStore::velocities[c.bodyB] : vec3(0.0f);
+		vec3 angA = hasA ? BodyStore::angularVelocities[c.bodyA] : vec3(0.0f);
+		vec3 angB = hasB ? BodyStore::angularVelocities[c.bodyB] : vec3(0.0f);
+
+		c.pointCount = m.pointCount;
+
+		for (u8 p = 0; p < m.pointCount; p++)
+		{
+			SolverPoint& sp = c.points[p];
+			const auto& cp = m.points[p];
+
+			sp.ra = cp.position - posA;
+			sp.rb = cp.position - posB;
+
+			for (u8 k = 0; k < 3; k++)
+			{
+				vec3 raXk = vcross(sp.ra, c.axes[k]);
+				vec3 rbXk = vcross(sp.rb, c.axes[k]);
+
+				sp.angularA[k] = hasA ? MulInverseInertia(c.bodyA, raXk) : vec3(0.0f);
+				sp.angularB[k] = hasB ? MulInverseInertia(c.bodyB, rbXk) : vec3(0.0f);
+
+				f32 k2 = c.invMassA + c.invMassB
+					+ vdot(raXk, sp.angularA[k])
+					+ vdot(rbXk, sp.angularB[k]);
+
+				sp.effectiveMass[k] = k2 > 0.0f ? 1.0f / k2 : 0.0f;
+			}
+
+			//baumgarte pushes out the penetration beyond the slop, fast approaches bounce instead
+			vec3 dv = velB + vcross(angB, sp.rb) - velA - vcross(angA, sp.ra);
+			f32 vn = vdot(dv, m.normal);
+
+			f32 correction = fmin(
+				SOLVER_BAUMGARTE / deltaTime * fmax(cp.depth - SOLVER_PENETRATION_SLOP, 0.0f),
+				SOLVER_MAX_CORRECTION_SPEED);
+			f32 bounce = vn < -SOLVER_RESTITUTION_THRESHOLD ? -restitution * vn : 0.0f;
+
+			sp.bias = fmax(correction, bounce);
+
+			sp.normalImpulse = cp.normalImpulse;
+			sp.tangentImpulse = cp.tangentImpulse;
+		}
+	}
+
+	void SolveIsland(u32 island)
+	{
+		vec3* velocities = BodyStore::velocities.data();
+		vec3* angularVelocities = BodyStore::angularVelocities.data();
+
+		const u32* first = islandContacts.data() + islandContactStart[island];
+		u32 count = islandContactStart[island + 1] - islandContactStart[island];
+
+		//immovable sides read and write a throwaway zero velocity
+		vec3 staticVel{};
+		vec3 staticAng{};
+
+		auto _apply = [](
+			const SolverContact& c,
+			const SolverPoint& sp,
+			u8 axis,
+			f32 impulse,
+			vec3& va,
+			vec3& wa,
+			vec3& vb,
+			vec3& wb)
+			{
+				vec3 p = c.axes[axis] * impulse;
+
+				va -= p * c.invMassA;
+				wa -= sp.angularA[axis] * impulse;
+				vb += p * c.invMassB;
+				wb += sp.angularB[axis] * impulse;
+			};
+
+		//
+		// WARM START
+		//
+
+		for (u32 i = 0; i < count; i++)
+		{
+			SolverContact& c = contacts[first[i]];
+
+			vec3& va = c.bodyA != STATIC_BODY ? velocities[c.bodyA] : staticVel;
+			vec3& wa = c.bodyA != STATIC_BODY ? angularVelocities[c.bodyA] : staticAng;
+			vec3& vb = c.bodyB != STATIC_BODY ? velocities[c.bodyB] : staticVel;
+			vec3& wb = c.bodyB != STATIC_BODY ? angularVelocities[c.bodyB] : staticAng;
+
+			for (u8 p = 0; p < c.pointCount; p++)
+			{
+				const SolverPoint& sp = c.points[p];
+
+				_apply(c, sp, 0, sp.normalImpulse, va, wa, vb, wb);
+				_apply(c, sp, 1, sp.tangentImpulse[0], va, wa, vb, wb);
+				_apply(c, sp, 2, sp.tangentImpulse[1], va, wa, vb, wb);
+			}
+
+			staticVel = vec3(0.0f);
+			staticAng = vec3(0.0f);
+		}
+
+		//
+		// PROJECTED GAUSS-SEIDEL
+		//
+
+		for (u32 iter = 0; iter < SOLVER_VELOCITY_ITERATIONS; iter++)
+		{
+			for (u32 i = 0; i < count; i++)
+			{
+				SolverContact& c = contacts[first[i]];
+
+				vec3& va = c.bodyA != STATIC_BODY ? velocities[c.bodyA] : staticVel;
+				vec3& wa = c.bodyA != STATIC_BODY ? angularVelocities[c.bodyA] : staticAng;
+				vec3& vb = c.bodyB != STATIC_BODY ? velocities[c.bodyB] : staticVel;
+				vec3& wb = c.bodyB != STATIC_BODY ? angularVelocities[c.bodyB] : staticAng;
+
+				//friction first so the normal impulses get the last word on penetration
+				for (u8 p = 0; p < c.pointCount; p++)
+				{
+					SolverPoint& sp = c.points[p];
+					f32 maxFriction = c.friction * sp.normalImpulse;
+
+					for (u8 t = 0; t < 2; t++)
+					{
+						vec3 dv = vb + vcross(wb, sp.rb) - va - vcross(wa, sp.ra);
+						f32 lambda = -vdot(dv, c.axes[1 + t]) * sp.effectiveMass[1 + t];
+
+						f32 old = sp.tangentImpulse[t];
+						sp.tangentImpulse[t] = clamp(old + lambda, -maxFriction, maxFriction);
+
+						_apply(c, sp, 1 + t, sp.tangentImpulse[t] - old, va, wa, vb, wb);
+					}
+				}
+
+				for (u8 p = 0; p < c.pointCount; p++)
+				{
+					SolverPoint& sp = c.points[p];
+
+					vec3 dv = vb + vcross(wb, sp.rb) - va - vcross(wa, sp.ra);
+					f32 lambda = -(vdot(dv, c.axes[0]) - sp.bias) * sp.effectiveMass[0];
+
+					//contacts can only push, the accumulated impulse never goes negative
+					f32 old = sp.normalImpulse;
+					sp.normalImpulse = fmax(old + lambda, 0.0f);
+
+					_apply(c, sp, 0, sp.normalImpulse - old, va, wa, vb, wb);
+				}
+
+				staticVel = vec3(0.0f);
+				staticAng = vec3(0.0f);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -3,17 +3,25 @@
 //This is free software, and you are welcome to redistribute it under certain conditions.
 //Read LICENSE.md for more information.
 
+#include <memory>
+#include <cmath>
+
 #include "physics/kp_delayed_ray.hpp"
+#include "physics/kp_projectile_store.hpp"
 
 using KalaPhysics::Core::PhysicsWorld;
 
 using std::to_string;
+using std::unique_ptr;
+using std::make_unique;
+using std::sqrt;
+using std::fmax;
 
 namespace KalaPhysics::Physics
 {
 	static KalaPhysicsRegistry<DelayedRay> registry{};
 
-	KalaPhysicsRegistry<DelayedRay>& GetRegistry() { return registry; }
+	KalaPhysicsRegistry<DelayedRay>& DelayedRay::GetRegistry() { return registry; }
 
 	u32 DelayedRay::MakeMaskFromLayers(initializer_list<u8> layers)
 	{
@@ -28,13 +36,88 @@ namespace KalaPhysics::Physics
 
 	DelayedRay* DelayedRay::Initialize()
 	{
-		return nullptr;
+		unique_ptr<DelayedRay> newRay = make_unique<DelayedRay>();
+		DelayedRay* rayPtr = newRay.get();
+
+		u32 newID = GetRegistry().AddContent(std::move(newRay));
+		if (newID == 0)
+		{
+			Log::Print(
+				"Cannot create a new delayed ray because the delayed ray registry is full!",
+				"DELAYED_RAY",
+				LogType::LOG_ERROR,
+				2);
+
+			return nullptr;
+		}
+
+		rayPtr->ID = newID;
+		rayPtr->isInitialized = true;
+
+		Log::Print(
+			"Created new delayed ray with ID '" + to_string(newID) + "'!",
+			"DELAYED_RAY",
+			LogType::LOG_SUCCESS);
+
+		return rayPtr;
 	}
 
 	bool DelayedRay::IsInitialized() const { return isInitialized; }
 
 	u32 DelayedRay::GetID() const { return ID; }
 
+	u32 DelayedRay::Fire(
+		const vec3& origin,
+		const vec3& direction) const
+	{
+		f32 length = sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+		if (!(length > 0.0f))
+		{
+			Log::Print(
+				"Cannot fire delayed ray '" + to_string(ID) + "' because its direction has no length!",
+				"DELAYED_RAY",
+				LogType::LOG_ERROR,
+				2);
+
+			return 0;
+		}
+
+		ProjectileDesc desc{};
+		desc.position = origin;
+		desc.velocity = direction * (speed / length);
+		desc.force = wind;
+		desc.gravityScale = gravityScale;
+		desc.thrust = acceleration;
+		desc.drag = drag;
+		desc.lifetime = lifetime;
+		desc.mask = mask;
+		desc.rayID = ID;
+		desc.targetMode = targetMode;
+
+		return ProjectileStore::AddProjectile(desc);
+	}
+
+	void DelayedRay::SetSpeed(f32 newValue) { speed = fmax(newValue, 0.0f); }
+	f32 DelayedRay::GetSpeed() const { return speed; }
+
+	void DelayedRay::SetAcceleration(f32 newValue) { acceleration = newValue; }
+	f32 DelayedRay::GetAcceleration() const { return acceleration; }
+
+	void DelayedRay::SetGravityScale(f32 newValue) { gravityScale = newValue; }
+	f32 DelayedRay::GetGravityScale() const { return gravityScale; }
+
+	void DelayedRay::SetWind(const vec3& newValue) { wind = newValue; }
+	const vec3& DelayedRay::GetWind() const { return wind; }
+
+	void DelayedRay::SetDrag(f32 newValue) { drag = fmax(newValue, 0.0f); }
+	f32 DelayedRay::GetDrag() const { return drag; }
+
+	void DelayedRay::SetLifetime(f32 newValue) { lifetime = fmax(newValue, 0.0f); }
+	f32 DelayedRay::GetLifetime() const { return lifetime; }
+
+	void DelayedRay::SetTargetMode(RayTargetMode newValue) { targetMode = newValue; }
+	RayTargetMode DelayedRay::GetTargetMode() const { return targetMode; }
+
 	void DelayedRay::SetMask(u32 m) { mask = m; }
 	void DelayedRay::ClearMask() { mask = 0ULL; }
 
@@ -79,9 +162,4 @@ namespace KalaPhysics::Physics
 	{
 		
 	}
-
-	void DelayedRay::Update(f32 deltaTime)
-	{
-
-	}
 }
\ No newline at end of file
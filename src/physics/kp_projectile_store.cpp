@@ -0,0 +1,360 @@
+//Copyright(C) 2026 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <cmath>
+#include <span>
+
+#include "physics/kp_projectile_store.hpp"
+#include "physics/kp_ray.hpp"
+
+//sse2 is part of every x86-64 cpu, no runtime detection is needed for it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define KP_SSE2_BASELINE 1
+
+	#include <emmintrin.h>
+#endif
+
+using std::sqrt;
+using std::span;
+
+namespace KalaPhysics::Physics
+{
+	//0 is reserved for invalid projectiles
+	static u32 nextProjectileID = 1;
+
+	static vector<DelayedRayHit> hits{};
+
+	//reused by every sweep
+	static vector<RayQuery> sweepQueries{};
+	static vector<RayHit> sweepHits{};
+
+	//Integrates projectiles [begin, end), four at a time where sse2 is available.
+	//Both paths perform the same float operations in the same order
+	static void Integrate(
+		u32 begin,
+		u32 end,
+		f32 deltaTime,
+		const vec3& gravity);
+	static void IntegrateOne(
+		u32 i,
+		f32 deltaTime,
+		const vec3& gravity);
+
+	u32 ProjectileStore::AddProjectile(const ProjectileDesc& desc)
+	{
+		positionsX.push_back(desc.position.x);
+		positionsY.push_back(desc.position.y);
+		positionsZ.push_back(desc.position.z);
+		velocitiesX.push_back(desc.velocity.x);
+		velocitiesY.push_back(desc.velocity.y);
+		velocitiesZ.push_back(desc.velocity.z);
+		forcesX.push_back(desc.force.x);
+		forcesY.push_back(desc.force.y);
+		forcesZ.push_back(desc.force.z);
+		gravityScales.push_back(desc.gravityScale);
+		thrusts.push_back(desc.thrust);
+		drags.push_back(desc.drag);
+		ages.push_back(0.0f);
+		lifetimes.push_back(desc.lifetime);
+
+		previousX.push_back(desc.position.x);
+		previousY.push_back(desc.position.y);
+		previousZ.push_back(desc.position.z);
+		masks.push_back(desc.mask);
+		targetModes.push_back(desc.targetMode);
+		rayIDs.push_back(desc.rayID);
+
+		u32 projectileID = nextProjectileID++;
+		if (nextProjectileID == 0) nextProjectileID = 1;
+
+		projectileIDs.push_back(projectileID);
+
+		return projectileID;
+	}
+
+	void ProjectileStore::RemoveProjectile(u32 index)
+	{
+		if (index >= projectileIDs.size()) return;
+
+		u32 last = scast<u32>(projectileIDs.size() - 1);
+
+		if (index != last)
+		{
+			positionsX[index] = positionsX[last];
+			positionsY[index] = positionsY[last];
+			positionsZ[index] = positionsZ[last];
+			velocitiesX[index] = velocitiesX[last];
+			velocitiesY[index] = velocitiesY[last];
+			velocitiesZ[index] = velocitiesZ[last];
+			forcesX[index] = forcesX[last];
+			forcesY[index] = forcesY[last];
+			forcesZ[index] = forcesZ[last];
+			gravityScales[index] = gravityScales[last];
+			thrusts[index] = thrusts[last];
+			drags[index] = drags[last];
+			ages[index] = ages[last];
+			lifetimes[index] = lifetimes[last];
+
+			previousX[index] = previousX[last];
+			previousY[index] = previousY[last];
+			previousZ[index] = previousZ[last];
+			masks[index] = masks[last];
+			targetModes[index] = targetModes[last];
+			rayIDs[index] = rayIDs[last];
+			projectileIDs[index] = projectileIDs[last];
+		}
+
+		positionsX.pop_back();
+		positionsY.pop_back();
+		positionsZ.pop_back();
+		velocitiesX.pop_back();
+		velocitiesY.pop_back();
+		velocitiesZ.pop_back();
+		forcesX.pop_back();
+		forcesY.pop_back();
+		forcesZ.pop_back();
+		gravityScales.pop_back();
+		thrusts.pop_back();
+		drags.pop_back();
+		ages.pop_back();
+		lifetimes.pop_back();
+
+		previousX.pop_back();
+		previousY.pop_back();
+		previousZ.pop_back();
+		masks.pop_back();
+		targetModes.pop_back();
+		rayIDs.pop_back();
+		projectileIDs.pop_back();
+	}
+
+	u32 ProjectileStore::GetProjectileCount() { return scast<u32>(projectileIDs.size()); }
+
+	const vector<DelayedRayHit>& ProjectileStore::GetHits() { return hits; }
+
+	void ProjectileStore::Clear()
+	{
+		positionsX.clear();
+		positionsY.clear();
+		positionsZ.clear();
+		velocitiesX.clear();
+		velocitiesY.clear();
+		velocitiesZ.clear();
+		forcesX.clear();
+		forcesY.clear();
+		forcesZ.clear();
+		gravityScales.clear();
+		thrusts.clear();
+		drags.clear();
+		ages.clear();
+		lifetimes.clear();
+
+		previousX.clear();
+		previousY.clear();
+		previousZ.clear();
+		masks.clear();
+		targetModes.clear();
+		rayIDs.clear();
+		projectileIDs.clear();
+
+		hits.clear();
+	}
+
+	void ProjectileStore::ClearHits() { hits.clear(); }
+
+	void ProjectileStore::Update(
+		f32 deltaTime,
+		const vec3& gravity)
+	{
+		u32 count = GetProjectileCount();
+		if (count == 0) return;
+
+		Integrate(0, count, deltaTime, gravity);
+
+		//
+		// SWEEP
+		//
+
+		sweepQueries.resize(count);
+		sweepHits.resize(count);
+
+		for (u32 i = 0; i < count; i++)
+		{
+			vec3 from(previousX[i], previousY[i], previousZ[i]);
+			vec3 to(positionsX[i], positionsY[i], positionsZ[i]);
+			vec3 travel = to - from;
+
+			//a projectile that did not move has a zero direction and is skipped by the cast
+			RayQuery& q = sweepQueries[i];
+			q.origin = from;
+			q.direction = travel;
+			q.maxDistance = sqrt(travel.x * travel.x + travel.y * travel.y + travel.z * travel.z);
+		}
+
+		//projectiles of one delayed ray are stored next to each other and share a mask and target mode,
+		//each run of equal ones is one batch so neighbouring shots still form packets
+		Ray ray{};
+		for (u32 begin = 0; begin < count;)
+		{
+			u32 end = begin + 1;
+			while (end < count
+				&& masks[end] == masks[begin]
+				&& targetModes[end] == targetModes[begin])
+			{
+				end++;
+			}
+
+			ray.SetMask(masks[begin]);
+			ray.CastSweptBatch(
+				span<const RayQuery>(sweepQueries).subspan(begin, end - begin),
+				span<RayHit>(sweepHits).subspan(begin, end - begin),
+				targetModes[begin]);
+
+			begin = end;
+		}
+
+		//
+		// HITS AND EXPIRY
+		//
+
+		//walking backwards only ever swaps in projectiles that were already checked
+		for (u32 i = count; i-- > 0;)
+		{
+			const RayHit& rayHit = sweepHits[i];
+
+			if (rayHit.collider)
+			{
+				DelayedRayHit hit{};
+				hit.rayID = rayIDs[i];
+				hit.projectileID = projectileIDs[i];
+				hit.collider = rayHit.collider;
+				hit.point = rayHit.point;
+				hit.normal = rayHit.normal;
+				hit.velocity = vec3(velocitiesX[i], velocitiesY[i], velocitiesZ[i]);
+
+				//the sweep covers the whole step, so the distance along it is the time of impact
+				f32 length = sweepQueries[i].maxDistance;
+				hit.time = length > 0.0f ? rayHit.distance / length : 1.0f;
+				hit.age = ages[i] - (1.0f - hit.time) * deltaTime;
+
+				hits.push_back(hit);
+
+				RemoveProjectile(i);
+			}
+			else if (ages[i] >= lifetimes[i]) RemoveProjectile(i);
+		}
+	}
+
+	void Integrate(
+		u32 begin,
+		u32 end,
+		f32 deltaTime,
+		const vec3& gravity)
+	{
+		using S = ProjectileStore;
+
+		u32 i = begin;
+
+#ifdef KP_SSE2_BASELINE
+		__m128 dt = _mm_set1_ps(deltaTime);
+		__m128 gx = _mm_set1_ps(gravity.x);
+		__m128 gy = _mm_set1_ps(gravity.y);
+		__m128 gz = _mm_set1_ps(gravity.z);
+		__m128 zero = _mm_setzero_ps();
+		__m128 one = _mm_set1_ps(1.0f);
+		//drag can at most stop a projectile within one step, never reverse it
+		__m128 maxBrake = _mm_set1_ps(-1.0f / deltaTime);
+
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 vx = _mm_loadu_ps(&S::velocitiesX[i]);
+			__m128 vy = _mm_loadu_ps(&S::velocitiesY[i]);
+			__m128 vz = _mm_loadu_ps(&S::velocitiesZ[i]);
+
+			__m128 speed2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+			__m128 speed = _mm_sqrt_ps(speed2);
+			__m128 invSpeed = _mm_and_ps(_mm_cmpgt_ps(speed, zero), _mm_div_ps(one, speed));
+
+			//thrust along the flight direction and drag against it scale the velocity itself
+			__m128 k = _mm_sub_ps(
+				_mm_mul_ps(_mm_loadu_ps(&S::thrusts[i]), invSpeed),
+				_mm_mul_ps(_mm_loadu_ps(&S::drags[i]), speed));
+			k = _mm_max_ps(k, maxBrake);
+
+			__m128 gs = _mm_loadu_ps(&S::gravityScales[i]);
+			__m128 ax = _mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, gs), _mm_loadu_ps(&S::forcesX[i])), _mm_mul_ps(vx, k));
+			__m128 ay = _mm_add_ps(_mm_add_ps(_mm_mul_ps(gy, gs), _mm_loadu_ps(&S::forcesY[i])), _mm_mul_ps(vy, k));
+			__m128 az = _mm_add_ps(_mm_add_ps(_mm_mul_ps(gz, gs), _mm_loadu_ps(&S::forcesZ[i])), _mm_mul_ps(vz, k));
+
+			vx = _mm_add_ps(vx, _mm_mul_ps(ax, dt));
+			vy = _mm_add_ps(vy, _mm_mul_ps(ay, dt));
+			vz = _mm_add_ps(vz, _mm_mul_ps(az, dt));
+
+			__m128 px = _mm_loadu_ps(&S::positionsX[i]);
+			__m128 py = _mm_loadu_ps(&S::positionsY[i]);
+			__m128 pz = _mm_loadu_ps(&S::positionsZ[i]);
+
+			_mm_storeu_ps(&S::previousX[i], px);
+			_mm_storeu_ps(&S::previousY[i], py);
+			_mm_storeu_ps(&S::previousZ[i], pz);
+
+			_mm_storeu_ps(&S::positionsX[i], _mm_add_ps(px, _mm_mul_ps(vx, dt)));
+			_mm_storeu_ps(&S::positionsY[i], _mm_add_ps(py, _mm_mul_ps(vy, dt)));
+			_mm_storeu_ps(&S::positionsZ[i], _mm_add_ps(pz, _mm_mul_ps(vz, dt)));
+
+			_mm_storeu_ps(&S::velocitiesX[i], vx);
+			_mm_storeu_ps(&S::velocitiesY[i], vy);
+			_mm_storeu_ps(&S::velocitiesZ[i], vz);
+
+			_mm_storeu_ps(&S::ages[i], _mm_add_ps(_mm_loadu_ps(&S::ages[i]), dt));
+		}
+#endif
+
+		for (; i < end; i++) IntegrateOne(i, deltaTime, gravity);
+	}
+
+	void IntegrateOne(
+		u32 i,
+		f32 deltaTime,
+		const vec3& gravity)
+	{
+		using S = ProjectileStore;
+
+		f32 vx = S::velocitiesX[i];
+		f32 vy = S::velocitiesY[i];
+		f32 vz = S::velocitiesZ[i];
+
+		f32 speed2 = (vx * vx + vy * vy) + vz * vz;
+		f32 speed = sqrt(speed2);
+		f32 invSpeed = speed > 0.0f ? 1.0f / speed : 0.0f;
+
+		f32 k = S::thrusts[i] * invSpeed - S::drags[i] * speed;
+		f32 maxBrake = -1.0f / deltaTime;
+		if (!(k > maxBrake)) k = maxBrake;
+
+		f32 gs = S::gravityScales[i];
+		f32 ax = (gravity.x * gs + S::forcesX[i]) + vx * k;
+		f32 ay = (gravity.y * gs + S::forcesY[i]) + vy * k;
+		f32 az = (gravity.z * gs + S::forcesZ[i]) + vz * k;
+
+		vx = vx + ax * deltaTime;
+		vy = vy + ay * deltaTime;
+		vz = vz + az * deltaTime;
+
+		S::previousX[i] = S::positionsX[i];
+		S::previousY[i] = S::positionsY[i];
+		S::previousZ[i] = S::positionsZ[i];
+
+		S::positionsX[i] = S::positionsX[i] + vx * deltaTime;
+		S::positionsY[i] = S::positionsY[i] + vy * deltaTime;
+		S::positionsZ[i] = S::positionsZ[i] + vz * deltaTime;
+
+		S::velocitiesX[i] = vx;
+		S::velocitiesY[i] = vy;
+		S::velocitiesZ[i] = vz;
+
+		S::ages[i] = S::ages[i] + deltaTime;
+	}
+}
\ No newline at end of file
@@ -3,13 +3,158 @@
 //This is free software, and you are welcome to redistribute it under certain conditions.
 //Read LICENSE.md for more information.
 
+#include <vector>
+#include <algorithm>
+#include <bit>
+
 #include "physics/kp_ray.hpp"
+#include "physics/kp_body_store.hpp"
+#include "physics/kp_rigidbody.hpp"
+#include "core/kp_job_system.hpp"
+#include "core/kp_profiler.hpp"
 #include "physics/collision/kp_collider.hpp"
+#include "physics/collision/kp_bvh.hpp"
+#include "physics/collision/kp_gjk.hpp"
+#include "physics/collision/kp_raycast.hpp"
 
 using KalaPhysics::Core::PhysicsWorld;
+using KalaPhysics::Core::JobSystem;
+using KalaPhysics::Core::REGISTRY_EVENT_REMOVED;
+using KalaPhysics::Physics::Collision::ColliderBVH;
+using KalaPhysics::Physics::Collision::RaycastCollider;
+using KalaPhysics::Physics::Collision::ConvexSupport;
+using KalaPhysics::Physics::Collision::ConvexCastResult;
+using KalaPhysics::Physics::Collision::SupportKind;
+using KalaPhysics::Physics::Collision::ConvexCast;
+using KalaPhysics::Physics::Collision::GetColliderSupport;
+using KalaPhysics::Physics::Collision::RAYCAST_TOLERANCE;
+using KalaPhysics::Physics::Collision::RayPacket;
+using KalaPhysics::Physics::Collision::RAY_PACKET_SIZE;
+using KalaPhysics::Physics::Collision::vlength;
+using KalaPhysics::Physics::Collision::vdot;
+
+using std::vector;
+using std::min;
+using std::sort;
+using std::lower_bound;
+using std::erase_if;
+using std::popcount;
+using std::countr_zero;
 
 namespace KalaPhysics::Physics
 {
+	constexpr u32 NULL_SCENE_ITEM = 0xFFFFFFFFu;
+
+	//One ray hierarchy with the leaf item of every collider registry slot it holds,
+	//so removed colliders are masked out of their leaf instead of rebuilding the hierarchy
+	struct SceneTree
+	{
+		ColliderBVH bvh{};
+
+		//leaf item by collider registry slot, NULL_SCENE_ITEM for slots outside this hierarchy
+		vector<u32> slotItems{};
+		//registry slot of every leaf item, resets slotItems on the next build
+		vector<u32> itemSlots{};
+	};
+
+	//static colliders, only rebuilt when a live collider enters or leaves the static set
+	static SceneTree staticScene{};
+	//colliders of rigidbodies, refitted every step and rebuilt when the dynamic set changes
+	static SceneTree dynamicScene{};
+	//false until the scenes are built and again after ClearScene
+	static bool areScenesBuilt{};
+	//collider removals the scenes have accounted for
+	static u64 sceneRemoveCount{};
+
+	struct MovingTarget
+	{
+		Collider* collider{};
+		//resolves to the collider only while it is alive
+		u32 colliderID{};
+		//translation over the last step
+		vec3 motion{};
+	};
+
+	//colliders that moved during the last step, sorted by address
+	static vector<MovingTarget> movingTargets{};
+	//every moving collider over the whole path it took during the last step
+	static SceneTree movingScene{};
+	//build input of the moving scene, reused every step
+	static vector<Collider*> movingColliders{};
+	static vector<vec3> movingMotions{};
+
+	//Builds the hierarchy of tree over colliders and maps their registry slots to its leaf items
+	static void BuildSceneTree(
+		SceneTree& tree,
+		span<Collider* const> colliders,
+		span<const vec3> motions);
+	//Masks the leaf item of a removed registry slot, if tree holds it
+	static void MaskSceneSlot(
+		SceneTree& tree,
+		u32 slot);
+	static void ClearSceneTree(SceneTree& tree);
+
+	//Raycasts the static scene and then the dynamic scene from the max distance the static one left,
+	//'f32 callback(Collider* c, f32 maxDistance)' works like in ColliderBVH::Raycast
+	template<typename F>
+	static void RaycastScenes(
+		const vec3& origin,
+		const vec3& invDirection,
+		f32 maxDistance,
+		u32 mask,
+		F&& callback);
+
+	//Normalizes the direction and resolves the default distance, false for a zero direction
+	static bool PrepareRay(
+		const vec3& direction,
+		f32 maxDistance,
+		vec3& outDirection,
+		vec3& outInvDirection,
+		f32& outMaxDistance);
+
+	//Closest hit of one prepared ray
+	static void CastSingle(
+		const vec3& origin,
+		const vec3& direction,
+		const vec3& invDirection,
+		f32 maxDistance,
+		u32 mask,
+		RayHit& outHit);
+
+	//Closest hit of one prepared ray that travelled its full length during the last step,
+	//moving colliders are skipped in the scenes and tested along their path by mode instead
+	static void CastSweptSingle(
+		const vec3& origin,
+		const vec3& direction,
+		const vec3& invDirection,
+		f32 maxDistance,
+		u32 mask,
+		RayTargetMode mode,
+		RayHit& outHit);
+
+	//Hit of one ray that travelled length along direction during the last step
+	//against a collider that moved by motion during it, outDistance is measured along the ray
+	static bool SweepTarget(
+		const Collider* c,
+		const vec3& motion,
+		const vec3& origin,
+		const vec3& direction,
+		f32 length,
+		RayTargetMode mode,
+		f32& outDistance,
+		vec3& outNormal);
+
+	//Returns the moving target entry of c or nullptr if c did not move during the last step
+	static const MovingTarget* FindMovingTarget(const Collider* c);
+
+	//Casts queries [begin, end) as one packet, at most RAY_PACKET_SIZE of them
+	static void CastPacket(
+		const RayQuery* queries,
+		RayHit* outHits,
+		u32 begin,
+		u32 end,
+		u32 mask);
+
 	u32 Ray::MakeMaskFromLayers(initializer_list<u8> layers)
 	{
 		u32 m = 0ULL;
@@ -24,17 +169,197 @@ namespace KalaPhysics::Physics
 	bool Ray::HitAny(
 		const vec3& origin,
 		const vec3& direction,
-		f32 maxDistance)
+		f32 maxDistance) const
 	{
-		return false;
+		KP_PROFILE_COUNT(COUNTER_RAY_QUERIES, 1);
+
+		MaskRemovedColliders();
+
+		vec3 dir{};
+		vec3 invDir{};
+		if (!PrepareRay(direction, maxDistance, dir, invDir, maxDistance)) return false;
+
+		bool hasHit = false;
+		RaycastScenes(
+			origin,
+			invDir,
+			maxDistance,
+			mask,
+			[&](Collider* c, f32 currentMax)
+			{
+				f32 distance{};
+				vec3 normal{};
+				if (!RaycastCollider(c, origin, dir, invDir, currentMax, distance, normal)) return currentMax;
+
+				//any hit answers the query, stop the traversal
+				hasHit = true;
+				return 0.0f;
+			});
+
+		return hasHit;
 	}
 
 	Collider* Ray::HitCollider(
 		const vec3& origin,
 		const vec3& direction,
-		f32 maxDistance)
+		f32 maxDistance) const
+	{
+		RayHit hit{};
+		Cast(origin, direction, hit, maxDistance);
+
+		return hit.collider;
+	}
+
+	bool Ray::Cast(
+		const vec3& origin,
+		const vec3& direction,
+		RayHit& outHit,
+		f32 maxDistance) const
+	{
+		KP_PROFILE_COUNT(COUNTER_RAY_QUERIES, 1);
+
+		outHit = {};
+
+		MaskRemovedColliders();
+
+		vec3 dir{};
+		vec3 invDir{};
+		if (!PrepareRay(direction, maxDistance, dir, invDir, maxDistance)) return false;
+
+		CastSingle(origin, dir, invDir, maxDistance, mask, outHit);
+
+		return outHit.collider != nullptr;
+	}
+
+	void Ray::CastBatch(
+		span<const RayQuery> queries,
+		span<RayHit> outHits) const
 	{
-		return nullptr;
+		if (outHits.size() < queries.size())
+		{
+			Log::Print(
+				"Cannot cast ray batch because the hit buffer is smaller than the query buffer!",
+				"RAY",
+				LogType::LOG_ERROR,
+				2);
+
+			return;
+		}
+
+		u32 count = scast<u32>(queries.size());
+		if (count == 0) return;
+
+		KP_PROFILE_SCOPE(ZONE_RAY_QUERY);
+		KP_PROFILE_COUNT(COUNTER_RAY_QUERIES, count);
+
+		MaskRemovedColliders();
+
+		//a single captured pointer fits the small buffer of the job function,
+		//so splitting the batch does not allocate either
+		struct BatchContext
+		{
+			const RayQuery* queries;
+			RayHit* hits;
+			u32 mask;
+		};
+		BatchContext context{ queries.data(), outHits.data(), mask };
+		const BatchContext* ctx = &context;
+
+		JobSystem::ParallelFor(
+			count,
+			RAY_BATCH_CHUNK_SIZE,
+			[ctx](u32 begin, u32 end, u32)
+			{
+				for (u32 i = begin; i < end; i += RAY_PACKET_SIZE)
+				{
+					CastPacket(ctx->queries, ctx->hits, i, min(i + RAY_PACKET_SIZE, end), ctx->mask);
+				}
+			});
+	}
+
+	bool Ray::CastSwept(
+		const vec3& origin,
+		const vec3& direction,
+		RayHit& outHit,
+		RayTargetMode mode,
+		f32 maxDistance) const
+	{
+		KP_PROFILE_COUNT(COUNTER_RAY_QUERIES, 1);
+
+		outHit = {};
+
+		MaskRemovedColliders();
+
+		vec3 dir{};
+		vec3 invDir{};
+		if (!PrepareRay(direction, maxDistance, dir, invDir, maxDistance)) return false;
+
+		CastSweptSingle(origin, dir, invDir, maxDistance, mask, mode, outHit);
+
+		return outHit.collider != nullptr;
+	}
+
+	void Ray::CastSweptBatch(
+		span<const RayQuery> queries,
+		span<RayHit> outHits,
+		RayTargetMode mode) const
+	{
+		MaskRemovedColliders();
+
+		//without moving colliders every mode sees the same end of step poses
+		if (mode == RayTargetMode::TARGET_STATIC
+			|| movingTargets.empty())
+		{
+			CastBatch(queries, outHits);
+			return;
+		}
+
+		if (outHits.size() < queries.size())
+		{
+			Log::Print(
+				"Cannot cast swept ray batch because the hit buffer is smaller than the query buffer!",
+				"RAY",
+				LogType::LOG_ERROR,
+				2);
+
+			return;
+		}
+
+		u32 count = scast<u32>(queries.size());
+		if (count == 0) return;
+
+		KP_PROFILE_SCOPE(ZONE_RAY_QUERY);
+		KP_PROFILE_COUNT(COUNTER_RAY_QUERIES, count);
+
+		struct BatchContext
+		{
+			const RayQuery* queries;
+			RayHit* hits;
+			u32 mask;
+			RayTargetMode mode;
+		};
+		BatchContext context{ queries.data(), outHits.data(), mask, mode };
+		const BatchContext* ctx = &context;
+
+		JobSystem::ParallelFor(
+			count,
+			RAY_BATCH_CHUNK_SIZE,
+			[ctx](u32 begin, u32 end, u32)
+			{
+				for (u32 i = begin; i < end; i++)
+				{
+					const RayQuery& q = ctx->queries[i];
+					RayHit& hit = ctx->hits[i];
+					hit = {};
+
+					vec3 dir{};
+					vec3 invDir{};
+					f32 maxDistance{};
+					if (!PrepareRay(q.direction, q.maxDistance, dir, invDir, maxDistance)) continue;
+
+					CastSweptSingle(q.origin, dir, invDir, maxDistance, ctx->mask, ctx->mode, hit);
+				}
+			});
 	}
 
 	void Ray::SetMask(u32 m) { mask = m; }
@@ -76,4 +401,499 @@ namespace KalaPhysics::Physics
 	}
 
 	u32 Ray::GetMask() const { return mask; }
+
+	void Ray::UpdateScene(
+		span<Collider* const> staticColliders,
+		span<Collider* const> dynamicColliders,
+		StaticTreeUpdate staticUpdate,
+		bool isDynamicSetChanged)
+	{
+		//removals the world has drained already were masked before it drained them
+		sceneRemoveCount = Collider::GetRegistry().removeCount;
+
+		if (!areScenesBuilt)
+		{
+			staticUpdate = StaticTreeUpdate::STATIC_REBUILD;
+			isDynamicSetChanged = true;
+			areScenesBuilt = true;
+		}
+
+		switch (staticUpdate)
+		{
+		case StaticTreeUpdate::STATIC_KEEP:
+			break;
+		case StaticTreeUpdate::STATIC_REFIT:
+			staticScene.bvh.Refit();
+			break;
+		case StaticTreeUpdate::STATIC_REBUILD:
+			BuildSceneTree(staticScene, staticColliders, {});
+			break;
+		}
+
+		if (isDynamicSetChanged) BuildSceneTree(dynamicScene, dynamicColliders, {});
+		else dynamicScene.bvh.Refit();
+
+		//
+		// MOVING COLLIDERS
+		//
+
+		movingTargets.clear();
+
+		//bodies added since the step started have no previous state yet
+		u32 bodyCount = min(
+			BodyStore::GetBodyCount(),
+			scast<u32>(BodyStore::previousPositions.size()));
+
+		for (u32 i = 0; i < bodyCount; i++)
+		{
+			if (BodyStore::flags[i] & BODY_FLAG_SLEEPING) continue;
+
+			vec3 motion = BodyStore::positions[i] - BodyStore::previousPositions[i];
+			if (vdot(motion, motion) == 0.0f) continue;
+
+			//colliders follow the pose of their body, static ones stay behind
+			RigidBody* owner = BodyStore::owners[i];
+			const auto& colliderIDs = owner->GetAllColliders();
+
+			for (u8 c = 0; c < owner->GetColliderCount(); c++)
+			{
+				Collider* col = Collider::GetRegistry().GetContent(colliderIDs[c]);
+				if (col
+					&& !col->IsStatic())
+				{
+					movingTargets.push_back({ col, colliderIDs[c], motion });
+				}
+			}
+		}
+
+		sort(movingTargets.begin(), movingTargets.end(),
+			[](const MovingTarget& a, const MovingTarget& b)
+			{
+				return a.collider < b.collider;
+			});
+
+		movingColliders.clear();
+		movingMotions.clear();
+		for (const auto& t : movingTargets)
+		{
+			movingColliders.push_back(t.collider);
+			movingMotions.push_back(t.motion);
+		}
+
+		BuildSceneTree(movingScene, movingColliders, movingMotions);
+	}
+	void Ray::ClearScene()
+	{
+		ClearSceneTree(staticScene);
+		ClearSceneTree(dynamicScene);
+		ClearSceneTree(movingScene);
+		areScenesBuilt = false;
+
+		movingTargets.clear();
+		movingColliders.clear();
+		movingMotions.clear();
+	}
+
+	void Ray::MaskRemovedColliders()
+	{
+		auto& registry = Collider::GetRegistry();
+		if (registry.removeCount == sceneRemoveCount) return;
+
+		sceneRemoveCount = registry.removeCount;
+
+		//every removal since the world last drained is still in the registry events,
+		//masking a slot twice does nothing
+		registry.PeekEvents(
+			[](u32 slot, u8 events)
+			{
+				if (!(events & REGISTRY_EVENT_REMOVED)) return;
+
+				MaskSceneSlot(staticScene, slot);
+				MaskSceneSlot(dynamicScene, slot);
+				MaskSceneSlot(movingScene, slot);
+			});
+
+		//a new collider may live at the address of a removed one, so targets are matched by ID
+		erase_if(movingTargets,
+			[](const MovingTarget& t)
+			{
+				return Collider::GetRegistry().GetContent(t.colliderID) != t.collider;
+			});
+	}
+
+	void BuildSceneTree(
+		SceneTree& tree,
+		span<Collider* const> colliders,
+		span<const vec3> motions)
+	{
+		for (u32 slot : tree.itemSlots) tree.slotItems[slot] = NULL_SCENE_ITEM;
+		tree.itemSlots.clear();
+
+		tree.bvh.Build(colliders, motions);
+
+		span<Collider* const> items = tree.bvh.GetItems();
+		for (u32 i = 0; i < items.size(); i++)
+		{
+			u32 slot = Collider::GetRegistry().GetSlot(items[i]->GetID());
+
+			if (slot >= tree.slotItems.size()) tree.slotItems.resize(scast<size_t>(slot) + 1, NULL_SCENE_ITEM);
+			tree.slotItems[slot] = i;
+			tree.itemSlots.push_back(slot);
+		}
+	}
+
+	void MaskSceneSlot(
+		SceneTree& tree,
+		u32 slot)
+	{
+		if (slot >= tree.slotItems.size()
+			|| tree.slotItems[slot] == NULL_SCENE_ITEM)
+		{
+			return;
+		}
+
+		tree.bvh.MaskItem(tree.slotItems[slot]);
+		tree.slotItems[slot] = NULL_SCENE_ITEM;
+	}
+
+	void ClearSceneTree(SceneTree& tree)
+	{
+		tree.bvh.Clear();
+		tree.slotItems.clear();
+		tree.itemSlots.clear();
+	}
+
+	template<typename F>
+	void RaycastScenes(
+		const vec3& origin,
+		const vec3& invDirection,
+		f32 maxDistance,
+		u32 mask,
+		F&& callback)
+	{
+		maxDistance = staticScene.bvh.Raycast(origin, invDirection, maxDistance, mask, callback);
+		if (maxDistance <= 0.0f) return;
+
+		dynamicScene.bvh.Raycast(origin, invDirection, maxDistance, mask, callback);
+	}
+
+	bool PrepareRay(
+		const vec3& direction,
+		f32 maxDistance,
+		vec3& outDirection,
+		vec3& outInvDirection,
+		f32& outMaxDistance)
+	{
+		f32 length = vlength(direction);
+		if (!(length > 0.0f)) return false;
+
+		outDirection = direction * (1.0f / length);
+
+		//zero components become infinities, which the slab tests rely on
+		outInvDirection = vec3(
+			1.0f / outDirection.x,
+			1.0f / outDirection.y,
+			1.0f / outDirection.z);
+
+		outMaxDistance = maxDistance > 0.0f ? maxDistance : MAX_DISTANCE;
+		return true;
+	}
+
+	void CastSingle(
+		const vec3& origin,
+		const vec3& direction,
+		const vec3& invDirection,
+		f32 maxDistance,
+		u32 mask,
+		RayHit& outHit)
+	{
+		RaycastScenes(
+			origin,
+			invDirection,
+			maxDistance,
+			mask,
+			[&](Collider* c, f32 currentMax)
+			{
+				f32 distance{};
+				vec3 normal{};
+				if (!RaycastCollider(c, origin, direction, invDirection, currentMax, distance, normal)) return currentMax;
+
+				outHit.collider = c;
+				outHit.normal = normal;
+				outHit.distance = distance;
+
+				//an origin inside a collider can not be beaten,
+				//otherwise only nodes closer than this hit are still visited
+				return distance;
+			});
+
+		if (outHit.collider) outHit.point = origin + direction * outHit.distance;
+	}
+
+	void CastPacket(
+		const RayQuery* queries,
+		RayHit* outHits,
+		u32 begin,
+		u32 end,
+		u32 mask)
+	{
+		RayPacket packet{};
+		vec3 directions[RAY_PACKET_SIZE]{};
+
+		u32 laneMask = 0;
+		u32 octant = 0;
+		bool isCoherent = true;
+
+		for (u32 lane = 0; lane < RAY_PACKET_SIZE; lane++)
+		{
+			packet.maxDistance[lane] = -1.0f;
+
+			if (begin + lane >= end) continue;
+
+			const RayQuery& q = queries[begin + lane];
+			outHits[begin + lane] = {};
+
+			vec3 invDir{};
+			f32 maxDistance{};
+			if (!PrepareRay(q.direction, q.maxDistance, directions[lane], invDir, maxDistance)) continue;
+
+			packet.originX[lane] = q.origin.x;
+			packet.originY[lane] = q.origin.y;
+			packet.originZ[lane] = q.origin.z;
+			packet.invDirectionX[lane] = invDir.x;
+			packet.invDirectionY[lane] = invDir.y;
+			packet.invDirectionZ[lane] = invDir.z;
+			packet.maxDistance[lane] = maxDistance;
+
+			//rays of different octants visit the children in different orders
+			//and split apart right below the root
+			u32 laneOctant = (directions[lane].x < 0.0f ? 1u : 0u)
+				| (directions[lane].y < 0.0f ? 2u : 0u)
+				| (directions[lane].z < 0.0f ? 4u : 0u);
+
+			if (laneMask == 0) octant = laneOctant;
+			else if (laneOctant != octant) isCoherent = false;
+
+			laneMask |= 1u << lane;
+		}
+
+		if (laneMask == 0) return;
+
+		if (!isCoherent
+			|| popcount(laneMask) == 1)
+		{
+			for (u32 bits = laneMask; bits != 0; bits &= bits - 1)
+			{
+				u32 lane = scast<u32>(countr_zero(bits));
+
+				CastSingle(
+					queries[begin + lane].origin,
+					directions[lane],
+					vec3(packet.invDirectionX[lane], packet.invDirectionY[lane], packet.invDirectionZ[lane]),
+					packet.maxDistance[lane],
+					mask,
+					outHits[begin + lane]);
+			}
+
+			return;
+		}
+
+		auto _hit_lane = [&](u32 lane, Collider* c, f32 currentMax)
+			{
+				vec3 invDir(packet.invDirectionX[lane], packet.invDirectionY[lane], packet.invDirectionZ[lane]);
+
+				f32 distance{};
+				vec3 normal{};
+				if (!RaycastCollider(
+					c,
+					queries[begin + lane].origin,
+					directions[lane],
+					invDir,
+					currentMax,
+					distance,
+					normal))
+				{
+					return currentMax;
+				}
+
+				RayHit& hit = outHits[begin + lane];
+				hit.collider = c;
+				hit.normal = normal;
+				hit.distance = distance;
+
+				return distance;
+			};
+
+		//finished lanes keep a negative max distance and never reach the dynamic scene
+		staticScene.bvh.RaycastPacket(packet, laneMask, mask, _hit_lane);
+		dynamicScene.bvh.RaycastPacket(packet, laneMask, mask, _hit_lane);
+
+		for (u32 bits = laneMask; bits != 0; bits &= bits - 1)
+		{
+			u32 lane = scast<u32>(countr_zero(bits));
+
+			RayHit& hit = outHits[begin + lane];
+			if (hit.collider) hit.point = queries[begin + lane].origin + directions[lane] * hit.distance;
+		}
+	}
+
+	void CastSweptSingle(
+		const vec3& origin,
+		const vec3& direction,
+		const vec3& invDirection,
+		f32 maxDistance,
+		u32 mask,
+		RayTargetMode mode,
+		RayHit& outHit)
+	{
+		if (mode == RayTargetMode::TARGET_STATIC
+			|| movingTargets.empty())
+		{
+			CastSingle(origin, direction, invDirection, maxDistance, mask, outHit);
+			return;
+		}
+
+		//colliders at rest are where the scenes have them for the whole step
+		RaycastScenes(
+			origin,
+			invDirection,
+			maxDistance,
+			mask,
+			[&](Collider* c, f32 currentMax)
+			{
+				if (FindMovingTarget(c)) return currentMax;
+
+				f32 distance{};
+				vec3 normal{};
+				if (!RaycastCollider(c, origin, direction, invDirection, currentMax, distance, normal)) return currentMax;
+
+				outHit.collider = c;
+				outHit.normal = normal;
+				outHit.distance = distance;
+
+				return distance;
+			});
+
+		//moving colliders only have to be looked at up to the closest hit at rest,
+		//the ray is inside the bounds of their whole path at the time it hits them
+		movingScene.bvh.Raycast(
+			origin,
+			invDirection,
+			outHit.collider ? outHit.distance : maxDistance,
+			mask,
+			[&](Collider* c, f32 currentMax)
+			{
+				const MovingTarget* target = FindMovingTarget(c);
+				if (!target) return currentMax;
+
+				f32 distance{};
+				vec3 normal{};
+				if (!SweepTarget(c, target->motion, origin, direction, maxDistance, mode, distance, normal)
+					|| distance > currentMax)
+				{
+					return currentMax;
+				}
+
+				outHit.collider = c;
+				outHit.normal = normal;
+				outHit.distance = distance;
+
+				return distance;
+			});
+
+		if (outHit.collider) outHit.point = origin + direction * outHit.distance;
+	}
+
+	bool SweepTarget(
+		const Collider* c,
+		const vec3& motion,
+		const vec3& origin,
+		const vec3& direction,
+		f32 length,
+		RayTargetMode mode,
+		f32& outDistance,
+		vec3& outNormal)
+	{
+		if (mode == RayTargetMode::TARGET_MOVING)
+		{
+			//seen from the collider at its end of step pose the ray starts one motion further ahead,
+			//so the ray and collider positions at every time of the step are one straight relative ray
+			vec3 start = origin + motion;
+			vec3 relative = origin + direction * length - start;
+
+			//a ray travelling along with the collider never reaches it
+			f32 relativeLength = vlength(relative);
+			if (!(relativeLength > 0.0f)) return false;
+
+			vec3 relativeDir = relative * (1.0f / relativeLength);
+			vec3 relativeInvDir(
+				1.0f / relativeDir.x,
+				1.0f / relativeDir.y,
+				1.0f / relativeDir.z);
+
+			f32 distance{};
+			if (!RaycastCollider(
+				c,
+				start,
+				relativeDir,
+				relativeInvDir,
+				relativeLength,
+				distance,
+				outNormal))
+			{
+				return false;
+			}
+
+			//both rays cover their length over the same step, so the fraction of the step carries over
+			outDistance = distance / relativeLength * length;
+			return true;
+		}
+
+		//the swept collider is its end of step shape stretched back along its motion,
+		//which is the same as stretching the ray forward along it and keeping the shape in place
+		vec3 segment[2] = { vec3(0.0f), motion };
+
+		ConvexSupport ray{};
+		ray.kind = SupportKind::SUPPORT_POINTS;
+		ray.pos = origin;
+		ray.vertices = segment;
+		ray.vertexCount = 2;
+
+		f32 time{};
+		vec3 normal{};
+		ConvexCastResult result = ConvexCast(
+			ray,
+			GetColliderSupport(c),
+			direction * length,
+			RAYCAST_TOLERANCE,
+			RAYCAST_TOLERANCE,
+			time,
+			normal);
+
+		if (result == ConvexCastResult::CAST_MISS) return false;
+
+		//origins inside the swept shape hit at distance 0 with the normal facing against the ray
+		if (result == ConvexCastResult::CAST_OVERLAPPING)
+		{
+			outDistance = 0.0f;
+			outNormal = vec3(0.0f) - direction;
+			return true;
+		}
+
+		//the cast normal points from the ray towards the collider
+		outDistance = time * length;
+		outNormal = vec3(0.0f) - normal;
+		return true;
+	}
+
+	const MovingTarget* FindMovingTarget(const Collider* c)
+	{
+		auto it = lower_bound(movingTargets.begin(), movingTargets.end(), c,
+			[](const MovingTarget& t, const Collider* key)
+			{
+				return t.collider < key;
+			});
+
+		return it != movingTargets.end() && it->collider == c ? &*it : nullptr;
+	}
 }
\ No newline at end of file
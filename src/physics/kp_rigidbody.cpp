@@ -4,10 +4,17 @@
 //Read LICENSE.md for more information.
 
 #include <string>
+#include <memory>
 
 #include "physics/kp_rigidbody.hpp"
+#include "physics/kp_body_store.hpp"
+#include "core/kp_physics_world.hpp"
+
+using KalaPhysics::Core::PhysicsWorld;
 
 using std::to_string;
+using std::make_unique;
+using std::unique_ptr;
 
 namespace KalaPhysics::Physics
 {
@@ -17,12 +24,43 @@ namespace KalaPhysics::Physics
 
 	RigidBody* RigidBody::Initialize()
 	{
-		return nullptr;
+		unique_ptr<RigidBody> newRB = make_unique<RigidBody>();
+		RigidBody* rbPtr = newRB.get();
+
+		u32 newID = GetRegistry().AddContent(std::move(newRB));
+		if (newID == 0)
+		{
+			Log::Print(
+				"Cannot create a new rigidbody because the rigidbody registry is full!",
+				"RIGIDBODY",
+				LogType::LOG_ERROR,
+				2);
+
+			return nullptr;
+		}
+
+		Log::Print(
+			"Creating new rigidbody with ID '" + to_string(newID) + "'.",
+			"RIGIDBODY",
+			LogType::LOG_DEBUG);
+
+		rbPtr->ID = newID;
+		rbPtr->bodyIndex = BodyStore::AddBody(rbPtr);
+
+		rbPtr->isInitialized = true;
+
+		Log::Print(
+			"Created new rigidbody with ID '" + to_string(newID) + "'!",
+			"RIGIDBODY",
+			LogType::LOG_SUCCESS);
+
+		return rbPtr;
 	}
 
 	bool RigidBody::IsInitialized() const { return isInitialized; }
 
 	u32 RigidBody::GetID() const { return ID; }
+	u32 RigidBody::GetBodyIndex() const { return bodyIndex; }
 
 	void RigidBody::AddCollider(u32 colliderID)
 	{
@@ -54,6 +92,8 @@ namespace KalaPhysics::Physics
 		}
 
 		colliders[colliderCount++] = colliderID;
+		BodyStore::RefreshRotationLock(bodyIndex);
+		BodyStore::RefreshInertia(bodyIndex);
 	}
 	void RigidBody::RemoveCollider(u32 colliderID)
 	{
@@ -62,6 +102,8 @@ namespace KalaPhysics::Physics
 			if (colliders[i] == colliderID)
 			{
 				colliders[i] = colliders[--colliderCount];
+				BodyStore::RefreshRotationLock(bodyIndex);
+				BodyStore::RefreshInertia(bodyIndex);
 				return;
 			}
 		}
@@ -75,85 +117,172 @@ namespace KalaPhysics::Physics
 	void RigidBody::RemoveAllColliders()
 	{
 		colliderCount = 0;
+		BodyStore::RefreshRotationLock(bodyIndex);
+		BodyStore::RefreshInertia(bodyIndex);
 	}
 
 	const array<u32, MAX_COLLIDERS>& RigidBody::GetAllColliders() const { return colliders; }
 	u8 RigidBody::GetColliderCount() const { return colliderCount; }
 
-	bool RigidBody::IsSleeping() const { return vars.isSleeping; }
-	bool RigidBody::IsCCD() const { return vars.ccd; }
+	bool RigidBody::IsSleeping() const { return BodyStore::flags[bodyIndex] & BODY_FLAG_SLEEPING; }
+	void RigidBody::Wake() { BodyStore::WakeBody(bodyIndex); }
+	void RigidBody::Sleep() { BodyStore::SleepBodies(span<const u32>(&bodyIndex, 1)); }
+	void RigidBody::SetCCD(bool newValue)
+	{
+		if (newValue) BodyStore::flags[bodyIndex] |= BODY_FLAG_CCD;
+		else BodyStore::flags[bodyIndex] &= scast<u8>(~BODY_FLAG_CCD);
+	}
+	bool RigidBody::IsCCD() const { return BodyStore::flags[bodyIndex] & BODY_FLAG_CCD; }
+
+	const vec3& RigidBody::GetPosition() const { return BodyStore::positions[bodyIndex]; }
+	void RigidBody::SetPosition(const vec3& newValue)
+	{
+		//teleports don't blend
+		BodyStore::positions[bodyIndex] = newValue;
+		BodyStore::previousPositions[bodyIndex] = newValue;
+		BodyStore::UpdateColliderPoses(bodyIndex);
+		BodyStore::WakeBody(bodyIndex);
+	}
+
+	const quat& RigidBody::GetRotation() const { return BodyStore::rotations[bodyIndex]; }
+	void RigidBody::SetRotation(const quat& newValue)
+	{
+		BodyStore::rotations[bodyIndex] = normalize_q(newValue);
+		BodyStore::previousRotations[bodyIndex] = BodyStore::rotations[bodyIndex];
+		BodyStore::UpdateColliderPoses(bodyIndex);
+		BodyStore::WakeBody(bodyIndex);
+	}
+
+	vec3 RigidBody::GetInterpolatedPosition() const
+	{
+		f32 alpha = PhysicsWorld::GetInterpolationAlpha();
+		const vec3& from = BodyStore::previousPositions[bodyIndex];
+
+		return from + (BodyStore::positions[bodyIndex] - from) * alpha;
+	}
+	quat RigidBody::GetInterpolatedRotation() const
+	{
+		f32 alpha = PhysicsWorld::GetInterpolationAlpha();
+		const quat& from = BodyStore::previousRotations[bodyIndex];
+		const quat& to = BodyStore::rotations[bodyIndex];
+
+		//blend along the shorter arc, steps are small enough for normalized lerp
+		f32 sign = from.x * to.x + from.y * to.y + from.z * to.z + from.w * to.w < 0.0f ? -1.0f : 1.0f;
+
+		quat q{};
+		q.x = from.x + (to.x * sign - from.x) * alpha;
+		q.y = from.y + (to.y * sign - from.y) * alpha;
+		q.z = from.z + (to.z * sign - from.z) * alpha;
+		q.w = from.w + (to.w * sign - from.w) * alpha;
+
+		return normalize_q(q);
+	}
 
-	f32 RigidBody::GetMass() const { return vars.mass; }
+	f32 RigidBody::GetMass() const { return BodyStore::vars[bodyIndex].mass; }
 	void RigidBody::SetMass(f32 newValue)
 	{
-		vars.mass = clamp(
+		f32 mass = clamp(
 			newValue,
 			0.0f,
 			MAX_MASS);
+
+		BodyStore::vars[bodyIndex].mass = mass;
+		//zero mass is treated as infinite mass, the body is never moved by the simulation
+		BodyStore::inverseMasses[bodyIndex] = mass > 0.0f ? 1.0f / mass : 0.0f;
+		BodyStore::RefreshInertia(bodyIndex);
 	}
 
-	f32 RigidBody::GetRestitution() const { return vars.restitution; }
+	f32 RigidBody::GetRestitution() const { return BodyStore::vars[bodyIndex].restitution; }
 	void RigidBody::SetRestitution(f32 newValue)
 	{
-		vars.restitution = clamp(
+		BodyStore::vars[bodyIndex].restitution = clamp(
 			newValue,
 			0.0f,
 			1.0f);
 	}
 
-	f32 RigidBody::GetLinearDamp() const { return vars.linearDamp; }
+	f32 RigidBody::GetFriction() const { return BodyStore::vars[bodyIndex].friction; }
+	void RigidBody::SetFriction(f32 newValue)
+	{
+		BodyStore::vars[bodyIndex].friction = clamp(
+			newValue,
+			0.0f,
+			MAX_FRICTION);
+	}
+
+	f32 RigidBody::GetLinearDamp() const { return BodyStore::vars[bodyIndex].linearDamp; }
 	void RigidBody::SetLinearDamp(f32 newValue)
 	{
-		vars.linearDamp = clamp(
+		BodyStore::vars[bodyIndex].linearDamp = clamp(
 			newValue,
 			0.0f,
 			1.0f);
 	}
 
-	f32 RigidBody::GetAngularDamp() const { return vars.angularDamp; }
+	f32 RigidBody::GetAngularDamp() const { return BodyStore::vars[bodyIndex].angularDamp; }
 	void RigidBody::SetAngularDamp(f32 newValue)
 	{
-		vars.angularDamp = clamp(
+		BodyStore::vars[bodyIndex].angularDamp = clamp(
 			newValue,
 			0.0f,
 			1.0f);
 	}
 
-	const vec3& RigidBody::GetGravityScale() const { return vars.gravityScale; }
+	const vec3& RigidBody::GetGravityScale() const { return BodyStore::vars[bodyIndex].gravityScale; }
 	void RigidBody::SetGravityScale(const vec3& newValue)
 	{
-		vars.gravityScale = kclamp(
+		BodyStore::vars[bodyIndex].gravityScale = kclamp(
 			newValue,
 			vec3(0.0f),
 			MAX_GRAVITY_SCALE);
 	}
 
-	const vec3& RigidBody::GetVelocity() const { return vars.velocity; }
+	const vec3& RigidBody::GetVelocity() const { return BodyStore::velocities[bodyIndex]; }
 	void RigidBody::SetVelocity(const vec3& newValue)
 	{
-		vars.velocity = kclamp(
+		BodyStore::velocities[bodyIndex] = kclamp(
 			newValue,
-			vec3(0.0f),
+			vec3(0.0f) - MAX_VELOCITY,
 			MAX_VELOCITY);
+
+		//an external push restarts the rest window and wakes the group it slept with
+		BodyStore::WakeBody(bodyIndex);
 	}
 
-	const vec3& RigidBody::GetAngularVelocity() const { return vars.angularVelocity; }
+	const vec3& RigidBody::GetAngularVelocity() const { return BodyStore::angularVelocities[bodyIndex]; }
 	void RigidBody::SetAngularVelocity(const vec3& newValue)
 	{
-		vars.angularVelocity = kclamp(
+		if (BodyStore::flags[bodyIndex] & BODY_FLAG_FIXED_ROTATION) return;
+
+		BodyStore::angularVelocities[bodyIndex] = kclamp(
 			newValue,
-			vec3(0.0f),
+			vec3(0.0f) - MAX_ANGULAR_VELOCITY,
 			MAX_ANGULAR_VELOCITY);
+
+		BodyStore::WakeBody(bodyIndex);
 	}
 
-	const mat3& RigidBody::GetInertiaTensor() const { return vars.inertiaTensor; }
+	const vec3& RigidBody::GetPrincipalInertia() const { return BodyStore::vars[bodyIndex].principalInertia; }
+	void RigidBody::SetPrincipalInertia(const vec3& newValue)
+	{
+		vec3 inertia = kclamp(
+			newValue,
+			vec3(0.0f),
+			MAX_PRINCIPAL_INERTIA);
+
+		RigidBodyVars& v = BodyStore::vars[bodyIndex];
+		v.principalInertia = inertia;
+		v.isInertiaCustom = true;
 
-	f32 RigidBody::GetAccumulatedForce() const { return vars.accumForce; }
+		BodyStore::RefreshInertia(bodyIndex);
+	}
+
+	f32 RigidBody::GetAccumulatedForce() const { return BodyStore::vars[bodyIndex].accumForce; }
 
-	f32 RigidBody::GetAccumulatedTorque() const { return vars.accumTorque; }
+	f32 RigidBody::GetAccumulatedTorque() const { return BodyStore::vars[bodyIndex].accumTorque; }
 	
 	RigidBody::~RigidBody()
 	{
-
+		if (isInitialized) BodyStore::RemoveBody(bodyIndex);
 	}
 }
\ No newline at end of file